@@ -0,0 +1,690 @@
+// Generated by gen_kernel, do not edit.
+
+#include <cmath>
+#include <cstddef>
+
+static const size_t kernel_n = 36;
+
+static const size_t kernel_col_ptr[] = {
+	0, 2, 5, 8, 12, 16, 20, 25, 30, 35, 40, 46, 52, 58, 64, 70,
+	76, 82, 88, 94, 100, 105, 110, 115, 120, 125, 129, 133, 137, 141, 144, 147,
+	150, 152, 154, 155, 155,
+};
+
+static const unsigned kernel_row_ind[] = {
+	1, 2, 2, 3, 4, 3, 4, 5, 4, 5, 6, 7, 5, 6, 7, 8,
+	6, 7, 8, 9, 7, 8, 9, 10, 11, 8, 9, 10, 11, 12, 9, 10,
+	11, 12, 13, 10, 11, 12, 13, 14, 11, 12, 13, 14, 16, 17, 12, 13,
+	14, 16, 17, 18, 13, 14, 16, 17, 18, 19, 14, 16, 17, 18, 19, 20,
+	15, 16, 17, 18, 19, 20, 16, 17, 18, 19, 20, 21, 17, 18, 19, 20,
+	21, 22, 18, 19, 20, 21, 22, 23, 19, 20, 21, 22, 23, 24, 20, 21,
+	22, 23, 24, 25, 21, 22, 23, 24, 25, 22, 23, 24, 25, 26, 23, 24,
+	25, 26, 27, 24, 25, 26, 27, 28, 25, 26, 27, 28, 29, 26, 27, 28,
+	29, 27, 28, 29, 30, 28, 29, 30, 31, 29, 30, 31, 32, 30, 31, 32,
+	31, 32, 33, 32, 33, 34, 33, 34, 34, 35, 35,
+};
+
+static const double kernel_values[] = {
+	3, 4, 4, 4, 5, 4, 4, 5, 5, 4, 4, 5, 5, 5, 4, 3,
+	3, 5, 5, 5, 5, 4, 4, 5, 5, 5, 4, 4, 5, 5, 4, 4,
+	5, 4, 4, 3, -1, -1, 0, -1, -1, 0, -1, -1, 0, 0, -1, -1,
+	0, 0, -1, -1, 0, 0, -1, -1, 0, 0, 0, -1, -1, 0, 0, 0,
+	-1, -1, 0, 0, 0, -1, -1, 0, 0, 0, -1, -1, 0, 0, 0, 0,
+	-1, -1, 0, 0, 0, 0, -1, -1, 0, 0, 0, 0, -1, -1, 0, 0,
+	0, 0, -1, -1, -1, 0, 0, 0, 0, -1, 0, 0, 0, 0, 0, -1,
+	0, 0, 0, 0, 0, -1, 0, 0, 0, 0, -1, -1, 0, 0, 0, 0,
+	-1, -1, 0, 0, 0, 0, -1, -1, -1, 0, 0, 0, -1, 0, 0, 0,
+	0, -1, 0, 0, 0, 0, -1, 0, 0, 0, -1, -1, 0, 0, 0, -1,
+	-1, -1, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, -1,
+	-1, -1, 0, -1, 0, 0, -1, 0, 0, -1, -1, -1, 0, -1, -1,
+};
+
+// Cholesky factorization for a fixed pattern with 36 rows and 155 off-diagonal nonzeros.
+inline void kernel_factorize(double *v) {
+	v[0] = std::sqrt(v[0]);
+	v[36] /= v[0];
+	v[37] /= v[0];
+	v[1] -= v[36] * v[36];
+	v[38] -= v[37] * v[36];
+	v[2] -= v[37] * v[37];
+	v[1] = std::sqrt(v[1]);
+	v[38] /= v[1];
+	v[39] /= v[1];
+	v[40] /= v[1];
+	v[2] -= v[38] * v[38];
+	v[41] -= v[39] * v[38];
+	v[42] -= v[40] * v[38];
+	v[3] -= v[39] * v[39];
+	v[44] -= v[40] * v[39];
+	v[4] -= v[40] * v[40];
+	v[2] = std::sqrt(v[2]);
+	v[41] /= v[2];
+	v[42] /= v[2];
+	v[43] /= v[2];
+	v[3] -= v[41] * v[41];
+	v[44] -= v[42] * v[41];
+	v[45] -= v[43] * v[41];
+	v[4] -= v[42] * v[42];
+	v[48] -= v[43] * v[42];
+	v[5] -= v[43] * v[43];
+	v[3] = std::sqrt(v[3]);
+	v[44] /= v[3];
+	v[45] /= v[3];
+	v[46] /= v[3];
+	v[47] /= v[3];
+	v[4] -= v[44] * v[44];
+	v[48] -= v[45] * v[44];
+	v[49] -= v[46] * v[44];
+	v[50] -= v[47] * v[44];
+	v[5] -= v[45] * v[45];
+	v[52] -= v[46] * v[45];
+	v[53] -= v[47] * v[45];
+	v[6] -= v[46] * v[46];
+	v[56] -= v[47] * v[46];
+	v[7] -= v[47] * v[47];
+	v[4] = std::sqrt(v[4]);
+	v[48] /= v[4];
+	v[49] /= v[4];
+	v[50] /= v[4];
+	v[51] /= v[4];
+	v[5] -= v[48] * v[48];
+	v[52] -= v[49] * v[48];
+	v[53] -= v[50] * v[48];
+	v[54] -= v[51] * v[48];
+	v[6] -= v[49] * v[49];
+	v[56] -= v[50] * v[49];
+	v[57] -= v[51] * v[49];
+	v[7] -= v[50] * v[50];
+	v[61] -= v[51] * v[50];
+	v[8] -= v[51] * v[51];
+	v[5] = std::sqrt(v[5]);
+	v[52] /= v[5];
+	v[53] /= v[5];
+	v[54] /= v[5];
+	v[55] /= v[5];
+	v[6] -= v[52] * v[52];
+	v[56] -= v[53] * v[52];
+	v[57] -= v[54] * v[52];
+	v[58] -= v[55] * v[52];
+	v[7] -= v[53] * v[53];
+	v[61] -= v[54] * v[53];
+	v[62] -= v[55] * v[53];
+	v[8] -= v[54] * v[54];
+	v[66] -= v[55] * v[54];
+	v[9] -= v[55] * v[55];
+	v[6] = std::sqrt(v[6]);
+	v[56] /= v[6];
+	v[57] /= v[6];
+	v[58] /= v[6];
+	v[59] /= v[6];
+	v[60] /= v[6];
+	v[7] -= v[56] * v[56];
+	v[61] -= v[57] * v[56];
+	v[62] -= v[58] * v[56];
+	v[63] -= v[59] * v[56];
+	v[64] -= v[60] * v[56];
+	v[8] -= v[57] * v[57];
+	v[66] -= v[58] * v[57];
+	v[67] -= v[59] * v[57];
+	v[68] -= v[60] * v[57];
+	v[9] -= v[58] * v[58];
+	v[71] -= v[59] * v[58];
+	v[72] -= v[60] * v[58];
+	v[10] -= v[59] * v[59];
+	v[76] -= v[60] * v[59];
+	v[11] -= v[60] * v[60];
+	v[7] = std::sqrt(v[7]);
+	v[61] /= v[7];
+	v[62] /= v[7];
+	v[63] /= v[7];
+	v[64] /= v[7];
+	v[65] /= v[7];
+	v[8] -= v[61] * v[61];
+	v[66] -= v[62] * v[61];
+	v[67] -= v[63] * v[61];
+	v[68] -= v[64] * v[61];
+	v[69] -= v[65] * v[61];
+	v[9] -= v[62] * v[62];
+	v[71] -= v[63] * v[62];
+	v[72] -= v[64] * v[62];
+	v[73] -= v[65] * v[62];
+	v[10] -= v[63] * v[63];
+	v[76] -= v[64] * v[63];
+	v[77] -= v[65] * v[63];
+	v[11] -= v[64] * v[64];
+	v[82] -= v[65] * v[64];
+	v[12] -= v[65] * v[65];
+	v[8] = std::sqrt(v[8]);
+	v[66] /= v[8];
+	v[67] /= v[8];
+	v[68] /= v[8];
+	v[69] /= v[8];
+	v[70] /= v[8];
+	v[9] -= v[66] * v[66];
+	v[71] -= v[67] * v[66];
+	v[72] -= v[68] * v[66];
+	v[73] -= v[69] * v[66];
+	v[74] -= v[70] * v[66];
+	v[10] -= v[67] * v[67];
+	v[76] -= v[68] * v[67];
+	v[77] -= v[69] * v[67];
+	v[78] -= v[70] * v[67];
+	v[11] -= v[68] * v[68];
+	v[82] -= v[69] * v[68];
+	v[83] -= v[70] * v[68];
+	v[12] -= v[69] * v[69];
+	v[88] -= v[70] * v[69];
+	v[13] -= v[70] * v[70];
+	v[9] = std::sqrt(v[9]);
+	v[71] /= v[9];
+	v[72] /= v[9];
+	v[73] /= v[9];
+	v[74] /= v[9];
+	v[75] /= v[9];
+	v[10] -= v[71] * v[71];
+	v[76] -= v[72] * v[71];
+	v[77] -= v[73] * v[71];
+	v[78] -= v[74] * v[71];
+	v[79] -= v[75] * v[71];
+	v[11] -= v[72] * v[72];
+	v[82] -= v[73] * v[72];
+	v[83] -= v[74] * v[72];
+	v[84] -= v[75] * v[72];
+	v[12] -= v[73] * v[73];
+	v[88] -= v[74] * v[73];
+	v[89] -= v[75] * v[73];
+	v[13] -= v[74] * v[74];
+	v[94] -= v[75] * v[74];
+	v[14] -= v[75] * v[75];
+	v[10] = std::sqrt(v[10]);
+	v[76] /= v[10];
+	v[77] /= v[10];
+	v[78] /= v[10];
+	v[79] /= v[10];
+	v[80] /= v[10];
+	v[81] /= v[10];
+	v[11] -= v[76] * v[76];
+	v[82] -= v[77] * v[76];
+	v[83] -= v[78] * v[76];
+	v[84] -= v[79] * v[76];
+	v[85] -= v[80] * v[76];
+	v[86] -= v[81] * v[76];
+	v[12] -= v[77] * v[77];
+	v[88] -= v[78] * v[77];
+	v[89] -= v[79] * v[77];
+	v[90] -= v[80] * v[77];
+	v[91] -= v[81] * v[77];
+	v[13] -= v[78] * v[78];
+	v[94] -= v[79] * v[78];
+	v[95] -= v[80] * v[78];
+	v[96] -= v[81] * v[78];
+	v[14] -= v[79] * v[79];
+	v[101] -= v[80] * v[79];
+	v[102] -= v[81] * v[79];
+	v[16] -= v[80] * v[80];
+	v[112] -= v[81] * v[80];
+	v[17] -= v[81] * v[81];
+	v[11] = std::sqrt(v[11]);
+	v[82] /= v[11];
+	v[83] /= v[11];
+	v[84] /= v[11];
+	v[85] /= v[11];
+	v[86] /= v[11];
+	v[87] /= v[11];
+	v[12] -= v[82] * v[82];
+	v[88] -= v[83] * v[82];
+	v[89] -= v[84] * v[82];
+	v[90] -= v[85] * v[82];
+	v[91] -= v[86] * v[82];
+	v[92] -= v[87] * v[82];
+	v[13] -= v[83] * v[83];
+	v[94] -= v[84] * v[83];
+	v[95] -= v[85] * v[83];
+	v[96] -= v[86] * v[83];
+	v[97] -= v[87] * v[83];
+	v[14] -= v[84] * v[84];
+	v[101] -= v[85] * v[84];
+	v[102] -= v[86] * v[84];
+	v[103] -= v[87] * v[84];
+	v[16] -= v[85] * v[85];
+	v[112] -= v[86] * v[85];
+	v[113] -= v[87] * v[85];
+	v[17] -= v[86] * v[86];
+	v[118] -= v[87] * v[86];
+	v[18] -= v[87] * v[87];
+	v[12] = std::sqrt(v[12]);
+	v[88] /= v[12];
+	v[89] /= v[12];
+	v[90] /= v[12];
+	v[91] /= v[12];
+	v[92] /= v[12];
+	v[93] /= v[12];
+	v[13] -= v[88] * v[88];
+	v[94] -= v[89] * v[88];
+	v[95] -= v[90] * v[88];
+	v[96] -= v[91] * v[88];
+	v[97] -= v[92] * v[88];
+	v[98] -= v[93] * v[88];
+	v[14] -= v[89] * v[89];
+	v[101] -= v[90] * v[89];
+	v[102] -= v[91] * v[89];
+	v[103] -= v[92] * v[89];
+	v[104] -= v[93] * v[89];
+	v[16] -= v[90] * v[90];
+	v[112] -= v[91] * v[90];
+	v[113] -= v[92] * v[90];
+	v[114] -= v[93] * v[90];
+	v[17] -= v[91] * v[91];
+	v[118] -= v[92] * v[91];
+	v[119] -= v[93] * v[91];
+	v[18] -= v[92] * v[92];
+	v[124] -= v[93] * v[92];
+	v[19] -= v[93] * v[93];
+	v[13] = std::sqrt(v[13]);
+	v[94] /= v[13];
+	v[95] /= v[13];
+	v[96] /= v[13];
+	v[97] /= v[13];
+	v[98] /= v[13];
+	v[99] /= v[13];
+	v[14] -= v[94] * v[94];
+	v[101] -= v[95] * v[94];
+	v[102] -= v[96] * v[94];
+	v[103] -= v[97] * v[94];
+	v[104] -= v[98] * v[94];
+	v[105] -= v[99] * v[94];
+	v[16] -= v[95] * v[95];
+	v[112] -= v[96] * v[95];
+	v[113] -= v[97] * v[95];
+	v[114] -= v[98] * v[95];
+	v[115] -= v[99] * v[95];
+	v[17] -= v[96] * v[96];
+	v[118] -= v[97] * v[96];
+	v[119] -= v[98] * v[96];
+	v[120] -= v[99] * v[96];
+	v[18] -= v[97] * v[97];
+	v[124] -= v[98] * v[97];
+	v[125] -= v[99] * v[97];
+	v[19] -= v[98] * v[98];
+	v[130] -= v[99] * v[98];
+	v[20] -= v[99] * v[99];
+	v[14] = std::sqrt(v[14]);
+	v[100] /= v[14];
+	v[101] /= v[14];
+	v[102] /= v[14];
+	v[103] /= v[14];
+	v[104] /= v[14];
+	v[105] /= v[14];
+	v[15] -= v[100] * v[100];
+	v[106] -= v[101] * v[100];
+	v[107] -= v[102] * v[100];
+	v[108] -= v[103] * v[100];
+	v[109] -= v[104] * v[100];
+	v[110] -= v[105] * v[100];
+	v[16] -= v[101] * v[101];
+	v[112] -= v[102] * v[101];
+	v[113] -= v[103] * v[101];
+	v[114] -= v[104] * v[101];
+	v[115] -= v[105] * v[101];
+	v[17] -= v[102] * v[102];
+	v[118] -= v[103] * v[102];
+	v[119] -= v[104] * v[102];
+	v[120] -= v[105] * v[102];
+	v[18] -= v[103] * v[103];
+	v[124] -= v[104] * v[103];
+	v[125] -= v[105] * v[103];
+	v[19] -= v[104] * v[104];
+	v[130] -= v[105] * v[104];
+	v[20] -= v[105] * v[105];
+	v[15] = std::sqrt(v[15]);
+	v[106] /= v[15];
+	v[107] /= v[15];
+	v[108] /= v[15];
+	v[109] /= v[15];
+	v[110] /= v[15];
+	v[111] /= v[15];
+	v[16] -= v[106] * v[106];
+	v[112] -= v[107] * v[106];
+	v[113] -= v[108] * v[106];
+	v[114] -= v[109] * v[106];
+	v[115] -= v[110] * v[106];
+	v[116] -= v[111] * v[106];
+	v[17] -= v[107] * v[107];
+	v[118] -= v[108] * v[107];
+	v[119] -= v[109] * v[107];
+	v[120] -= v[110] * v[107];
+	v[121] -= v[111] * v[107];
+	v[18] -= v[108] * v[108];
+	v[124] -= v[109] * v[108];
+	v[125] -= v[110] * v[108];
+	v[126] -= v[111] * v[108];
+	v[19] -= v[109] * v[109];
+	v[130] -= v[110] * v[109];
+	v[131] -= v[111] * v[109];
+	v[20] -= v[110] * v[110];
+	v[136] -= v[111] * v[110];
+	v[21] -= v[111] * v[111];
+	v[16] = std::sqrt(v[16]);
+	v[112] /= v[16];
+	v[113] /= v[16];
+	v[114] /= v[16];
+	v[115] /= v[16];
+	v[116] /= v[16];
+	v[117] /= v[16];
+	v[17] -= v[112] * v[112];
+	v[118] -= v[113] * v[112];
+	v[119] -= v[114] * v[112];
+	v[120] -= v[115] * v[112];
+	v[121] -= v[116] * v[112];
+	v[122] -= v[117] * v[112];
+	v[18] -= v[113] * v[113];
+	v[124] -= v[114] * v[113];
+	v[125] -= v[115] * v[113];
+	v[126] -= v[116] * v[113];
+	v[127] -= v[117] * v[113];
+	v[19] -= v[114] * v[114];
+	v[130] -= v[115] * v[114];
+	v[131] -= v[116] * v[114];
+	v[132] -= v[117] * v[114];
+	v[20] -= v[115] * v[115];
+	v[136] -= v[116] * v[115];
+	v[137] -= v[117] * v[115];
+	v[21] -= v[116] * v[116];
+	v[141] -= v[117] * v[116];
+	v[22] -= v[117] * v[117];
+	v[17] = std::sqrt(v[17]);
+	v[118] /= v[17];
+	v[119] /= v[17];
+	v[120] /= v[17];
+	v[121] /= v[17];
+	v[122] /= v[17];
+	v[123] /= v[17];
+	v[18] -= v[118] * v[118];
+	v[124] -= v[119] * v[118];
+	v[125] -= v[120] * v[118];
+	v[126] -= v[121] * v[118];
+	v[127] -= v[122] * v[118];
+	v[128] -= v[123] * v[118];
+	v[19] -= v[119] * v[119];
+	v[130] -= v[120] * v[119];
+	v[131] -= v[121] * v[119];
+	v[132] -= v[122] * v[119];
+	v[133] -= v[123] * v[119];
+	v[20] -= v[120] * v[120];
+	v[136] -= v[121] * v[120];
+	v[137] -= v[122] * v[120];
+	v[138] -= v[123] * v[120];
+	v[21] -= v[121] * v[121];
+	v[141] -= v[122] * v[121];
+	v[142] -= v[123] * v[121];
+	v[22] -= v[122] * v[122];
+	v[146] -= v[123] * v[122];
+	v[23] -= v[123] * v[123];
+	v[18] = std::sqrt(v[18]);
+	v[124] /= v[18];
+	v[125] /= v[18];
+	v[126] /= v[18];
+	v[127] /= v[18];
+	v[128] /= v[18];
+	v[129] /= v[18];
+	v[19] -= v[124] * v[124];
+	v[130] -= v[125] * v[124];
+	v[131] -= v[126] * v[124];
+	v[132] -= v[127] * v[124];
+	v[133] -= v[128] * v[124];
+	v[134] -= v[129] * v[124];
+	v[20] -= v[125] * v[125];
+	v[136] -= v[126] * v[125];
+	v[137] -= v[127] * v[125];
+	v[138] -= v[128] * v[125];
+	v[139] -= v[129] * v[125];
+	v[21] -= v[126] * v[126];
+	v[141] -= v[127] * v[126];
+	v[142] -= v[128] * v[126];
+	v[143] -= v[129] * v[126];
+	v[22] -= v[127] * v[127];
+	v[146] -= v[128] * v[127];
+	v[147] -= v[129] * v[127];
+	v[23] -= v[128] * v[128];
+	v[151] -= v[129] * v[128];
+	v[24] -= v[129] * v[129];
+	v[19] = std::sqrt(v[19]);
+	v[130] /= v[19];
+	v[131] /= v[19];
+	v[132] /= v[19];
+	v[133] /= v[19];
+	v[134] /= v[19];
+	v[135] /= v[19];
+	v[20] -= v[130] * v[130];
+	v[136] -= v[131] * v[130];
+	v[137] -= v[132] * v[130];
+	v[138] -= v[133] * v[130];
+	v[139] -= v[134] * v[130];
+	v[140] -= v[135] * v[130];
+	v[21] -= v[131] * v[131];
+	v[141] -= v[132] * v[131];
+	v[142] -= v[133] * v[131];
+	v[143] -= v[134] * v[131];
+	v[144] -= v[135] * v[131];
+	v[22] -= v[132] * v[132];
+	v[146] -= v[133] * v[132];
+	v[147] -= v[134] * v[132];
+	v[148] -= v[135] * v[132];
+	v[23] -= v[133] * v[133];
+	v[151] -= v[134] * v[133];
+	v[152] -= v[135] * v[133];
+	v[24] -= v[134] * v[134];
+	v[156] -= v[135] * v[134];
+	v[25] -= v[135] * v[135];
+	v[20] = std::sqrt(v[20]);
+	v[136] /= v[20];
+	v[137] /= v[20];
+	v[138] /= v[20];
+	v[139] /= v[20];
+	v[140] /= v[20];
+	v[21] -= v[136] * v[136];
+	v[141] -= v[137] * v[136];
+	v[142] -= v[138] * v[136];
+	v[143] -= v[139] * v[136];
+	v[144] -= v[140] * v[136];
+	v[22] -= v[137] * v[137];
+	v[146] -= v[138] * v[137];
+	v[147] -= v[139] * v[137];
+	v[148] -= v[140] * v[137];
+	v[23] -= v[138] * v[138];
+	v[151] -= v[139] * v[138];
+	v[152] -= v[140] * v[138];
+	v[24] -= v[139] * v[139];
+	v[156] -= v[140] * v[139];
+	v[25] -= v[140] * v[140];
+	v[21] = std::sqrt(v[21]);
+	v[141] /= v[21];
+	v[142] /= v[21];
+	v[143] /= v[21];
+	v[144] /= v[21];
+	v[145] /= v[21];
+	v[22] -= v[141] * v[141];
+	v[146] -= v[142] * v[141];
+	v[147] -= v[143] * v[141];
+	v[148] -= v[144] * v[141];
+	v[149] -= v[145] * v[141];
+	v[23] -= v[142] * v[142];
+	v[151] -= v[143] * v[142];
+	v[152] -= v[144] * v[142];
+	v[153] -= v[145] * v[142];
+	v[24] -= v[143] * v[143];
+	v[156] -= v[144] * v[143];
+	v[157] -= v[145] * v[143];
+	v[25] -= v[144] * v[144];
+	v[161] -= v[145] * v[144];
+	v[26] -= v[145] * v[145];
+	v[22] = std::sqrt(v[22]);
+	v[146] /= v[22];
+	v[147] /= v[22];
+	v[148] /= v[22];
+	v[149] /= v[22];
+	v[150] /= v[22];
+	v[23] -= v[146] * v[146];
+	v[151] -= v[147] * v[146];
+	v[152] -= v[148] * v[146];
+	v[153] -= v[149] * v[146];
+	v[154] -= v[150] * v[146];
+	v[24] -= v[147] * v[147];
+	v[156] -= v[148] * v[147];
+	v[157] -= v[149] * v[147];
+	v[158] -= v[150] * v[147];
+	v[25] -= v[148] * v[148];
+	v[161] -= v[149] * v[148];
+	v[162] -= v[150] * v[148];
+	v[26] -= v[149] * v[149];
+	v[165] -= v[150] * v[149];
+	v[27] -= v[150] * v[150];
+	v[23] = std::sqrt(v[23]);
+	v[151] /= v[23];
+	v[152] /= v[23];
+	v[153] /= v[23];
+	v[154] /= v[23];
+	v[155] /= v[23];
+	v[24] -= v[151] * v[151];
+	v[156] -= v[152] * v[151];
+	v[157] -= v[153] * v[151];
+	v[158] -= v[154] * v[151];
+	v[159] -= v[155] * v[151];
+	v[25] -= v[152] * v[152];
+	v[161] -= v[153] * v[152];
+	v[162] -= v[154] * v[152];
+	v[163] -= v[155] * v[152];
+	v[26] -= v[153] * v[153];
+	v[165] -= v[154] * v[153];
+	v[166] -= v[155] * v[153];
+	v[27] -= v[154] * v[154];
+	v[169] -= v[155] * v[154];
+	v[28] -= v[155] * v[155];
+	v[24] = std::sqrt(v[24]);
+	v[156] /= v[24];
+	v[157] /= v[24];
+	v[158] /= v[24];
+	v[159] /= v[24];
+	v[160] /= v[24];
+	v[25] -= v[156] * v[156];
+	v[161] -= v[157] * v[156];
+	v[162] -= v[158] * v[156];
+	v[163] -= v[159] * v[156];
+	v[164] -= v[160] * v[156];
+	v[26] -= v[157] * v[157];
+	v[165] -= v[158] * v[157];
+	v[166] -= v[159] * v[157];
+	v[167] -= v[160] * v[157];
+	v[27] -= v[158] * v[158];
+	v[169] -= v[159] * v[158];
+	v[170] -= v[160] * v[158];
+	v[28] -= v[159] * v[159];
+	v[173] -= v[160] * v[159];
+	v[29] -= v[160] * v[160];
+	v[25] = std::sqrt(v[25]);
+	v[161] /= v[25];
+	v[162] /= v[25];
+	v[163] /= v[25];
+	v[164] /= v[25];
+	v[26] -= v[161] * v[161];
+	v[165] -= v[162] * v[161];
+	v[166] -= v[163] * v[161];
+	v[167] -= v[164] * v[161];
+	v[27] -= v[162] * v[162];
+	v[169] -= v[163] * v[162];
+	v[170] -= v[164] * v[162];
+	v[28] -= v[163] * v[163];
+	v[173] -= v[164] * v[163];
+	v[29] -= v[164] * v[164];
+	v[26] = std::sqrt(v[26]);
+	v[165] /= v[26];
+	v[166] /= v[26];
+	v[167] /= v[26];
+	v[168] /= v[26];
+	v[27] -= v[165] * v[165];
+	v[169] -= v[166] * v[165];
+	v[170] -= v[167] * v[165];
+	v[171] -= v[168] * v[165];
+	v[28] -= v[166] * v[166];
+	v[173] -= v[167] * v[166];
+	v[174] -= v[168] * v[166];
+	v[29] -= v[167] * v[167];
+	v[177] -= v[168] * v[167];
+	v[30] -= v[168] * v[168];
+	v[27] = std::sqrt(v[27]);
+	v[169] /= v[27];
+	v[170] /= v[27];
+	v[171] /= v[27];
+	v[172] /= v[27];
+	v[28] -= v[169] * v[169];
+	v[173] -= v[170] * v[169];
+	v[174] -= v[171] * v[169];
+	v[175] -= v[172] * v[169];
+	v[29] -= v[170] * v[170];
+	v[177] -= v[171] * v[170];
+	v[178] -= v[172] * v[170];
+	v[30] -= v[171] * v[171];
+	v[180] -= v[172] * v[171];
+	v[31] -= v[172] * v[172];
+	v[28] = std::sqrt(v[28]);
+	v[173] /= v[28];
+	v[174] /= v[28];
+	v[175] /= v[28];
+	v[176] /= v[28];
+	v[29] -= v[173] * v[173];
+	v[177] -= v[174] * v[173];
+	v[178] -= v[175] * v[173];
+	v[179] -= v[176] * v[173];
+	v[30] -= v[174] * v[174];
+	v[180] -= v[175] * v[174];
+	v[181] -= v[176] * v[174];
+	v[31] -= v[175] * v[175];
+	v[183] -= v[176] * v[175];
+	v[32] -= v[176] * v[176];
+	v[29] = std::sqrt(v[29]);
+	v[177] /= v[29];
+	v[178] /= v[29];
+	v[179] /= v[29];
+	v[30] -= v[177] * v[177];
+	v[180] -= v[178] * v[177];
+	v[181] -= v[179] * v[177];
+	v[31] -= v[178] * v[178];
+	v[183] -= v[179] * v[178];
+	v[32] -= v[179] * v[179];
+	v[30] = std::sqrt(v[30]);
+	v[180] /= v[30];
+	v[181] /= v[30];
+	v[182] /= v[30];
+	v[31] -= v[180] * v[180];
+	v[183] -= v[181] * v[180];
+	v[184] -= v[182] * v[180];
+	v[32] -= v[181] * v[181];
+	v[186] -= v[182] * v[181];
+	v[33] -= v[182] * v[182];
+	v[31] = std::sqrt(v[31]);
+	v[183] /= v[31];
+	v[184] /= v[31];
+	v[185] /= v[31];
+	v[32] -= v[183] * v[183];
+	v[186] -= v[184] * v[183];
+	v[187] -= v[185] * v[183];
+	v[33] -= v[184] * v[184];
+	v[188] -= v[185] * v[184];
+	v[34] -= v[185] * v[185];
+	v[32] = std::sqrt(v[32]);
+	v[186] /= v[32];
+	v[187] /= v[32];
+	v[33] -= v[186] * v[186];
+	v[188] -= v[187] * v[186];
+	v[34] -= v[187] * v[187];
+	v[33] = std::sqrt(v[33]);
+	v[188] /= v[33];
+	v[189] /= v[33];
+	v[34] -= v[188] * v[188];
+	v[190] -= v[189] * v[188];
+	v[35] -= v[189] * v[189];
+	v[34] = std::sqrt(v[34]);
+	v[190] /= v[34];
+	v[35] -= v[190] * v[190];
+	v[35] = std::sqrt(v[35]);
+}
@@ -0,0 +1,415 @@
+/**
+ * Implementation of the C interface declared in aa.h, running the algorithms
+ * directly on views of the caller-owned CSR arrays.
+ */
+
+#include <new>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#include "aa.h"
+#include "algos.h"
+#include "csr_graph.h"
+
+struct aa_workspace {
+	// Scratch buffer to validate orders
+	std::vector<unsigned char> seen;
+	// Scratch buffers to validate graphs
+	std::vector<size_t> mark;
+	std::vector<size_t> sources;
+	// Cache of the orders computed by aa_exact_order_csr()
+	ExactOrderCache exact_cache;
+};
+
+namespace {
+
+// Views of the caller-owned arrays: signed integers are reinterpreted as the
+// unsigned integers of the same size, which is allowed by the aliasing rules
+template <class Int>
+using View = CsrGraphView<std::make_unsigned_t<Int>, std::make_unsigned_t<Int>>;
+
+const aa_options default_options = {0, 0, nullptr};
+
+bool validate(const aa_options &opts) {
+	return !(opts.flags & AA_FLAG_NO_VALIDATE);
+}
+
+/**
+ * Check that CSR arrays with valid offsets and targets have no duplicate
+ * neighbors and that each v->w has a matching w->v, in O(V + E) time.
+ *
+ * The sources of the arcs to each vertex are gathered with a transpose pass.
+ * Since neighbors are distinct, the sources of the arcs to v are exactly its
+ * neighbors if they are as many and all of them are neighbors of v.
+ */
+template <class Int>
+bool is_simple_symmetric(Int n, const Int *offsets, const Int *targets, const aa_options &opts) {
+	std::vector<size_t> local_mark, local_sources;
+	auto &mark = opts.workspace ? opts.workspace->mark : local_mark;
+	auto &sources = opts.workspace ? opts.workspace->sources : local_sources;
+
+	// In-degrees, which must match the out-degrees
+	mark.assign(n, 0);
+
+	for (Int i = 0; i < offsets[n]; i++)
+		mark[targets[i]]++;
+
+	for (Int v = 0; v < n; v++) {
+		if (mark[v] != static_cast<size_t>(offsets[v + 1] - offsets[v]))
+			return false;
+
+		mark[v] = offsets[v];
+	}
+
+	// Transpose, whose offsets are then the same
+	sources.resize(offsets[n]);
+
+	for (Int v = 0; v < n; v++) {
+		for (Int i = offsets[v]; i < offsets[v + 1]; i++)
+			sources[mark[targets[i]]++] = v;
+	}
+
+	// mark[w] = v + 1 for the neighbors w of v
+	std::fill(mark.begin(), mark.end(), 0);
+
+	for (Int v = 0; v < n; v++) {
+		const size_t stamp = static_cast<size_t>(v) + 1;
+
+		for (Int i = offsets[v]; i < offsets[v + 1]; i++) {
+			if (mark[targets[i]] == stamp)
+				return false;
+
+			mark[targets[i]] = stamp;
+		}
+
+		for (Int i = offsets[v]; i < offsets[v + 1]; i++) {
+			if (mark[sources[i]] != stamp)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+template <class Int>
+aa_status make_view(Int n, const Int *offsets, const Int *targets, const aa_options &opts, View<Int> &g) {
+	typedef std::make_unsigned_t<Int> U;
+
+	if (n < 0 || !offsets || (n > 0 && !targets))
+		return AA_EINVAL;
+
+	// The last vertex is reserved as null_vertex()
+	if (static_cast<U>(n) >= std::numeric_limits<U>::max())
+		return AA_ETOOBIG;
+
+	if (validate(opts)) {
+		if (offsets[0] != 0)
+			return AA_EINVAL;
+
+		for (Int v = 0; v < n; v++) {
+			if (offsets[v + 1] < offsets[v])
+				return AA_EINVAL;
+
+			for (Int i = offsets[v]; i < offsets[v + 1]; i++) {
+				if (targets[i] < 0 || targets[i] >= n || targets[i] == v)
+					return AA_EINVAL;
+			}
+		}
+
+		if (!is_simple_symmetric(n, offsets, targets, opts))
+			return AA_EINVAL;
+	}
+
+	g = View<Int>(n, reinterpret_cast<const U *>(offsets), reinterpret_cast<const U *>(targets));
+	return AA_OK;
+}
+
+template <class Int>
+aa_status read_order(Int n, const Int *order, const aa_options &opts, VertexOrder<View<Int>> &res) {
+	typedef std::make_unsigned_t<Int> U;
+
+	if (!order)
+		return AA_EINVAL;
+
+	if (validate(opts)) {
+		std::vector<unsigned char> local;
+		auto &seen = opts.workspace ? opts.workspace->seen : local;
+
+		seen.assign(n, 0);
+
+		for (Int i = 0; i < n; i++) {
+			if (order[i] < 0 || order[i] >= n || seen[order[i]])
+				return AA_EORDER;
+
+			seen[order[i]] = 1;
+		}
+	}
+
+	const U *begin = reinterpret_cast<const U *>(order);
+	res.assign(begin, begin + n);
+	return AA_OK;
+}
+
+template <class Int, class Order>
+void write_order(const Order &order, Int *out) {
+	std::copy(order.begin(), order.end(), out);
+}
+
+/**
+ * Run an API function body, translating exceptions into status codes so that
+ * they never cross the language boundary.
+ */
+template <class Fn>
+aa_status guarded(Fn fn) {
+	try {
+		return fn();
+	} catch (const std::bad_alloc &) {
+		return AA_ENOMEM;
+	} catch (...) {
+		return AA_EINTERNAL;
+	}
+}
+
+template <class Int, class Algo>
+aa_status compute_order(Int n, const Int *offsets, const Int *targets, Int *order,
+		const aa_options *popts, Algo algo) {
+	return guarded([&] {
+		const aa_options &opts = popts ? *popts : default_options;
+		View<Int> g;
+		aa_status res = make_view(n, offsets, targets, opts, g);
+
+		if (res != AA_OK)
+			return res;
+		if (!order)
+			return AA_EINVAL;
+		if (n > 0)
+			write_order(algo(g, opts), order);
+
+		return AA_OK;
+	});
+}
+
+template <class Int>
+aa_status nd_order(Int n, const Int *offsets, const Int *targets, Int *order, const aa_options *opts) {
+	typedef typename CsrGraph<>::vertex_descriptor Index;
+
+	// Nested dissection works on a snapshot of the graph with 32-bit indices
+	if (n >= 0 && static_cast<std::make_unsigned_t<Int>>(n) >= std::numeric_limits<Index>::max())
+		return AA_ETOOBIG;
+
+	return compute_order(n, offsets, targets, order, opts, [](const View<Int> &g, const aa_options &o) {
+		return distributed_order(g, o.n_threads > 0 ? o.n_threads : 1, (o.flags & AA_FLAG_FORK) != 0);
+	});
+}
+
+// FILL identifies vertices by their position in the order with 32-bit indices
+template <class Int>
+bool too_big_for_fill(Int n) {
+	return n >= 0 && static_cast<std::make_unsigned_t<Int>>(n) > std::numeric_limits<uint32_t>::max();
+}
+
+template <class Int>
+aa_status fill_count(Int n, const Int *offsets, const Int *targets, const Int *order,
+		int64_t *count, const aa_options *popts) {
+	if (too_big_for_fill(n))
+		return AA_ETOOBIG;
+
+	return guarded([&] {
+		const aa_options &opts = popts ? *popts : default_options;
+		View<Int> g;
+		VertexOrder<View<Int>> o;
+		aa_status res = make_view(n, offsets, targets, opts, g);
+
+		if (res != AA_OK || (res = read_order(n, order, opts, o)) != AA_OK)
+			return res;
+		if (!count)
+			return AA_EINVAL;
+
+		*count = n > 0 ? fill_in_count(g, o) : 0;
+		return AA_OK;
+	});
+}
+
+template <class Int>
+aa_status fill_in_edges(Int n, const Int *offsets, const Int *targets, const Int *order,
+		int64_t max_edges, Int *edges, int64_t *count, const aa_options *popts) {
+	if (too_big_for_fill(n))
+		return AA_ETOOBIG;
+
+	return guarded([&] {
+		const aa_options &opts = popts ? *popts : default_options;
+		View<Int> g;
+		VertexOrder<View<Int>> o;
+		aa_status res = make_view(n, offsets, targets, opts, g);
+
+		if (res != AA_OK || (res = read_order(n, order, opts, o)) != AA_OK)
+			return res;
+		if (!count || max_edges < 0 || (max_edges > 0 && !edges))
+			return AA_EINVAL;
+
+		if (n == 0) {
+			*count = 0;
+			return AA_OK;
+		}
+
+		const auto fill = fill_in(g, o);
+		*count = fill.size();
+
+		if (*count > max_edges)
+			return AA_ERANGE;
+
+		std::vector<std::pair<std::make_unsigned_t<Int>, std::make_unsigned_t<Int>>> sorted(fill.begin(), fill.end());
+		std::sort(sorted.begin(), sorted.end());
+
+		for (const auto &[a, b] : sorted) {
+			*edges++ = a;
+			*edges++ = b;
+		}
+
+		return AA_OK;
+	});
+}
+
+template <class Int>
+aa_status is_peo(Int n, const Int *offsets, const Int *targets, const Int *order,
+		int *result, const aa_options *popts) {
+	if (too_big_for_fill(n))
+		return AA_ETOOBIG;
+
+	return guarded([&] {
+		const aa_options &opts = popts ? *popts : default_options;
+		View<Int> g;
+		VertexOrder<View<Int>> o;
+		aa_status res = make_view(n, offsets, targets, opts, g);
+
+		if (res != AA_OK || (res = read_order(n, order, opts, o)) != AA_OK)
+			return res;
+		if (!result)
+			return AA_EINVAL;
+
+		*result = n == 0 || is_perfect_elimination_order(g, o);
+		return AA_OK;
+	});
+}
+
+} // namespace
+
+extern "C" {
+
+int aa_api_version(void) {
+	return AA_API_VERSION;
+}
+
+const char *aa_strerror(aa_status status) {
+	switch (status) {
+	case AA_OK:        return "success";
+	case AA_EINVAL:    return "invalid argument";
+	case AA_EORDER:    return "order is not a permutation of the vertices";
+	case AA_ERANGE:    return "output buffer too small";
+	case AA_ETOOBIG:   return "graph too large";
+	case AA_ENOMEM:    return "out of memory";
+	case AA_EINTERNAL: return "internal error";
+	}
+
+	return "unknown error";
+}
+
+void aa_options_init(aa_options *opts) {
+	*opts = default_options;
+}
+
+aa_workspace *aa_workspace_create(void) {
+	return new (std::nothrow) aa_workspace();
+}
+
+void aa_workspace_destroy(aa_workspace *ws) {
+	delete ws;
+}
+
+aa_status aa_lex_m_csr(int32_t n, const int32_t *offsets, const int32_t *targets,
+		int32_t *order, const aa_options *opts) {
+	return compute_order(n, offsets, targets, order, opts, [](const auto &g, const aa_options &) {
+		return lex_m(g);
+	});
+}
+
+aa_status aa_lex_m_csr64(int64_t n, const int64_t *offsets, const int64_t *targets,
+		int64_t *order, const aa_options *opts) {
+	return compute_order(n, offsets, targets, order, opts, [](const auto &g, const aa_options &) {
+		return lex_m(g);
+	});
+}
+
+aa_status aa_lex_p_csr(int32_t n, const int32_t *offsets, const int32_t *targets,
+		int32_t *order, const aa_options *opts) {
+	return compute_order(n, offsets, targets, order, opts, [](const auto &g, const aa_options &o) {
+		return lex_p(g, o.n_threads > 0 ? o.n_threads : 1);
+	});
+}
+
+aa_status aa_lex_p_csr64(int64_t n, const int64_t *offsets, const int64_t *targets,
+		int64_t *order, const aa_options *opts) {
+	return compute_order(n, offsets, targets, order, opts, [](const auto &g, const aa_options &o) {
+		return lex_p(g, o.n_threads > 0 ? o.n_threads : 1);
+	});
+}
+
+aa_status aa_nd_order_csr(int32_t n, const int32_t *offsets, const int32_t *targets,
+		int32_t *order, const aa_options *opts) {
+	return nd_order(n, offsets, targets, order, opts);
+}
+
+aa_status aa_nd_order_csr64(int64_t n, const int64_t *offsets, const int64_t *targets,
+		int64_t *order, const aa_options *opts) {
+	return nd_order(n, offsets, targets, order, opts);
+}
+
+aa_status aa_exact_order_csr(int32_t n, const int32_t *offsets, const int32_t *targets,
+		aa_objective objective, int32_t *order, const aa_options *opts) {
+	if (n > 64)
+		return AA_ETOOBIG;
+	if (objective != AA_OBJECTIVE_FILL && objective != AA_OBJECTIVE_WIDTH)
+		return AA_EINVAL;
+
+	const ExactObjective obj = objective == AA_OBJECTIVE_FILL ? ExactObjective::fill : ExactObjective::width;
+
+	return compute_order(n, offsets, targets, order, opts, [obj](const auto &g, const aa_options &o) {
+		return exact_order(g, obj, o.workspace ? &o.workspace->exact_cache : nullptr);
+	});
+}
+
+aa_status aa_fill_count_csr(int32_t n, const int32_t *offsets, const int32_t *targets,
+		const int32_t *order, int64_t *count, const aa_options *opts) {
+	return fill_count(n, offsets, targets, order, count, opts);
+}
+
+aa_status aa_fill_count_csr64(int64_t n, const int64_t *offsets, const int64_t *targets,
+		const int64_t *order, int64_t *count, const aa_options *opts) {
+	return fill_count(n, offsets, targets, order, count, opts);
+}
+
+aa_status aa_fill_in_csr(int32_t n, const int32_t *offsets, const int32_t *targets,
+		const int32_t *order, int64_t max_edges, int32_t *edges, int64_t *count,
+		const aa_options *opts) {
+	return fill_in_edges(n, offsets, targets, order, max_edges, edges, count, opts);
+}
+
+aa_status aa_fill_in_csr64(int64_t n, const int64_t *offsets, const int64_t *targets,
+		const int64_t *order, int64_t max_edges, int64_t *edges, int64_t *count,
+		const aa_options *opts) {
+	return fill_in_edges(n, offsets, targets, order, max_edges, edges, count, opts);
+}
+
+aa_status aa_is_peo_csr(int32_t n, const int32_t *offsets, const int32_t *targets,
+		const int32_t *order, int *result, const aa_options *opts) {
+	return is_peo(n, offsets, targets, order, result, opts);
+}
+
+aa_status aa_is_peo_csr64(int64_t n, const int64_t *offsets, const int64_t *targets,
+		const int64_t *order, int *result, const aa_options *opts) {
+	return is_peo(n, offsets, targets, order, result, opts);
+}
+
+} // extern "C"
@@ -0,0 +1,198 @@
+/**
+ * C interface to the elimination ordering algorithms, usable from C and from
+ * any language with a C foreign function interface.
+ *
+ * Graphs are passed as caller-owned arrays in compressed sparse row (CSR)
+ * format, which are used in place without being copied: the neighbors of
+ * vertex v are targets[offsets[v]], ..., targets[offsets[v + 1] - 1]. Graphs
+ * must be simple and undirected, i.e. each edge v--w must appear both in the
+ * neighbors of v and in the neighbors of w, and there must be no self-loops or
+ * duplicate neighbors. Results are written into caller-owned buffers.
+ *
+ * Functions with the _csr suffix take 32-bit arrays, functions with the
+ * _csr64 suffix take 64-bit arrays (e.g. the indptr/indices arrays of a SciPy
+ * sparse matrix). All functions return AA_OK on success or one of the other
+ * aa_status codes on failure, in which case the output buffers are left in an
+ * unspecified state.
+ */
+
+#ifndef AA_H
+#define AA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__GNUC__)
+#define AA_API __attribute__((visibility("default")))
+#else
+#define AA_API
+#endif
+
+// Version of the interface, incremented on incompatible changes
+#define AA_API_VERSION 1
+
+typedef enum aa_status {
+	AA_OK = 0,
+	// Invalid argument, e.g. NULL pointer or malformed CSR arrays
+	AA_EINVAL = 1,
+	// The given order is not a permutation of the vertices of the graph
+	AA_EORDER = 2,
+	// Output buffer too small, the required size is returned anyway
+	AA_ERANGE = 3,
+	// The graph is too large for the requested algorithm
+	AA_ETOOBIG = 4,
+	// Out of memory
+	AA_ENOMEM = 5,
+	// Unexpected internal error
+	AA_EINTERNAL = 6
+} aa_status;
+
+typedef enum aa_objective {
+	// Minimize the number of edges of the fill-in
+	AA_OBJECTIVE_FILL = 0,
+	// Minimize the width of the order (treewidth)
+	AA_OBJECTIVE_WIDTH = 1
+} aa_objective;
+
+// Skip validation of the CSR arrays and of the orders passed in, which takes
+// O(V + E) time and memory. Use only if the inputs are known to be valid:
+// invalid inputs cause undefined behavior.
+#define AA_FLAG_NO_VALIDATE 0x1u
+// Allow functions to fork() worker processes, which is only safe if the
+// calling process is single-threaded
+#define AA_FLAG_FORK 0x2u
+
+/**
+ * Opaque workspace holding scratch buffers and caches reused across calls,
+ * which avoids repeated allocations when calling the same functions many times.
+ * A workspace must not be used by more than one call at a time.
+ */
+typedef struct aa_workspace aa_workspace;
+
+/**
+ * Options common to all functions. A NULL pointer to options is equivalent to
+ * options initialized with aa_options_init().
+ */
+typedef struct aa_options {
+	// Maximum number of workers to use, 0 to let the library decide
+	uint32_t n_threads;
+	// Combination of AA_FLAG_* values
+	uint32_t flags;
+	// Optional workspace to use, or NULL
+	aa_workspace *workspace;
+} aa_options;
+
+AA_API int aa_api_version(void);
+AA_API const char *aa_strerror(aa_status status);
+AA_API void aa_options_init(aa_options *opts);
+
+AA_API aa_workspace *aa_workspace_create(void);
+AA_API void aa_workspace_destroy(aa_workspace *ws);
+
+/**
+ * Compute a minimal elimination order with the LEX M algorithm.
+ *
+ * @param n       number of vertices
+ * @param offsets array of n + 1 offsets into `targets`
+ * @param targets neighbors of the vertices
+ * @param order   output array of n vertices, in elimination order
+ * @param opts    options, or NULL
+ */
+AA_API aa_status aa_lex_m_csr(int32_t n, const int32_t *offsets, const int32_t *targets,
+		int32_t *order, const aa_options *opts);
+AA_API aa_status aa_lex_m_csr64(int64_t n, const int64_t *offsets, const int64_t *targets,
+		int64_t *order, const aa_options *opts);
+
+/**
+ * Compute an elimination order with the LEX P algorithm, which is a perfect
+ * elimination order if the graph is chordal. The neighbors of vertices of very
+ * high degree are processed by up to opts->n_threads threads.
+ *
+ * Parameters are the same as for aa_lex_m_csr().
+ */
+AA_API aa_status aa_lex_p_csr(int32_t n, const int32_t *offsets, const int32_t *targets,
+		int32_t *order, const aa_options *opts);
+AA_API aa_status aa_lex_p_csr64(int64_t n, const int64_t *offsets, const int64_t *targets,
+		int64_t *order, const aa_options *opts);
+
+/**
+ * Compute an elimination order by nested dissection into opts->n_threads parts.
+ * With the AA_FLAG_FORK flag, the parts are ordered in parallel by worker
+ * processes forked from the calling one, which must then be single-threaded
+ * (unlike most hosts of foreign function interfaces, e.g. Python). Otherwise,
+ * they are ordered by the calling thread, giving the same order.
+ *
+ * Parameters are the same as for aa_lex_m_csr().
+ */
+AA_API aa_status aa_nd_order_csr(int32_t n, const int32_t *offsets, const int32_t *targets,
+		int32_t *order, const aa_options *opts);
+AA_API aa_status aa_nd_order_csr64(int64_t n, const int64_t *offsets, const int64_t *targets,
+		int64_t *order, const aa_options *opts);
+
+/**
+ * Compute an optimal elimination order for a graph of at most 64 vertices.
+ * Orders are cached in the workspace, if any.
+ *
+ * @param objective quantity to minimize
+ *
+ * Other parameters are the same as for aa_lex_m_csr().
+ */
+AA_API aa_status aa_exact_order_csr(int32_t n, const int32_t *offsets, const int32_t *targets,
+		aa_objective objective, int32_t *order, const aa_options *opts);
+
+/**
+ * Count the edges of the fill-in of the graph for an elimination order. This and
+ * the following functions return AA_ETOOBIG for graphs of 2^32 vertices or more.
+ *
+ * @param order array of n vertices, in elimination order
+ * @param count output number of edges of the fill-in
+ *
+ * Other parameters are the same as for aa_lex_m_csr().
+ */
+AA_API aa_status aa_fill_count_csr(int32_t n, const int32_t *offsets, const int32_t *targets,
+		const int32_t *order, int64_t *count, const aa_options *opts);
+AA_API aa_status aa_fill_count_csr64(int64_t n, const int64_t *offsets, const int64_t *targets,
+		const int64_t *order, int64_t *count, const aa_options *opts);
+
+/**
+ * Compute the edges of the fill-in of the graph for an elimination order. Edge
+ * i is written as edges[2 * i], edges[2 * i + 1], with the smaller vertex
+ * first, and edges are sorted. If the fill-in has more than `max_edges` edges,
+ * AA_ERANGE is returned and `count` is set to the number of edges anyway.
+ *
+ * @param order     array of n vertices, in elimination order
+ * @param max_edges capacity of `edges` in number of edges
+ * @param edges     output array of 2 * max_edges vertices
+ * @param count     output number of edges of the fill-in
+ *
+ * Other parameters are the same as for aa_lex_m_csr().
+ */
+AA_API aa_status aa_fill_in_csr(int32_t n, const int32_t *offsets, const int32_t *targets,
+		const int32_t *order, int64_t max_edges, int32_t *edges, int64_t *count,
+		const aa_options *opts);
+AA_API aa_status aa_fill_in_csr64(int64_t n, const int64_t *offsets, const int64_t *targets,
+		const int64_t *order, int64_t max_edges, int64_t *edges, int64_t *count,
+		const aa_options *opts);
+
+/**
+ * Determine whether an order is a perfect elimination order for the graph.
+ *
+ * @param order  array of n vertices, in elimination order
+ * @param result output 1/0 whether `order` is a perfect elimination order
+ *
+ * Other parameters are the same as for aa_lex_m_csr().
+ */
+AA_API aa_status aa_is_peo_csr(int32_t n, const int32_t *offsets, const int32_t *targets,
+		const int32_t *order, int *result, const aa_options *opts);
+AA_API aa_status aa_is_peo_csr64(int64_t n, const int64_t *offsets, const int64_t *targets,
+		const int64_t *order, int *result, const aa_options *opts);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AA_H
@@ -0,0 +1,9 @@
+/**
+ * Explicit instantiation definitions of the algorithms declared in
+ * precompiled.h, compiled into the static library.
+ */
+
+#define AA_PRECOMPILED_DEFINITIONS
+#include "precompiled.h"
+
+AA_INSTANTIATE_ALL()
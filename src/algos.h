@@ -1,8 +1,20 @@
 #ifndef ALGOS_H
 #define ALGOS_H
 
+#include "block_order.h"
+#include "chordal_subgraph.h"
+#include "clique_tree.h"
+#include "column_order.h"
+#include "distributed_order.h"
+#include "elim_plan.h"
+#include "etree.h"
+#include "exact_order.h"
 #include "fill.h"
+#include "fill_oracle.h"
+#include "iluk.h"
 #include "lex_m.h"
 #include "lex_p.h"
+#include "min_degree.h"
+#include "schur.h"
 
 #endif
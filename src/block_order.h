@@ -0,0 +1,235 @@
+/**
+ * Minimal elimination orders computed block by block: the graph is split at its
+ * articulation points into biconnected components (blocks) with the algorithm
+ * by Hopcroft & Tarjan, in linear time, and each block is ordered by LEX M
+ * independently. A minimal triangulation of a graph is the union of minimal
+ * triangulations of its blocks, so the orders of the blocks are concatenated
+ * following the block-cut tree, each articulation point being eliminated
+ * together with the block closest to the root.
+ *
+ * See: https://doi.org/10.1145/362248.362272
+ */
+
+#ifndef ALGO_BLOCK_ORDER_H
+#define ALGO_BLOCK_ORDER_H
+
+#include <cassert>
+#include <vector>
+#include <limits>
+#include <utility>
+#include <numeric>
+#include <algorithm>
+#include <boost/graph/graph_concepts.hpp>
+
+#include "utils.h"
+#include "csr_graph.h"
+#include "lex_m.h"
+#include "parallel.h"
+#include "probes.h"
+#include "metrics.h"
+
+/**
+ * Biconnected component of a CsrGraph, as an induced subgraph.
+ */
+struct GraphBlock {
+	typedef typename CsrGraph<>::vertex_descriptor Index;
+
+	// Vertices of the block, ending with the articulation point (or the root)
+	// connecting it to its parent in the block-cut tree
+	std::vector<Index> vertices;
+	// Edges of the block between positions in `vertices`
+	std::vector<std::pair<Index, Index>> edges;
+};
+
+/**
+ * Compute the biconnected components of a CsrGraph with an iterative depth
+ * first search.
+ *
+ * @param  g     graph
+ * @param  roots filled with the roots of the search, one per connected
+ *               component, which are the last vertex of all their blocks
+ * @return the blocks of the graph, in post-order of the block-cut tree: each
+ *         block comes after all the blocks hanging from its vertices other than
+ *         the last one. Isolated vertices have no block.
+ *
+ * @pre `g` is a simple, undirected graph
+ */
+inline std::vector<GraphBlock> biconnected_blocks(const CsrGraph<> &g, std::vector<GraphBlock::Index> &roots) {
+	typedef GraphBlock::Index Index;
+	typedef typename boost::graph_traits<CsrGraph<>>::adjacency_iterator AdjIter;
+
+	struct Frame {
+		Index v;
+		AdjIter next, end;
+	};
+
+	constexpr Index unvisited = std::numeric_limits<Index>::max();
+	const Index n_vertices = num_vertices(g);
+	std::vector<Index> disc(n_vertices, unvisited);
+	std::vector<Index> low(n_vertices);
+	std::vector<size_t> block_of(n_vertices, std::numeric_limits<size_t>::max());
+	std::vector<Index> local(n_vertices);
+	std::vector<std::pair<Index, Index>> edge_stack;
+	std::vector<Frame> frames;
+	std::vector<GraphBlock> blocks;
+	Index time = 0;
+
+	// Make a block of the edges on the stack down to the tree edge u--v
+	auto pop_block = [&](Index u, Index v) {
+		GraphBlock b;
+		const size_t id = blocks.size();
+		auto number = [&](Index x) {
+			if (block_of[x] != id) {
+				block_of[x] = id;
+				local[x] = b.vertices.size();
+				b.vertices.push_back(x);
+			}
+		};
+
+		// Mark u as seen, to number it last
+		block_of[u] = id;
+
+		auto it = edge_stack.end();
+
+		do {
+			--it;
+			number(it->first);
+			number(it->second);
+		} while (it->first != u || it->second != v);
+
+		local[u] = b.vertices.size();
+		b.vertices.push_back(u);
+
+		b.edges.reserve(edge_stack.end() - it);
+
+		for (auto e = it; e != edge_stack.end(); ++e)
+			b.edges.emplace_back(local[e->first], local[e->second]);
+
+		edge_stack.erase(it, edge_stack.end());
+		blocks.push_back(std::move(b));
+	};
+
+	for (Index r = 0; r < n_vertices; r++) {
+		if (disc[r] != unvisited)
+			continue;
+
+		roots.push_back(r);
+		disc[r] = low[r] = time++;
+		frames.push_back({r, adjacent_vertices(r, g).first, adjacent_vertices(r, g).second});
+
+		while (!frames.empty()) {
+			Frame &f = frames.back();
+			const Index v = f.v;
+
+			if (f.next != f.end) {
+				const Index w = *f.next++;
+
+				if (disc[w] == unvisited) {
+					// Tree edge
+					edge_stack.emplace_back(v, w);
+					disc[w] = low[w] = time++;
+					frames.push_back({w, adjacent_vertices(w, g).first, adjacent_vertices(w, g).second});
+				} else if (disc[w] < disc[v] && (frames.size() < 2 || frames[frames.size() - 2].v != w)) {
+					// Back edge to an ancestor other than the parent
+					edge_stack.emplace_back(v, w);
+					low[v] = std::min(low[v], disc[w]);
+				}
+
+				continue;
+			}
+
+			frames.pop_back();
+
+			if (!frames.empty()) {
+				const Index u = frames.back().v;
+
+				low[u] = std::min(low[u], low[v]);
+
+				// Nothing below v reaches above u: u separates them
+				if (low[v] >= disc[u])
+					pop_block(u, v);
+			}
+		}
+	}
+
+	return blocks;
+}
+
+/**
+ * Compute a minimal elimination order for the given graph, splitting it into
+ * biconnected components and running LEX M on each one. LEX M takes O(VE) time
+ * on a connected graph, so splitting it into k similar blocks makes it about k
+ * times faster, plus the blocks are ordered by n_threads threads in parallel.
+ *
+ * @param  g         graph to compute the order for
+ * @param  n_threads number of threads ordering blocks
+ * @return a minimal elimination order for the graph as an ordered sequence of
+ *         all its vertices
+ *
+ * Probes: block_lex_m_entry(V, E), block_lex_m_split(blocks, largest block
+ * size), block_lex_m_block(size, E) for each block ordered by LEX M, and
+ * block_lex_m_return(V, blocks).
+ *
+ * @pre `g` is a simple, undirected graph; `n_threads` > 0
+ */
+template <class Graph>
+VertexOrder<Graph> block_lex_m(const Graph &g, unsigned n_threads = 1) {
+	typedef GraphBlock::Index Index;
+
+	BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<Graph>));
+	BOOST_CONCEPT_ASSERT((boost::AdjacencyGraphConcept<Graph>));
+	AA_METRICS_CALL(block_lex_m, num_vertices(g), num_edges(g));
+
+	const auto snap = make_csr_snapshot(g);
+	const auto n_vertices = snap.vertices.size();
+	std::vector<Index> roots;
+
+	AA_PROBE2(block_lex_m_entry, n_vertices, num_edges(snap.graph));
+
+	assert(n_threads > 0);
+
+	const std::vector<GraphBlock> blocks = biconnected_blocks(snap.graph, roots);
+	std::vector<size_t> offset(blocks.size() + 1);
+	std::vector<size_t> by_size(blocks.size());
+	VertexOrder<Graph> order(n_vertices);
+
+	// The last vertex of each block is eliminated with its parent block (or
+	// at the end, for the roots)
+	for (size_t i = 0; i < blocks.size(); i++)
+		offset[i + 1] = offset[i] + blocks[i].vertices.size() - 1;
+
+	for (size_t i = 0; i < roots.size(); i++)
+		order[offset.back() + i] = snap.vertices[roots[i]];
+
+	// Largest blocks first, for load balancing
+	std::iota(by_size.begin(), by_size.end(), 0);
+	std::sort(by_size.begin(), by_size.end(), [&blocks](size_t a, size_t b) {
+		return blocks[a].vertices.size() > blocks[b].vertices.size();
+	});
+
+	AA_PROBE2(block_lex_m_split, blocks.size(), blocks.empty() ? 0 : blocks[by_size[0]].vertices.size());
+
+	parallel_tasks(blocks.size(), n_threads, [&](unsigned, size_t i) {
+		const GraphBlock &b = blocks[by_size[i]];
+		auto out = order.begin() + offset[by_size[i]];
+
+		// Bridges need no ordering
+		if (b.vertices.size() == 2) {
+			*out = snap.vertices[b.vertices[0]];
+			return;
+		}
+
+		const auto sub = make_csr_graph<Index>(b.vertices.size(), b.edges);
+		const auto sub_order = lex_m(sub, Index(b.vertices.size() - 1));
+
+		AA_PROBE2(block_lex_m_block, b.vertices.size(), b.edges.size());
+
+		for (size_t j = 0; j + 1 < sub_order.size(); j++)
+			*out++ = snap.vertices[b.vertices[sub_order[j]]];
+	});
+
+	AA_PROBE2(block_lex_m_return, n_vertices, blocks.size());
+	return order;
+}
+
+#endif // ALGO_BLOCK_ORDER_H
@@ -0,0 +1,157 @@
+/**
+ * Maximal chordal subgraphs, as needed to build fill-free preconditioners,
+ * computed with the algorithm by Dearing, Shier & Warner in "Maximal chordal
+ * subgraphs" (Discrete Applied Mathematics, 1988).
+ */
+
+#ifndef ALGO_CHORDAL_SUBGRAPH_H
+#define ALGO_CHORDAL_SUBGRAPH_H
+
+#include <limits>
+#include <tuple>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cassert>
+#include <boost/graph/graph_concepts.hpp>
+
+#include "utils.h"
+#include "csr_graph.h"
+#include "vertex_map.h"
+#include "probes.h"
+
+/**
+ * Chordal subgraph of a graph on all its vertices, along with a perfect
+ * elimination order for it.
+ */
+template <class Graph>
+struct ChordalSubgraph {
+	// Kept edges, with the vertices numbered in elimination order, so that
+	// 0, 1, ..., V - 1 is a perfect elimination order of this graph
+	CsrGraph<> graph;
+	// Original vertex corresponding to each vertex of the subgraph, i.e. the
+	// perfect elimination order of the subgraph
+	VertexOrder<Graph> vertices;
+};
+
+/**
+ * Compute a maximal chordal subgraph of a graph, i.e. a chordal subgraph on all
+ * its vertices such that adding any other edge of the graph to it makes it non
+ * chordal.
+ *
+ * Vertices are numbered as in maximum cardinality search, keeping for each
+ * unnumbered vertex w the set C(w) of numbered neighbors connected to it in the
+ * subgraph: the next vertex v is one with the largest C(v), and the edge v--w
+ * is kept for each unnumbered neighbor w with C(w) included in C(v), so that
+ * C(v) + v stays a clique of the subgraph. The reverse of the numbering is thus
+ * a perfect elimination order of the subgraph. Checking the inclusions takes
+ * O(ω) time per edge, where ω is the size of the largest clique of the
+ * subgraph, hence O(V + E ω) time overall, and O(V + E) memory.
+ *
+ * @param  g graph
+ * @return the subgraph along with its perfect elimination order
+ *
+ * Probes: maximal_chordal_subgraph_entry(V, E) and
+ * maximal_chordal_subgraph_return(V, kept edges).
+ *
+ * @pre `g` is a simple, undirected graph; `g` has less than 2^32 - 1 vertices
+ */
+template <class Graph>
+ChordalSubgraph<Graph> maximal_chordal_subgraph(const Graph &g) {
+	BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<Graph>));
+	BOOST_CONCEPT_ASSERT((boost::AdjacencyGraphConcept<Graph>));
+
+	typedef unsigned Index;
+
+	constexpr Index none = std::numeric_limits<Index>::max();
+	const auto all = std::make_from_tuple<VertexOrder<Graph>>(vertices(g));
+	const Index n = all.size();
+	VertexStateMap<Graph, Index> index_of(g);
+	// Unnumbered vertices in doubly linked lists by size of C
+	std::vector<Index> head(n + 1, none), prev(n), next(n);
+	std::vector<Index> number(n, none), mark(n, none);
+	std::vector<std::vector<Index>> chosen(n);
+	std::vector<std::pair<Index, Index>> edges;
+	ChordalSubgraph<Graph> res;
+
+	assert(all.size() < none);
+
+	AA_PROBE2(maximal_chordal_subgraph_entry, n, num_edges(g));
+
+	auto insert = [&](Index v, Index size) {
+		prev[v] = none;
+		next[v] = head[size];
+
+		if (head[size] != none)
+			prev[head[size]] = v;
+
+		head[size] = v;
+	};
+
+	auto erase = [&](Index v, Index size) {
+		if (prev[v] != none)
+			next[prev[v]] = next[v];
+		else
+			head[size] = next[v];
+
+		if (next[v] != none)
+			prev[next[v]] = prev[v];
+	};
+
+	for (Index i = 0; i < n; i++)
+		index_of[all[i]] = i;
+
+	// Insert in reverse, so that ties are broken by position in vertices(g)
+	for (Index i = n; i-- > 0;)
+		insert(i, 0);
+
+	for (Index k = 0, max = 0; k < n; k++) {
+		while (head[max] == none)
+			max--;
+
+		const Index v = head[max];
+
+		erase(v, max);
+		number[v] = k;
+
+		for (const auto u : chosen[v])
+			mark[u] = v;
+
+		for (const auto x : iter_neighbors(g, all[v])) {
+			const Index w = index_of[x];
+
+			if (number[w] != none)
+				continue;
+
+			if (std::all_of(chosen[w].begin(), chosen[w].end(), [&](Index u) { return mark[u] == v; })) {
+				const Index size = chosen[w].size();
+
+				erase(w, size);
+				insert(w, size + 1);
+				chosen[w].push_back(v);
+
+				if (size + 1 > max)
+					max = size + 1;
+			}
+		}
+	}
+
+	// The vertex numbered k is eliminated (n - 1 - k)-th
+	res.vertices.resize(n);
+
+	for (Index v = 0; v < n; v++) {
+		res.vertices[n - 1 - number[v]] = all[v];
+
+		for (const auto u : chosen[v])
+			edges.emplace_back(n - 1 - number[v], n - 1 - number[u]);
+
+		std::vector<Index>().swap(chosen[v]);
+	}
+
+	res.graph = make_csr_graph(n, edges);
+
+	AA_PROBE2(maximal_chordal_subgraph_return, n, edges.size());
+	return res;
+}
+
+#endif // ALGO_CHORDAL_SUBGRAPH_H
@@ -0,0 +1,242 @@
+/**
+ * Clique trees of chordal completions, and merging of their cliques to reduce
+ * the number of blocks of chordal decompositions (e.g. of the matrix cones in
+ * conic optimization). Clique trees are computed from elimination orders as
+ * described by Blair & Peyton in "An introduction to chordal graphs and clique
+ * trees".
+ */
+
+#ifndef ALGO_CLIQUE_TREE_H
+#define ALGO_CLIQUE_TREE_H
+
+#include <limits>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <boost/graph/graph_concepts.hpp>
+
+#include "utils.h"
+#include "fill.h"
+#include "sorted_set.h"
+#include "probes.h"
+
+/**
+ * Clique tree of a chordal graph: its nodes are the maximal cliques of the
+ * graph, and the cliques containing any vertex form a subtree (the running
+ * intersection property), so that the intersection of a clique with any of
+ * its ancestors is contained in its overlap with its parent. Vertices are
+ * identified by their position in an elimination order.
+ *
+ * Each clique comes after all its descendants.
+ */
+struct CliqueTree {
+	static constexpr unsigned none = std::numeric_limits<unsigned>::max();
+
+	// Sorted vertices of each clique
+	std::vector<std::vector<uint32_t>> cliques;
+	// Sorted vertices of each clique shared with its parent
+	std::vector<std::vector<uint32_t>> overlaps;
+	// Parent of each clique, or none for roots
+	std::vector<unsigned> parent;
+};
+
+/**
+ * Compute the clique tree of the chordal completion of an ordered graph, i.e.
+ * of the graph filled by fill() (or of the graph itself, if the order is a
+ * perfect elimination order), without computing the completion itself.
+ *
+ * The successors of each vertex v in the filled graph are computed as in
+ * fill(): v + succ(v) is a clique, which is maximal unless v is the closest
+ * successor of some u with one more successor than v, in which case the clique
+ * of u contains it. Merging these chains of vertices gives the maximal cliques,
+ * each with parent the clique of the closest successor of its last vertex.
+ *
+ * @param  g     graph
+ * @param  order elimination order
+ * @return the clique tree, a forest if `g` is not connected
+ *
+ * @pre `g` is a simple, undirected graph; `order` is an ordered sequence of the
+ *      vertices of `g`; `g` has less than 2^32 - 1 vertices
+ */
+template <class Graph>
+CliqueTree make_clique_tree(const Graph &g, const VertexOrder<Graph> &order) {
+	BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<Graph>));
+	BOOST_CONCEPT_ASSERT((boost::AdjacencyGraphConcept<Graph>));
+
+	constexpr unsigned none = CliqueTree::none;
+	const uint32_t n = order.size();
+	auto succ = successor_lists(g, order);
+	std::vector<uint32_t> deficiency, merged;
+	// Chain of vertices of each open clique, and open clique of each vertex
+	std::vector<std::vector<uint32_t>> chains;
+	std::vector<unsigned> chain_of(n, none);
+	// Clique of each chain once closed, and closest successor of its last
+	// vertex
+	std::vector<unsigned> closed, parent_vertex;
+	CliqueTree tree;
+
+	assert(order.size() < none);
+
+	// Successors in the filled graph, as in fill()
+	for (auto &s : succ) {
+		if (s.size() < 2)
+			continue;
+
+		auto &closest = succ[s.front()];
+
+		deficiency.resize(s.size() - 1);
+		deficiency.resize(sorted_difference(s.data() + 1, s.data() + s.size(),
+			closest.data(), closest.data() + closest.size(), deficiency.data()) - deficiency.data());
+
+		if (!deficiency.empty()) {
+			merged.resize(closest.size() + deficiency.size());
+			sorted_merge(closest.data(), closest.data() + closest.size(),
+				deficiency.data(), deficiency.data() + deficiency.size(), merged.data());
+			closest.swap(merged);
+		}
+	}
+
+	for (uint32_t v = 0; v < n; v++) {
+		if (chain_of[v] == none) {
+			chain_of[v] = chains.size();
+			chains.emplace_back();
+			closed.push_back(none);
+		}
+
+		const unsigned c = chain_of[v];
+		const auto &s = succ[v];
+
+		chains[c].push_back(v);
+
+		// The clique continues with the closest successor, unless another
+		// chain already did
+		if (!s.empty() && chain_of[s.front()] == none && s.size() == succ[s.front()].size() + 1) {
+			chain_of[s.front()] = c;
+			continue;
+		}
+
+		// The chain precedes its successors, and so does the clique
+		auto &clique = chains[c];
+
+		clique.insert(clique.end(), s.begin(), s.end());
+		closed[c] = tree.cliques.size();
+		parent_vertex.push_back(s.empty() ? none : s.front());
+		tree.cliques.push_back(std::move(clique));
+		tree.overlaps.push_back(s);
+		std::vector<uint32_t>().swap(clique);
+	}
+
+	// The chain of the parent vertex is closed after the one of its child
+	for (const auto p : parent_vertex)
+		tree.parent.push_back(p == none ? none : closed[chain_of[p]]);
+
+	return tree;
+}
+
+/**
+ * Cost model of a chordal decomposition, used to merge cliques: each block of
+ * size n costs n³ (e.g. an eigendecomposition in each iteration of a conic
+ * solver) plus a fixed overhead, and each overlap of size s between a block
+ * and its parent costs its number of entries, s(s + 1) / 2, times a weight
+ * (e.g. for the consensus constraints coupling the blocks).
+ */
+struct CliqueMergeCost {
+	double block_overhead = 0;
+	double overlap_weight = 1;
+
+	double block(size_t n) const {
+		return double(n) * n * n + block_overhead;
+	}
+
+	double overlap(size_t s) const {
+		return overlap_weight * s * (s + 1) / 2;
+	}
+};
+
+/**
+ * Merge cliques of a clique tree into their parents while this decreases the
+ * cost of the decomposition: visiting the tree bottom-up, each clique C with
+ * parent P and overlap S is merged iff
+ *
+ *     block(|P| + |C| - |S|) < block(|P|) + block(|C|) + overlap(|S|),
+ *
+ * in which case P becomes P + C, and the children of C become children of P
+ * with the same overlaps. The result is still a tree of cliques with the
+ * running intersection property, though no longer of maximal cliques of the
+ * original graph (but of a chordal graph containing it).
+ *
+ * @param tree clique tree, merged in place, with each clique still after its
+ *             descendants
+ * @param cost cost model
+ *
+ * Probes: merge_cliques_entry(cliques) and merge_cliques_return(cliques).
+ */
+inline void merge_cliques(CliqueTree &tree, const CliqueMergeCost &cost = {}) {
+	constexpr unsigned none = CliqueTree::none;
+	const unsigned n = tree.cliques.size();
+	// Clique each clique was merged into, resolved top-down
+	std::vector<unsigned> merged_into(n, none);
+	std::vector<uint32_t> residual, merged;
+	CliqueTree res;
+
+	AA_PROBE1(merge_cliques_entry, n);
+
+	// The parent of each clique is never merged before it
+	for (unsigned c = 0; c < n; c++) {
+		const unsigned p = tree.parent[c];
+
+		if (p == none)
+			continue;
+
+		auto &child = tree.cliques[c];
+		auto &parent = tree.cliques[p];
+		const auto &overlap = tree.overlaps[c];
+		const size_t size = parent.size() + child.size() - overlap.size();
+
+		if (cost.block(size) >= cost.block(parent.size()) + cost.block(child.size()) + cost.overlap(overlap.size()))
+			continue;
+
+		// By the running intersection property, the child only shares its
+		// overlap with the parent and the cliques merged into it
+		residual.resize(child.size());
+		residual.resize(sorted_difference(child.data(), child.data() + child.size(),
+			overlap.data(), overlap.data() + overlap.size(), residual.data()) - residual.data());
+		merged.resize(size);
+		sorted_merge(parent.data(), parent.data() + parent.size(),
+			residual.data(), residual.data() + residual.size(), merged.data());
+		parent.swap(merged);
+		merged_into[c] = p;
+		std::vector<uint32_t>().swap(child);
+	}
+
+	for (unsigned c = n; c-- > 0;) {
+		if (merged_into[c] != none && merged_into[merged_into[c]] != none)
+			merged_into[c] = merged_into[merged_into[c]];
+	}
+
+	// Renumber the remaining cliques, which keep their order
+	std::vector<unsigned> index(n, none);
+
+	for (unsigned c = 0; c < n; c++) {
+		if (merged_into[c] != none)
+			continue;
+
+		const unsigned p = tree.parent[c];
+
+		index[c] = res.cliques.size();
+		res.cliques.push_back(std::move(tree.cliques[c]));
+		res.overlaps.push_back(std::move(tree.overlaps[c]));
+		res.parent.push_back(p == none || merged_into[p] == none ? p : merged_into[p]);
+	}
+
+	for (auto &p : res.parent) {
+		if (p != none)
+			p = index[p];
+	}
+
+	tree = std::move(res);
+
+	AA_PROBE1(merge_cliques_return, tree.cliques.size());
+}
+
+#endif // ALGO_CLIQUE_TREE_H
@@ -0,0 +1,186 @@
+/**
+ * Implicit column intersection graphs of sparse matrices, i.e. graphs with the
+ * sparsity pattern of AᵀA given the one of A, as needed to order the columns
+ * of A for sparse QR factorization (or for Cholesky factorization of AᵀA).
+ */
+
+#ifndef COLUMN_GRAPH_H
+#define COLUMN_GRAPH_H
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+
+#include "utils.h"
+
+/**
+ * Column intersection graph of a sparse matrix A, modeling the VertexListGraph
+ * and AdjacencyGraph concepts of the Boost Graph Library: its vertices are the
+ * columns of A, adjacent iff they have a nonzero in the same row, so that it
+ * has the sparsity pattern of AᵀA without its diagonal.
+ *
+ * Only the pattern of A is stored, in both row and column major order: the
+ * rows are referenced (and must outlive the graph) and the columns are built
+ * by the constructor, so the graph takes O(nnz(A)) memory, whereas AᵀA can
+ * have up to the sum of the squared row sizes of A nonzeros. The neighbors of
+ * a column are computed by adjacent_vertices() and degree() merging the rows
+ * of the column, and shared by the iterators, so only a few neighborhoods are
+ * in memory at any time. Vertices are their own indices.
+ */
+template <class Index = unsigned, class Offset = std::size_t>
+class ColumnIntersectionGraph {
+public:
+	class adjacency_iterator;
+
+	typedef Index vertex_descriptor;
+	typedef std::pair<Index, Index> edge_descriptor;
+	typedef boost::undirected_tag directed_category;
+	typedef boost::disallow_parallel_edge_tag edge_parallel_category;
+	typedef boost::counting_iterator<Index> vertex_iterator;
+	typedef Index vertices_size_type;
+	typedef Offset edges_size_type;
+	typedef Offset degree_size_type;
+
+	struct traversal_category :
+		virtual boost::vertex_list_graph_tag,
+		virtual boost::adjacency_graph_tag {};
+
+	static_assert(!std::numeric_limits<Index>::is_signed);
+
+	/**
+	 * @param n_rows  number of rows of A
+	 * @param n_cols  number of columns of A
+	 * @param row_ptr array of n_rows + 1 offsets of the columns of the
+	 *                nonzeros of each row in `col_ind`
+	 * @param col_ind columns of the nonzeros of all the rows, one row after
+	 *                the other
+	 *
+	 * @pre no row contains a column twice
+	 */
+	ColumnIntersectionGraph(Index n_rows, Index n_cols, const Offset *row_ptr, const Index *col_ind)
+		: n_rows_(n_rows), n_cols_(n_cols), row_ptr_(row_ptr), col_ind_(col_ind), col_ptr_(n_cols + 1, 0),
+		  row_ind_(row_ptr[n_rows]), n_edges_(0)
+	{
+		for (Offset p = 0; p < row_ptr[n_rows]; p++)
+			col_ptr_[col_ind[p] + 1]++;
+
+		for (Index c = 0; c < n_cols; c++)
+			col_ptr_[c + 1] += col_ptr_[c];
+
+		std::vector<Offset> next(col_ptr_.begin(), col_ptr_.end() - 1);
+
+		for (Index r = 0; r < n_rows; r++) {
+			for (Offset p = row_ptr[r]; p < row_ptr[r + 1]; p++)
+				row_ind_[next[col_ind[p]]++] = r;
+		}
+
+		for (Index c = 0; c < n_cols; c++)
+			n_edges_ += neighbors(c).size();
+
+		n_edges_ /= 2;
+	}
+
+	Index n_rows() const { return n_rows_; }
+	Index n_cols() const { return n_cols_; }
+	const Offset *row_ptr() const { return row_ptr_; }
+	const Index *col_ind() const { return col_ind_; }
+
+	/**
+	 * @return the sorted neighbors of a column
+	 */
+	std::vector<Index> neighbors(Index c) const {
+		std::vector<Index> res;
+
+		for (Offset p = col_ptr_[c]; p < col_ptr_[c + 1]; p++) {
+			const Index r = row_ind_[p];
+			res.insert(res.end(), col_ind_ + row_ptr_[r], col_ind_ + row_ptr_[r + 1]);
+		}
+
+		if (res.empty())
+			return res;
+
+		// c is in all its rows
+		std::sort(res.begin(), res.end());
+		res.erase(std::unique(res.begin(), res.end()), res.end());
+		res.erase(std::lower_bound(res.begin(), res.end(), c));
+		return res;
+	}
+
+	/**
+	 * Iterator over the neighbors of a column, owning them along with its
+	 * copies.
+	 */
+	class adjacency_iterator : public boost::iterator_facade<adjacency_iterator, Index,
+		boost::random_access_traversal_tag, Index>
+	{
+	public:
+		adjacency_iterator() : pos_(0) {}
+
+		adjacency_iterator(std::shared_ptr<const std::vector<Index>> neighbors, size_t pos)
+			: neighbors_(std::move(neighbors)), pos_(pos) {}
+
+	private:
+		friend class boost::iterator_core_access;
+
+		Index dereference() const { return (*neighbors_)[pos_]; }
+		bool equal(const adjacency_iterator &other) const { return pos_ == other.pos_; }
+		void increment() { pos_++; }
+		void decrement() { pos_--; }
+		void advance(std::ptrdiff_t n) { pos_ += n; }
+		std::ptrdiff_t distance_to(const adjacency_iterator &other) const { return other.pos_ - pos_; }
+
+		std::shared_ptr<const std::vector<Index>> neighbors_;
+		size_t pos_;
+	};
+
+	static vertex_descriptor null_vertex() {
+		return std::numeric_limits<Index>::max();
+	}
+
+	friend Index num_vertices(const ColumnIntersectionGraph &g) {
+		return g.n_cols_;
+	}
+
+	friend Offset num_edges(const ColumnIntersectionGraph &g) {
+		return g.n_edges_;
+	}
+
+	friend std::pair<vertex_iterator, vertex_iterator> vertices(const ColumnIntersectionGraph &g) {
+		return {vertex_iterator(0), vertex_iterator(g.n_cols_)};
+	}
+
+	friend std::pair<adjacency_iterator, adjacency_iterator> adjacent_vertices(Index c, const ColumnIntersectionGraph &g) {
+		auto neighbors = std::make_shared<const std::vector<Index>>(g.neighbors(c));
+		const size_t n = neighbors->size();
+
+		return {adjacency_iterator(neighbors, 0), adjacency_iterator(neighbors, n)};
+	}
+
+	friend Offset degree(Index c, const ColumnIntersectionGraph &g) {
+		return g.neighbors(c).size();
+	}
+
+	// Vertices are their own indices
+	friend boost::typed_identity_property_map<Index> get(boost::vertex_index_t, const ColumnIntersectionGraph &) {
+		return {};
+	}
+
+private:
+	Index n_rows_;
+	Index n_cols_;
+	const Offset *row_ptr_;
+	const Index *col_ind_;
+	std::vector<Offset> col_ptr_;
+	std::vector<Index> row_ind_;
+	Offset n_edges_;
+};
+
+#endif // COLUMN_GRAPH_H
@@ -0,0 +1,83 @@
+/**
+ * Column orders of sparse matrices for QR factorization, computed on the
+ * column intersection graph without forming it.
+ */
+
+#ifndef ALGO_COLUMN_ORDER_H
+#define ALGO_COLUMN_ORDER_H
+
+#include <vector>
+#include <cassert>
+#include <type_traits>
+
+#include "utils.h"
+#include "column_graph.h"
+#include "min_degree.h"
+#include "quotient_graph.h"
+
+/**
+ * Helper function: create the quotient graph of a column intersection graph,
+ * with the rows as initial elements. The column indices of A are used in
+ * place, without copying them, so they must have the index type of the
+ * quotient graph.
+ */
+template <class Index, class Offset>
+QuotientGraph column_quotient_graph(const ColumnIntersectionGraph<Index, Offset> &g) {
+	static_assert(std::is_same_v<Index, QuotientGraph::Index>,
+		"column orders need column indices of type QuotientGraph::Index (unsigned)");
+
+	return QuotientGraph(g.n_cols(), g.n_rows(), g.row_ptr(), g.col_ind());
+}
+
+/**
+ * Compute a minimum degree column order of a sparse matrix A, i.e. a minimum
+ * degree order of the graph of AᵀA (see minimum_degree_order()), eliminating
+ * on the quotient graph whose initial elements are the rows of A, so memory
+ * stays O(nnz(A)) (plus O(1) per row and column) instead of O(nnz(AᵀA)).
+ *
+ * @param  g column intersection graph of A
+ * @return the columns of A in elimination order
+ *
+ * Probes: see minimum_degree_elimination().
+ */
+template <class Index, class Offset>
+VertexOrder<ColumnIntersectionGraph<Index, Offset>> column_minimum_degree_order(const ColumnIntersectionGraph<Index, Offset> &g) {
+	auto q = column_quotient_graph(g);
+	VertexOrder<ColumnIntersectionGraph<Index, Offset>> order;
+
+	order.reserve(g.n_cols());
+
+	for (const auto v : minimum_degree_elimination(q))
+		order.push_back(v);
+
+	return order;
+}
+
+/**
+ * Count the fill-in edges of the graph of AᵀA for a column order of A, i.e.
+ * the off-diagonal entries of the R factor of AP that are not entries of AᵀA,
+ * in memory O(nnz(A)) (see fill_in_count() for general graphs).
+ *
+ * @param  g     column intersection graph of A
+ * @param  order elimination order of the columns
+ * @return the number of fill-in edges
+ *
+ * @pre `order` is an ordered sequence of the columns
+ */
+template <class Index, class Offset>
+size_t column_fill_in_count(const ColumnIntersectionGraph<Index, Offset> &g,
+	const VertexOrder<ColumnIntersectionGraph<Index, Offset>> &order)
+{
+	auto q = column_quotient_graph(g);
+	size_t n_entries = 0;
+
+	assert(order.size() == g.n_cols());
+
+	// The neighbors at elimination are the entries of the row of R
+	for (const auto v : order)
+		n_entries += q.eliminate(v).size();
+
+	return n_entries - num_edges(g);
+}
+
+#endif // ALGO_COLUMN_ORDER_H
@@ -0,0 +1,297 @@
+/**
+ * Compact immutable graphs in compressed sparse row (CSR) format.
+ */
+
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <cassert>
+#include <algorithm>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+
+#include "utils.h"
+#include "vertex_map.h"
+
+/**
+ * Common implementation of simple, undirected graphs stored in compressed
+ * sparse row format, modeling the VertexListGraph and AdjacencyGraph concepts
+ * of the Boost Graph Library.
+ *
+ * Vertices are the integers in [0, num_vertices(g)) and the neighbors of vertex
+ * v are the elements of the targets array in the range [offsets[v],
+ * offsets[v + 1]). Since the graph is undirected, each edge v--w appears twice:
+ * once as a neighbor of v and once as a neighbor of w.
+ *
+ * Derived classes provide the arrays through the offsets_data(),
+ * targets_data() and n_vertices() member functions.
+ */
+template <class Derived, class Index, class Offset>
+class CsrGraphBase {
+public:
+	typedef Index vertex_descriptor;
+	typedef std::pair<Index, Index> edge_descriptor;
+	typedef boost::undirected_tag directed_category;
+	typedef boost::disallow_parallel_edge_tag edge_parallel_category;
+	typedef boost::counting_iterator<Index> vertex_iterator;
+	typedef const Index *adjacency_iterator;
+	typedef Index vertices_size_type;
+	typedef Offset edges_size_type;
+	typedef Offset degree_size_type;
+
+	struct traversal_category :
+		virtual boost::vertex_list_graph_tag,
+		virtual boost::adjacency_graph_tag {};
+
+	static_assert(!std::numeric_limits<Index>::is_signed);
+
+	static vertex_descriptor null_vertex() {
+		return std::numeric_limits<Index>::max();
+	}
+
+	friend Index num_vertices(const Derived &g) {
+		return g.n_vertices();
+	}
+
+	friend Offset num_edges(const Derived &g) {
+		return g.offsets_data()[g.n_vertices()] / 2;
+	}
+
+	friend std::pair<vertex_iterator, vertex_iterator> vertices(const Derived &g) {
+		return {vertex_iterator(0), vertex_iterator(g.n_vertices())};
+	}
+
+	friend std::pair<adjacency_iterator, adjacency_iterator> adjacent_vertices(Index v, const Derived &g) {
+		const Offset *o = g.offsets_data();
+		const Index *t = g.targets_data();
+		return {t + o[v], t + o[v + 1]};
+	}
+
+	friend Offset degree(Index v, const Derived &g) {
+		const Offset *o = g.offsets_data();
+		return o[v + 1] - o[v];
+	}
+
+	// Vertices are their own indices
+	friend boost::typed_identity_property_map<Index> get(boost::vertex_index_t, const Derived &) {
+		return {};
+	}
+};
+
+/**
+ * Graph in compressed sparse row format owning its arrays.
+ */
+template <class Index = unsigned, class Offset = std::size_t>
+class CsrGraph : public CsrGraphBase<CsrGraph<Index, Offset>, Index, Offset> {
+public:
+	CsrGraph() : offsets_(1, 0) {}
+
+	/**
+	 * @param offsets offsets of the neighbors of each vertex in `targets`,
+	 *                followed by the total number of entries of `targets`
+	 * @param targets neighbors of all the vertices, one vertex after the other
+	 *
+	 * @pre `offsets` is non-empty and non-decreasing, offsets.back() equals
+	 *      targets.size(); each edge appears in both directions
+	 */
+	CsrGraph(std::vector<Offset> offsets, std::vector<Index> targets)
+		: offsets_(std::move(offsets)), targets_(std::move(targets))
+	{
+		assert(!offsets_.empty() && offsets_.back() == targets_.size());
+	}
+
+	const std::vector<Offset> &offsets() const { return offsets_; }
+	const std::vector<Index> &targets() const { return targets_; }
+
+	Index n_vertices() const { return offsets_.size() - 1; }
+	const Offset *offsets_data() const { return offsets_.data(); }
+	const Index *targets_data() const { return targets_.data(); }
+
+	/**
+	 * @return the number of bytes allocated by the graph
+	 */
+	size_t memory() const {
+		return offsets_.capacity() * sizeof(Offset) + targets_.capacity() * sizeof(Index);
+	}
+
+private:
+	std::vector<Offset> offsets_;
+	std::vector<Index> targets_;
+};
+
+/**
+ * Graph in compressed sparse row format referencing arrays owned by someone
+ * else, which must outlive the view. No copy of the arrays is ever made.
+ */
+template <class Index = unsigned, class Offset = std::size_t>
+class CsrGraphView : public CsrGraphBase<CsrGraphView<Index, Offset>, Index, Offset> {
+public:
+	CsrGraphView() : n_(0), offsets_(&zero_), targets_(nullptr) {}
+
+	/**
+	 * @param n_vertices number of vertices of the graph
+	 * @param offsets    array of n_vertices + 1 offsets of the neighbors of
+	 *                   each vertex in `targets`
+	 * @param targets    neighbors of all the vertices, one vertex after the
+	 *                   other
+	 *
+	 * @pre same as for CsrGraph
+	 */
+	CsrGraphView(Index n_vertices, const Offset *offsets, const Index *targets)
+		: n_(n_vertices), offsets_(offsets), targets_(targets) {}
+
+	CsrGraphView(const CsrGraph<Index, Offset> &g)
+		: n_(g.n_vertices()), offsets_(g.offsets_data()), targets_(g.targets_data()) {}
+
+	Index n_vertices() const { return n_; }
+	const Offset *offsets_data() const { return offsets_; }
+	const Index *targets_data() const { return targets_; }
+
+private:
+	static constexpr Offset zero_ = 0;
+
+	Index n_;
+	const Offset *offsets_;
+	const Index *targets_;
+};
+
+/**
+ * Build a CsrGraph from a list of edges, ignoring self-loops and duplicate
+ * edges. Each edge only needs to be listed in one direction.
+ *
+ * @param  n_vertices number of vertices of the graph
+ * @param  edges      list of edges of the graph
+ * @return the graph
+ *
+ * @pre all the vertices of the edges are in [0, n_vertices)
+ */
+template <class Index>
+CsrGraph<Index> make_csr_graph(Index n_vertices, const std::vector<std::pair<Index, Index>> &edges) {
+	typedef typename CsrGraph<Index>::edges_size_type Offset;
+
+	std::vector<Offset> offsets(n_vertices + 1);
+	std::vector<Index> targets;
+
+	// Count the neighbors of each vertex, then place them
+	for (const auto &[a, b] : edges) {
+		if (a != b) {
+			offsets[a + 1]++;
+			offsets[b + 1]++;
+		}
+	}
+
+	for (Index v = 0; v < n_vertices; v++)
+		offsets[v + 1] += offsets[v];
+
+	std::vector<Offset> next(offsets.begin(), offsets.end() - 1);
+	targets.resize(offsets.back());
+
+	for (const auto &[a, b] : edges) {
+		if (a != b) {
+			targets[next[a]++] = b;
+			targets[next[b]++] = a;
+		}
+	}
+
+	// Sort and remove duplicates, compacting the targets in place
+	Offset out = 0;
+
+	for (Index v = 0; v < n_vertices; v++) {
+		const auto begin = targets.begin() + offsets[v];
+		const auto end   = targets.begin() + offsets[v + 1];
+
+		std::sort(begin, end);
+		const auto last = std::unique(begin, end);
+
+		offsets[v] = out;
+		out = std::copy(begin, last, targets.begin() + out) - targets.begin();
+	}
+
+	offsets[n_vertices] = out;
+	targets.resize(out);
+	return CsrGraph<Index>(std::move(offsets), std::move(targets));
+}
+
+/**
+ * Build the subgraph of a CsrGraph induced by a subset of its vertices, in
+ * O(V + degrees of the subset).
+ *
+ * @param  g      graph
+ * @param  subset sequence of (distinct) vertices of the graph
+ * @return the induced subgraph, where vertex i corresponds to subset[i]
+ */
+template <class Index, class Offset>
+CsrGraph<Index, Offset> make_induced_csr_graph(const CsrGraph<Index, Offset> &g, const std::vector<Index> &subset) {
+	const Index none = std::numeric_limits<Index>::max();
+	// Vertex of the subgraph corresponding to each vertex of the graph, if any
+	std::vector<Index> local(num_vertices(g), none);
+	std::vector<Offset> offsets(1, 0);
+	std::vector<Index> targets;
+
+	for (Index i = 0; i < subset.size(); i++)
+		local[subset[i]] = i;
+
+	for (const auto v : subset) {
+		for (const auto w : iter_neighbors(g, v)) {
+			if (local[w] != none)
+				targets.push_back(local[w]);
+		}
+
+		offsets.push_back(targets.size());
+	}
+
+	return CsrGraph<Index, Offset>(std::move(offsets), std::move(targets));
+}
+
+/**
+ * Copy of a graph in compressed sparse row format, along with the mapping of
+ * its vertices to the vertices of the original graph.
+ */
+template <class Graph>
+struct CsrSnapshot {
+	CsrGraph<> graph;
+	// Original vertex corresponding to each vertex of the compressed graph
+	VertexOrder<Graph> vertices;
+};
+
+/**
+ * Take a snapshot of a graph, copying it into a CsrGraph. Vertices are numbered
+ * in the same order in which they are enumerated by vertices(g).
+ *
+ * @param  g graph to copy
+ * @return the snapshot of the graph
+ */
+template <class Graph>
+CsrSnapshot<Graph> make_csr_snapshot(const Graph &g) {
+	typedef typename CsrGraph<>::vertex_descriptor Index;
+	typedef typename CsrGraph<>::edges_size_type Offset;
+
+	CsrSnapshot<Graph> res;
+	VertexStateMap<Graph, Index> index_of(g);
+	std::vector<Offset> offsets(1, 0);
+	std::vector<Index> targets;
+
+	res.vertices = std::make_from_tuple<VertexOrder<Graph>>(vertices(g));
+
+	for (Index i = 0; i < res.vertices.size(); i++)
+		index_of[res.vertices[i]] = i;
+
+	for (const auto v : res.vertices) {
+		for (const auto w : iter_neighbors(g, v))
+			targets.push_back(index_of[w]);
+
+		offsets.push_back(targets.size());
+	}
+
+	res.graph = CsrGraph<>(std::move(offsets), std::move(targets));
+	return res;
+}
+
+#endif // CSR_GRAPH_H
@@ -0,0 +1,438 @@
+/**
+ * Multi-process computation of elimination orders: the graph is partitioned
+ * with nested dissection and the order of each part is computed by a separate
+ * worker process, exchanging results through shared memory.
+ */
+
+#ifndef ALGO_DISTRIBUTED_ORDER_H
+#define ALGO_DISTRIBUTED_ORDER_H
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <csignal>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <boost/graph/graph_concepts.hpp>
+
+#include "utils.h"
+#include "csr_graph.h"
+#include "lex_m.h"
+#include "probes.h"
+#include "metrics.h"
+
+/**
+ * Nested dissection of a CsrGraph: recursive bisection of the graph with
+ * vertex separators computed from breadth-first level structures.
+ */
+class NestedDissection {
+public:
+	typedef typename CsrGraph<>::vertex_descriptor Index;
+
+	/**
+	 * Sets of vertices of the graph in elimination order: the parts (leaves of
+	 * the dissection tree) and the separators, in post-order.
+	 */
+	struct Block {
+		std::vector<Index> vertices;
+		bool is_separator;
+	};
+
+	NestedDissection(const CsrGraph<> &g)
+		: g_(g), mark_(num_vertices(g)), visit_(num_vertices(g)), level_(num_vertices(g)) {}
+
+	/**
+	 * Dissect the graph down to the given depth, i.e. into 2^depth parts.
+	 *
+	 * @return the parts and the separators of the graph in post-order, which
+	 *         is a valid elimination order of the blocks
+	 */
+	std::vector<Block> run(unsigned depth) {
+		std::vector<Block> blocks;
+		std::vector<Index> all(num_vertices(g_));
+
+		for (Index v = 0; v < all.size(); v++)
+			all[v] = v;
+
+		dissect(all, depth, blocks);
+		return blocks;
+	}
+
+	/**
+	 * Split a set of vertices into two sets not adjacent to each other and a
+	 * separator. If the subgraph induced by the set is disconnected, its
+	 * connected components are split into two sets with an empty separator.
+	 * Otherwise, the separator is made of the vertices of the median level of
+	 * a level structure rooted at a pseudo-peripheral vertex which are adjacent
+	 * to the next level.
+	 */
+	void bisect(const std::vector<Index> &set, std::vector<Index> &a, std::vector<Index> &b,
+			std::vector<Index> &sep) {
+		a.clear();
+		b.clear();
+		sep.clear();
+
+		if (set.size() < 2) {
+			a = set;
+			return;
+		}
+
+		cur_mark_++;
+
+		for (const auto v : set)
+			mark_[v] = cur_mark_;
+
+		// Find a pseudo-peripheral vertex as the farthest from any vertex
+		std::vector<Index> levels = bfs(set.front());
+		levels = bfs(levels.back());
+
+		if (levels.size() < set.size()) {
+			split_components(set, a, b);
+			return;
+		}
+
+		// Find the median level, leaving at least one level after it
+		const Index n_levels = level_[levels.back()] + 1;
+		std::vector<size_t> level_size(n_levels);
+		Index median = 0;
+
+		for (const auto v : levels)
+			level_size[level_[v]]++;
+
+		for (size_t below = level_size[0]; 2 * below < set.size() && median + 2 < n_levels; )
+			below += level_size[++median];
+
+		for (const auto v : levels) {
+			const Index l = level_[v];
+
+			if (l < median) {
+				a.push_back(v);
+			} else if (l > median) {
+				b.push_back(v);
+			} else {
+				bool adjacent_to_next = false;
+
+				for (const auto w : iter_neighbors(g_, v)) {
+					if (mark_[w] == cur_mark_ && level_[w] == median + 1) {
+						adjacent_to_next = true;
+						break;
+					}
+				}
+
+				(adjacent_to_next ? sep : a).push_back(v);
+			}
+		}
+	}
+
+private:
+	/**
+	 * Breadth-first search from a vertex restricted to the currently marked
+	 * vertices, computing their levels.
+	 *
+	 * @return the reached vertices in BFS order
+	 */
+	std::vector<Index> bfs(Index root) {
+		std::vector<Index> queue{root};
+		const unsigned visit = ++cur_visit_;
+
+		visit_[root] = visit;
+		level_[root] = 0;
+
+		for (size_t i = 0; i < queue.size(); i++) {
+			const auto v = queue[i];
+
+			for (const auto w : iter_neighbors(g_, v)) {
+				if (mark_[w] == cur_mark_ && visit_[w] != visit) {
+					visit_[w] = visit;
+					level_[w] = level_[v] + 1;
+					queue.push_back(w);
+				}
+			}
+		}
+
+		return queue;
+	}
+
+	/**
+	 * Split the (marked) set of vertices into two sets of connected components
+	 * of similar total size.
+	 */
+	void split_components(const std::vector<Index> &set, std::vector<Index> &a, std::vector<Index> &b) {
+		std::vector<std::vector<Index>> components;
+		const unsigned first_visit = cur_visit_ + 1;
+
+		for (const auto v : set) {
+			if (visit_[v] < first_visit)
+				components.push_back(bfs(v));
+		}
+
+		std::sort(components.begin(), components.end(), [](const auto &x, const auto &y) {
+			return x.size() > y.size();
+		});
+
+		for (const auto &c : components) {
+			auto &smaller = a.size() <= b.size() ? a : b;
+			smaller.insert(smaller.end(), c.begin(), c.end());
+		}
+	}
+
+	void dissect(const std::vector<Index> &set, unsigned depth, std::vector<Block> &blocks) {
+		if (depth == 0) {
+			blocks.push_back({set, false});
+			return;
+		}
+
+		std::vector<Index> a, b, sep;
+		bisect(set, a, b, sep);
+
+		dissect(a, depth - 1, blocks);
+		dissect(b, depth - 1, blocks);
+		blocks.push_back({std::move(sep), true});
+	}
+
+	const CsrGraph<> &g_;
+	std::vector<unsigned> mark_;
+	std::vector<unsigned> visit_;
+	std::vector<Index> level_;
+	unsigned cur_mark_ = 0;
+	unsigned cur_visit_ = 0;
+};
+
+/**
+ * Default ordering of the blocks of distributed_order(): lex_m().
+ */
+struct LexMBlockOrder {
+	template <class Graph>
+	VertexOrder<Graph> operator()(const Graph &g) const {
+		return lex_m(g);
+	}
+};
+
+/**
+ * Order the subgraph of a CsrGraph induced by a set of vertices with the given
+ * ordering function, writing the ordered vertices to `out`.
+ */
+template <class BlockOrder>
+void order_block(const CsrGraph<> &g, const std::vector<unsigned> &block, unsigned *out,
+		const BlockOrder &block_order) {
+	if (block.empty())
+		return;
+
+	const auto sub = make_induced_csr_graph(g, block);
+	const auto order = block_order(sub);
+
+	for (size_t i = 0; i < order.size(); i++)
+		out[i] = block[order[i]];
+
+	AA_PROBE2(distributed_order_block, block.size(), num_edges(sub));
+}
+
+/**
+ * Shared memory mapping of distributed_order() and the worker processes
+ * writing to it. Workers still running on destruction (i.e. when unwinding,
+ * as their results are no longer needed) are killed and waited for before the
+ * mapping is released, so that none is left behind.
+ */
+class WorkerMapping {
+public:
+	/**
+	 * Map `size` bytes of anonymous shared memory, unless not `shared`.
+	 */
+	WorkerMapping(size_t size, bool shared)
+		: data_(shared ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0)
+			: MAP_FAILED),
+		  size_(size) {}
+
+	WorkerMapping(const WorkerMapping &) = delete;
+	WorkerMapping &operator=(const WorkerMapping &) = delete;
+
+	~WorkerMapping() {
+		for (const pid_t pid : workers_) {
+			if (pid > 0) {
+				kill(pid, SIGKILL);
+				wait_for(pid);
+			}
+		}
+
+		if (data_ != MAP_FAILED)
+			munmap(data_, size_);
+	}
+
+	/**
+	 * @return the mapping, or MAP_FAILED if not available
+	 */
+	void *data() const { return data_; }
+
+	/**
+	 * Record a started worker, to be waited for with wait().
+	 */
+	void add(pid_t pid) { workers_.push_back(pid); }
+
+	/**
+	 * Wait for the k-th worker recorded, if it was started.
+	 *
+	 * @return true/false whether it exited successfully
+	 */
+	bool wait(size_t k) {
+		const pid_t pid = workers_[k];
+
+		workers_[k] = -1;
+		return pid > 0 && wait_for(pid);
+	}
+
+private:
+	static bool wait_for(pid_t pid) {
+		int status = 0;
+		pid_t res;
+
+		do {
+			res = waitpid(pid, &status, 0);
+		} while (res == -1 && errno == EINTR);
+
+		return res == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+	}
+
+	void *data_;
+	size_t size_;
+	std::vector<pid_t> workers_;
+};
+
+/**
+ * Compute an elimination order for the given graph using multiple worker
+ * processes. The graph is split with nested dissection into (at least)
+ * `n_workers` parts, each of which is ordered with `block_order` (lex_m() by
+ * default) by a worker process forked from the calling one, while the
+ * separators are ordered by the calling process. Vertices of each part come
+ * before the ones of the separators that split it off from the rest of the
+ * graph.
+ *
+ * Workers write their results directly into an anonymous shared memory mapping.
+ * If a worker cannot be started or does not terminate successfully, its parts
+ * are ordered again by the calling process, so that a failing worker does not
+ * affect the result.
+ *
+ * Only the ordering work is distributed, not the memory: the calling process
+ * holds the whole graph and a CSR snapshot of it, which the workers share
+ * copy-on-write, so the graph must fit in the memory of a single machine.
+ *
+ * @param  g            graph to compute the order for
+ * @param  n_workers    number of parts to order in parallel
+ * @param  fork_workers whether to order the parts in worker processes, or
+ *                      else in the calling process (giving the same order),
+ *                      e.g. if it is multithreaded
+ * @param  block_order  function returning an elimination order of a CsrGraph,
+ *                      used for the parts and the separators
+ * @return an elimination order for the graph as an ordered sequence of all its
+ *         vertices
+ *
+ * Probes: distributed_order_entry(V, E), distributed_order_dissect(blocks,
+ * parts), distributed_order_block(V, E) for each block ordered,
+ * distributed_order_batch(worker, parts) for the parts of each worker (in the
+ * worker, or in the calling process if the worker failed), and
+ * distributed_order_return(V, failed workers).
+ *
+ * @pre `g` is a simple, connected, undirected graph; if `fork_workers`, the
+ *      calling process is single-threaded (as it uses fork())
+ */
+template <class Graph, class BlockOrder = LexMBlockOrder>
+VertexOrder<Graph> distributed_order(const Graph &g, unsigned n_workers, bool fork_workers = true,
+		const BlockOrder &block_order = BlockOrder()) {
+	typedef NestedDissection::Block Block;
+
+	BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<Graph>));
+	BOOST_CONCEPT_ASSERT((boost::AdjacencyGraphConcept<Graph>));
+	AA_METRICS_CALL(distributed_order, num_vertices(g), num_edges(g));
+
+	const auto snap = make_csr_snapshot(g);
+	const auto n_vertices = snap.vertices.size();
+	unsigned depth = 0;
+	unsigned n_failed = 0;
+
+	AA_PROBE2(distributed_order_entry, n_vertices, num_edges(snap.graph));
+
+	assert(n_workers > 0);
+
+	while ((1U << depth) < n_workers)
+		depth++;
+
+	const std::vector<Block> blocks = NestedDissection(snap.graph).run(depth);
+	std::vector<size_t> offset(blocks.size() + 1);
+	std::vector<size_t> parts;
+
+	for (size_t i = 0; i < blocks.size(); i++) {
+		offset[i + 1] = offset[i] + blocks[i].vertices.size();
+
+		if (!blocks[i].is_separator)
+			parts.push_back(i);
+	}
+
+	AA_PROBE2(distributed_order_dissect, blocks.size(), parts.size());
+
+	WorkerMapping shm(std::max<size_t>(n_vertices, 1) * sizeof(unsigned), fork_workers);
+	unsigned *out;
+	std::vector<unsigned> fallback;
+
+	if (shm.data() == MAP_FAILED) {
+		// No workers or no shared memory available: do everything in this process
+		fallback.resize(n_vertices);
+		out = fallback.data();
+		n_workers = 0;
+	} else {
+		out = static_cast<unsigned *>(shm.data());
+	}
+
+	// Worker k orders parts k, k + n_workers, k + 2 * n_workers, ...
+	for (unsigned k = 0; k < n_workers; k++) {
+		const pid_t pid = fork();
+
+		if (pid == 0) {
+			// Workers never return, not even by throwing: their parts are
+			// redone by the calling process instead
+			try {
+				for (size_t i = k; i < parts.size(); i += n_workers)
+					order_block(snap.graph, blocks[parts[i]].vertices, out + offset[parts[i]], block_order);
+			} catch (...) {
+				_exit(1);
+			}
+
+			AA_PROBE2(distributed_order_batch, k, (parts.size() + n_workers - 1 - k) / n_workers);
+			_exit(0);
+		}
+
+		shm.add(pid);
+	}
+
+	for (size_t i = 0; i < blocks.size(); i++) {
+		if (blocks[i].is_separator)
+			order_block(snap.graph, blocks[i].vertices, out + offset[i], block_order);
+	}
+
+	// Wait for the workers and redo the work of any failed one, which must not
+	// be done while it may still be running, as it writes to the same mapping
+	for (unsigned k = 0; k < n_workers; k++) {
+		if (!shm.wait(k)) {
+			for (size_t i = k; i < parts.size(); i += n_workers)
+				order_block(snap.graph, blocks[parts[i]].vertices, out + offset[parts[i]], block_order);
+
+			AA_PROBE2(distributed_order_batch, k, (parts.size() + n_workers - 1 - k) / n_workers);
+			n_failed++;
+		}
+	}
+
+	if (n_workers == 0) {
+		for (const auto i : parts)
+			order_block(snap.graph, blocks[i].vertices, out + offset[i], block_order);
+	}
+
+	VertexOrder<Graph> order(n_vertices);
+
+	for (size_t i = 0; i < n_vertices; i++)
+		order[i] = snap.vertices[out[i]];
+
+	AA_PROBE2(distributed_order_return, n_vertices, n_failed);
+	return order;
+}
+
+#endif // ALGO_DISTRIBUTED_ORDER_H
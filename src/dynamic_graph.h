@@ -0,0 +1,551 @@
+/**
+ * Mutable graphs for dynamic workloads, stored as an immutable compressed
+ * sparse row base plus per-vertex buffers of the edits since the base was
+ * built, which are periodically merged into a new base in the background.
+ */
+
+#ifndef DYNAMIC_GRAPH_H
+#define DYNAMIC_GRAPH_H
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <cassert>
+#include <iterator>
+#include <algorithm>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+
+#include "utils.h"
+#include "csr_graph.h"
+#include "probes.h"
+
+template <class Index, class Offset>
+class DynamicGraph;
+
+/**
+ * Immutable state of a DynamicGraph, modeling the VertexListGraph and
+ * AdjacencyGraph concepts of the Boost Graph Library, so that it can be passed
+ * to the algorithms (also on other threads while the graph is being edited).
+ *
+ * The neighbors of vertex v are its neighbors in the base CSR graph, minus the
+ * removed ones, plus the added ones, all kept sorted so that scans merge them
+ * on the fly. Vertices without edits, usually most of them, only cost a look
+ * at their (empty) edits before their base neighbors are walked as in a CSR
+ * graph, and snapshots without any edits skip even that. Snapshots share the
+ * base and the edit buffers with the graph and with each other, so taking one
+ * is O(1), while the graph copies them on write. Vertices are their own
+ * indices.
+ */
+template <class Index = unsigned, class Offset = std::size_t>
+class DynamicGraphSnapshot {
+public:
+	class adjacency_iterator;
+
+	typedef Index vertex_descriptor;
+	typedef std::pair<Index, Index> edge_descriptor;
+	typedef boost::undirected_tag directed_category;
+	typedef boost::disallow_parallel_edge_tag edge_parallel_category;
+	typedef boost::counting_iterator<Index> vertex_iterator;
+	typedef Index vertices_size_type;
+	typedef Offset edges_size_type;
+	typedef Offset degree_size_type;
+
+	struct traversal_category :
+		virtual boost::vertex_list_graph_tag,
+		virtual boost::adjacency_graph_tag {};
+
+	static_assert(!std::numeric_limits<Index>::is_signed);
+
+	DynamicGraphSnapshot()
+		: base_(std::make_shared<const CsrGraph<Index, Offset>>()), edits_(std::make_shared<EditTable>()),
+		  n_(0), n_edges_(0), n_entries_(0) {}
+
+	/**
+	 * @return the base graph, whose neighbors are sorted
+	 */
+	const CsrGraph<Index, Offset> &base() const { return *base_; }
+
+	/**
+	 * @return the number of entries of the edit buffers, i.e. twice the number
+	 *         of edges added or removed since the base was built
+	 */
+	Offset n_edit_entries() const { return n_entries_; }
+
+	/**
+	 * Iterator over the sorted neighbors of a vertex, merging the base with
+	 * its edits. Once no edits are left (from the start for vertices without
+	 * edits), it walks the rest of the base as a plain pointer.
+	 */
+	class adjacency_iterator : public boost::iterator_facade<adjacency_iterator, Index,
+		boost::forward_traversal_tag, Index>
+	{
+	public:
+		adjacency_iterator() : base_(nullptr), base_end_(nullptr), removed_(nullptr), removed_end_(nullptr),
+			added_(nullptr), added_end_(nullptr), cur_(nullptr), n_edits_(0), in_base_(true) {}
+
+		adjacency_iterator(const Index *base, const Index *base_end, const Index *removed, const Index *removed_end,
+				const Index *added, const Index *added_end)
+			: base_(base), base_end_(base_end), removed_(removed), removed_end_(removed_end), added_(added),
+			  added_end_(added_end), cur_(base), n_edits_((removed_end - removed) + (added_end - added)),
+			  in_base_(true)
+		{
+			if (n_edits_ > 0)
+				next();
+		}
+
+	private:
+		friend class boost::iterator_core_access;
+
+		// Removed neighbors are all in the base, so each one is reached in turn,
+		// and added neighbors are never in the base
+		void next() {
+			while (removed_ != removed_end_ && base_ != base_end_ && *base_ == *removed_) {
+				++base_;
+				++removed_;
+				--n_edits_;
+			}
+
+			in_base_ = added_ == added_end_ || (base_ != base_end_ && *base_ < *added_);
+			cur_ = in_base_ ? base_ : added_;
+		}
+
+		Index dereference() const { return *cur_; }
+
+		// The number of edits left tells apart positions in the base from
+		// positions in the added neighbors at the same address
+		bool equal(const adjacency_iterator &other) const {
+			return cur_ == other.cur_ && n_edits_ == other.n_edits_;
+		}
+
+		void increment() {
+			if (n_edits_ == 0) {
+				++cur_;
+				return;
+			}
+
+			if (in_base_) {
+				++base_;
+			} else {
+				++added_;
+				--n_edits_;
+			}
+
+			next();
+		}
+
+		const Index *base_, *base_end_;
+		const Index *removed_, *removed_end_;
+		const Index *added_, *added_end_;
+		// Current neighbor, either in the base or added, and the only position
+		// kept up to date once no edits are left
+		const Index *cur_;
+		std::ptrdiff_t n_edits_;
+		bool in_base_;
+	};
+
+	static vertex_descriptor null_vertex() {
+		return std::numeric_limits<Index>::max();
+	}
+
+	friend Index num_vertices(const DynamicGraphSnapshot &g) {
+		return g.n_;
+	}
+
+	friend Offset num_edges(const DynamicGraphSnapshot &g) {
+		return g.n_edges_;
+	}
+
+	friend std::pair<vertex_iterator, vertex_iterator> vertices(const DynamicGraphSnapshot &g) {
+		return {vertex_iterator(0), vertex_iterator(g.n_)};
+	}
+
+	friend std::pair<adjacency_iterator, adjacency_iterator> adjacent_vertices(Index v,
+			const DynamicGraphSnapshot &g) {
+		const auto [base, base_end] = g.base_neighbors(v);
+
+		// Without any edits, the table of the edits is not even read
+		if (g.n_entries_ == 0)
+			return {adjacency_iterator(base, base_end, nullptr, nullptr, nullptr, nullptr),
+				adjacency_iterator(base_end, base_end, nullptr, nullptr, nullptr, nullptr)};
+
+		const VertexEdits &e = (*g.edits_)[v];
+
+		return {adjacency_iterator(base, base_end, e.removed(), e.added(), e.added(), e.end()),
+			adjacency_iterator(base_end, base_end, e.added(), e.added(), e.end(), e.end())};
+	}
+
+	friend Offset degree(Index v, const DynamicGraphSnapshot &g) {
+		const auto [base, base_end] = g.base_neighbors(v);
+		const VertexEdits &e = (*g.edits_)[v];
+
+		return Offset(base_end - base) + e.n_added - e.n_removed;
+	}
+
+	/**
+	 * @return the edge u--v and true/false whether it exists, in O(log(deg))
+	 */
+	friend std::pair<edge_descriptor, bool> edge(Index u, Index v, const DynamicGraphSnapshot &g) {
+		const auto [base, base_end] = g.base_neighbors(u);
+		const VertexEdits &e = (*g.edits_)[u];
+		const bool found = std::binary_search(base, base_end, v)
+			? !std::binary_search(e.removed(), e.added(), v)
+			: std::binary_search(e.added(), e.end(), v);
+
+		return {{u, v}, found};
+	}
+
+	// Vertices are their own indices
+	friend boost::typed_identity_property_map<Index> get(boost::vertex_index_t, const DynamicGraphSnapshot &) {
+		return {};
+	}
+
+private:
+	friend class DynamicGraph<Index, Offset>;
+
+	// Sorted neighbors removed from the base of a vertex, followed by the
+	// sorted neighbors added to it, in a single array (null if none) replaced
+	// by each edit, so that scans only follow one pointer and arrays are never
+	// modified while shared
+	struct VertexEdits {
+		std::shared_ptr<const Index[]> entries;
+		Index n_removed = 0;
+		Index n_added = 0;
+
+		const Index *removed() const { return entries.get(); }
+		const Index *added() const { return entries.get() + n_removed; }
+		const Index *end() const { return entries.get() + n_removed + n_added; }
+	};
+
+	typedef std::vector<VertexEdits> EditTable;
+
+	std::pair<const Index *, const Index *> base_neighbors(Index v) const {
+		if (v >= base_->n_vertices())
+			return {nullptr, nullptr};
+
+		const auto [begin, end] = adjacent_vertices(v, *base_);
+		return {begin, end};
+	}
+
+	std::shared_ptr<const CsrGraph<Index, Offset>> base_;
+	// Shared with the snapshots, hence never modified while shared
+	std::shared_ptr<EditTable> edits_;
+	Index n_;
+	Offset n_edges_;
+	Offset n_entries_;
+};
+
+/**
+ * Simple, undirected graph supporting fast edge insertions and removals as
+ * well as fast scans (see DynamicGraphSnapshot, which it extends with edits,
+ * so that it can also be passed to the algorithms directly).
+ *
+ * Edits take O(log(deg) + edits of the vertices) time, plus O(V) for the first
+ * edit after a snapshot (to copy the table of the edits). When the edits reach
+ * a given fraction of the base, they are merged into a new base by a
+ * background thread, working on a snapshot while the graph is still edited,
+ * and the new base is installed by the first edit after it is done.
+ *
+ * A graph must only be used by one thread at a time, but its snapshots can be
+ * read by any number of threads, even while the graph is edited.
+ *
+ * Probes: dynamic_graph_compaction_start(V, edit entries) and
+ * dynamic_graph_compaction_return(V, edit entries left) when installed.
+ */
+template <class Index = unsigned, class Offset = std::size_t>
+class DynamicGraph : public DynamicGraphSnapshot<Index, Offset> {
+public:
+	typedef DynamicGraphSnapshot<Index, Offset> Snapshot;
+
+	// Minimum number of edit entries triggering a compaction
+	static constexpr Offset min_compaction_entries = 1024;
+
+	/**
+	 * Create a graph without edges.
+	 *
+	 * @param n_vertices       number of vertices of the graph
+	 * @param compaction_ratio ratio of edit entries to base entries starting a
+	 *                         compaction, or 0 to only compact on compact()
+	 */
+	explicit DynamicGraph(Index n_vertices = 0, double compaction_ratio = 0.1)
+		: DynamicGraph(CsrGraph<Index, Offset>(std::vector<Offset>(size_t(n_vertices) + 1, 0), {}),
+			compaction_ratio) {}
+
+	/**
+	 * Create a graph with the edges of a CSR graph, e.g. built by
+	 * make_csr_graph() or make_csr_snapshot().
+	 *
+	 * @param base             initial graph
+	 * @param compaction_ratio as above
+	 *
+	 * @pre `base` is a simple, undirected graph
+	 */
+	explicit DynamicGraph(CsrGraph<Index, Offset> base, double compaction_ratio = 0.1)
+		: compaction_ratio_(compaction_ratio)
+	{
+		std::vector<Offset> offsets = base.offsets();
+		std::vector<Index> targets = base.targets();
+
+		for (Index v = 0; v < base.n_vertices(); v++)
+			std::sort(targets.begin() + offsets[v], targets.begin() + offsets[v + 1]);
+
+		this->n_ = base.n_vertices();
+		this->n_edges_ = num_edges(base);
+		this->base_ = std::make_shared<const CsrGraph<Index, Offset>>(std::move(offsets), std::move(targets));
+		this->edits_ = std::make_shared<EditTable>(this->n_);
+	}
+
+	DynamicGraph(const DynamicGraph &) = delete;
+	DynamicGraph &operator=(const DynamicGraph &) = delete;
+
+	~DynamicGraph() {
+		if (compaction_)
+			compaction_->thread.join();
+	}
+
+	/**
+	 * @return a snapshot of the current state of the graph, in O(1)
+	 */
+	Snapshot snapshot() const {
+		return *this;
+	}
+
+	/**
+	 * Add a vertex without edges.
+	 *
+	 * @return the new vertex
+	 */
+	Index add_vertex() {
+		install_compaction(false);
+		writable_table().emplace_back();
+		return this->n_++;
+	}
+
+	/**
+	 * Add the edge u--v, if not already present.
+	 *
+	 * @return true/false whether the edge was added
+	 *
+	 * @pre `u` and `v` are distinct vertices of the graph
+	 */
+	bool add_edge(Index u, Index v) {
+		assert(u != v && u < this->n_ && v < this->n_);
+
+		install_compaction(false);
+
+		if (edge(u, v, *this).second)
+			return false;
+
+		edit(u, v, true);
+		edit(v, u, true);
+		this->n_edges_++;
+		start_compaction(false);
+
+		return true;
+	}
+
+	/**
+	 * Remove the edge u--v, if present.
+	 *
+	 * @return true/false whether the edge was removed
+	 *
+	 * @pre `u` and `v` are vertices of the graph
+	 */
+	bool remove_edge(Index u, Index v) {
+		assert(u < this->n_ && v < this->n_);
+
+		install_compaction(false);
+
+		if (!edge(u, v, *this).second)
+			return false;
+
+		edit(u, v, false);
+		edit(v, u, false);
+		this->n_edges_--;
+		start_compaction(false);
+
+		return true;
+	}
+
+	/**
+	 * Merge all the edits into a new base, waiting for the compaction in
+	 * progress (if any) first.
+	 */
+	void compact() {
+		install_compaction(true);
+		start_compaction(true);
+		install_compaction(true);
+	}
+
+	/**
+	 * @return true/false whether a compaction is in progress, or done but not
+	 *         yet installed
+	 */
+	bool is_compacting() const {
+		return compaction_ != nullptr;
+	}
+
+private:
+	typedef typename Snapshot::VertexEdits VertexEdits;
+	typedef typename Snapshot::EditTable EditTable;
+
+	struct Compaction {
+		Snapshot source;
+		CsrGraph<Index, Offset> result;
+		std::atomic<bool> done{false};
+		std::thread thread;
+	};
+
+	/**
+	 * Helper function: return the table of the edits, copying it first if
+	 * shared with a snapshot (the arrays of the edits are shared by the copy).
+	 */
+	EditTable &writable_table() {
+		if (this->edits_.use_count() > 1)
+			this->edits_ = std::make_shared<EditTable>(*this->edits_);
+
+		return *this->edits_;
+	}
+
+	/**
+	 * Helper function: add or remove v to or from the neighbors of u, copying
+	 * the edits of u first if shared with a snapshot.
+	 */
+	void edit(Index u, Index v, bool add) {
+		const auto [base, base_end] = this->base_neighbors(u);
+		const bool in_base = std::binary_search(base, base_end, v);
+		VertexEdits &e = writable_table()[u];
+		VertexEdits res = e;
+
+		// Adding a removed edge of the base cancels its removal, and so on
+		const bool insert = add != in_base;
+		const Index *pos = in_base ? std::lower_bound(e.removed(), e.added(), v)
+			: std::lower_bound(e.added(), e.end(), v);
+		const size_t n_before = size_t(e.n_removed) + e.n_added;
+		const size_t n = insert ? n_before + 1 : n_before - 1;
+		Index &count = in_base ? res.n_removed : res.n_added;
+
+		count = insert ? count + 1 : count - 1;
+		res.entries.reset();
+
+		if (n > 0) {
+			Index *entries = new Index[n];
+
+			res.entries.reset(entries);
+			entries = std::copy(e.removed(), pos, entries);
+
+			if (insert)
+				*entries++ = v;
+
+			std::copy(pos + !insert, e.end(), entries);
+		}
+
+		e = std::move(res);
+		this->n_entries_ = insert ? this->n_entries_ + 1 : this->n_entries_ - 1;
+	}
+
+	/**
+	 * Helper function: start compacting a snapshot of the graph on another
+	 * thread if there are enough edits (or always if forced) and none is in
+	 * progress.
+	 */
+	void start_compaction(bool force) {
+		const Offset n_base = this->base_->targets().size();
+
+		if (compaction_ || (!force && (compaction_ratio_ <= 0 || this->n_entries_ < min_compaction_entries
+				|| this->n_entries_ < compaction_ratio_ * n_base)))
+			return;
+
+		AA_PROBE2(dynamic_graph_compaction_start, this->n_, this->n_entries_);
+
+		compaction_ = std::make_unique<Compaction>();
+		compaction_->source = snapshot();
+		compaction_->thread = std::thread([c = compaction_.get()] {
+			std::vector<Offset> offsets(1, 0);
+			std::vector<Index> targets;
+
+			targets.reserve(2 * num_edges(c->source));
+			offsets.reserve(size_t(num_vertices(c->source)) + 1);
+
+			for (Index v = 0; v < num_vertices(c->source); v++) {
+				for (const auto w : iter_neighbors(c->source, v))
+					targets.push_back(w);
+
+				offsets.push_back(targets.size());
+			}
+
+			c->result = CsrGraph<Index, Offset>(std::move(offsets), std::move(targets));
+			c->done.store(true, std::memory_order_release);
+		});
+	}
+
+	/**
+	 * Helper function: if the compaction in progress is done (or always if
+	 * waiting for it), make its result the base. The edits of the vertices
+	 * edited since its snapshot are rebased on it, and the other vertices are
+	 * exactly as in the new base.
+	 */
+	void install_compaction(bool wait) {
+		if (!compaction_ || (!wait && !compaction_->done.load(std::memory_order_acquire)))
+			return;
+
+		compaction_->thread.join();
+
+		const Snapshot &source = compaction_->source;
+		const auto &source_edits = *source.edits_;
+		auto base = std::make_shared<const CsrGraph<Index, Offset>>(std::move(compaction_->result));
+		auto edits = std::make_shared<EditTable>(this->n_);
+		std::vector<Index> neighbors, entries;
+		Offset n_entries = 0;
+
+		for (Index v = 0; v < this->n_; v++) {
+			// Each edit replaces the array, so unchanged edits share it
+			if (v < num_vertices(source) && (*this->edits_)[v].entries == source_edits[v].entries)
+				continue;
+
+			const auto [begin, end] = adjacent_vertices(v, *this);
+			const Index *b = nullptr, *b_end = nullptr;
+
+			neighbors.assign(begin, end);
+			entries.clear();
+
+			if (v < base->n_vertices())
+				std::tie(b, b_end) = adjacent_vertices(v, *base);
+
+			std::set_difference(b, b_end, neighbors.begin(), neighbors.end(), std::back_inserter(entries));
+			const size_t n_removed = entries.size();
+			std::set_difference(neighbors.begin(), neighbors.end(), b, b_end, std::back_inserter(entries));
+
+			if (entries.empty())
+				continue;
+
+			VertexEdits &e = (*edits)[v];
+			Index *copy = new Index[entries.size()];
+
+			e.entries.reset(copy);
+			e.n_removed = n_removed;
+			e.n_added = entries.size() - n_removed;
+			std::copy(entries.begin(), entries.end(), copy);
+			n_entries += entries.size();
+		}
+
+		this->base_ = std::move(base);
+		this->edits_ = std::move(edits);
+		this->n_entries_ = n_entries;
+		compaction_.reset();
+
+		AA_PROBE2(dynamic_graph_compaction_return, this->n_, n_entries);
+	}
+
+	double compaction_ratio_;
+	std::unique_ptr<Compaction> compaction_;
+};
+
+#endif // DYNAMIC_GRAPH_H
@@ -0,0 +1,211 @@
+/**
+ * Symbolic Cholesky factorization of the matrices having the sparsity pattern
+ * of a graph, and generation of specialized straight-line C++ code performing
+ * the numeric factorization for a fixed pattern.
+ */
+
+#ifndef ALGO_ELIM_PLAN_H
+#define ALGO_ELIM_PLAN_H
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <string>
+#include <ostream>
+#include <algorithm>
+#include <boost/graph/graph_concepts.hpp>
+
+#include "utils.h"
+#include "fill.h"
+#include "vertex_map.h"
+
+/**
+ * Structure of the Cholesky factor L of a symmetric matrix whose sparsity
+ * pattern is the one of a graph with vertices permuted according to an
+ * elimination order, i.e. the lower triangle of the chordal completion of the
+ * graph for that order.
+ *
+ * Row and column j of the matrix correspond to the j-th vertex of the order.
+ * Numeric values are stored in a single array: first the n diagonal entries,
+ * then the off-diagonal entries of each column of L, column after column, with
+ * the entries of column j at positions [n + col_ptr[j], n + col_ptr[j + 1]) and
+ * rows row_ind[col_ptr[j]], ..., row_ind[col_ptr[j + 1] - 1] (ascending).
+ */
+struct EliminationPlan {
+	static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+	size_t n = 0;
+	std::vector<size_t> col_ptr;
+	std::vector<unsigned> row_ind;
+
+	/**
+	 * Number of entries of the values array for this plan.
+	 */
+	size_t n_values() const {
+		return n + row_ind.size();
+	}
+
+	/**
+	 * Position of the entry (row, col) of L in the values array, or npos if the
+	 * entry is not part of the structure of L.
+	 *
+	 * @pre row >= col
+	 */
+	size_t position(unsigned row, unsigned col) const {
+		if (row == col)
+			return col;
+
+		const auto begin = row_ind.begin() + col_ptr[col];
+		const auto end   = row_ind.begin() + col_ptr[col + 1];
+		const auto it    = std::lower_bound(begin, end, row);
+
+		if (it == end || *it != row)
+			return npos;
+
+		return n + (it - row_ind.begin());
+	}
+};
+
+/**
+ * Compute the structure of the Cholesky factor for the given ordered graph.
+ *
+ * @param  g     graph with the sparsity pattern of the matrix
+ * @param  order elimination order, i.e. permutation of the rows/columns
+ * @return the symbolic factorization
+ *
+ * @pre `g` is a simple, connected, undirected graph; `order` is an ordered
+ *      sequence of the vertices of `g`
+ */
+template <class Graph>
+EliminationPlan make_elimination_plan(const Graph &g, const VertexOrder<Graph> &order) {
+	typedef VertexDesc<Graph> Vertex;
+
+	BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<Graph>));
+	BOOST_CONCEPT_ASSERT((boost::AdjacencyGraphConcept<Graph>));
+
+	const auto n_vertices = num_vertices(g);
+	VertexStateMap<Graph, unsigned> index_of(g);
+	std::vector<std::vector<unsigned>> col(n_vertices);
+	EliminationPlan plan;
+
+	for (unsigned i = 0; i < order.size(); i++)
+		index_of[order[i]] = i;
+
+	auto add = [&](Vertex a, Vertex b) {
+		const auto ia = index_of[a];
+		const auto ib = index_of[b];
+
+		if (ia < ib)
+			col[ia].push_back(ib);
+		else
+			col[ib].push_back(ia);
+	};
+
+	for (const auto v : iter_vertices(g)) {
+		for (const auto w : iter_neighbors(g, v)) {
+			if (index_of[v] < index_of[w])
+				add(v, w);
+		}
+	}
+
+	for (const auto &[a, b] : fill_in(g, order))
+		add(a, b);
+
+	plan.n = n_vertices;
+	plan.col_ptr.push_back(0);
+
+	for (auto &c : col) {
+		std::sort(c.begin(), c.end());
+		plan.row_ind.insert(plan.row_ind.end(), c.begin(), c.end());
+		plan.col_ptr.push_back(plan.row_ind.size());
+	}
+
+	return plan;
+}
+
+/**
+ * Compute the numeric Cholesky factorization A = LL^T in place, for a matrix
+ * with the structure given by the plan. This is the generic (not specialized)
+ * right-looking factorization loop, performing the exact same operations in the
+ * same order as the code generated by emit_cholesky_kernel().
+ *
+ * @param plan   symbolic factorization
+ * @param values values of the lower triangle of the matrix in the layout of
+ *               the plan, with zeros in the positions of the fill-in
+ *
+ * @pre  the matrix is symmetric positive definite
+ * @post `values` holds the values of L in the layout of the plan
+ */
+inline void cholesky_factorize(const EliminationPlan &plan, double *values) {
+	const size_t n = plan.n;
+	double *diag = values;
+	double *off  = values + n;
+	std::vector<size_t> pos(n);
+
+	for (size_t j = 0; j < n; j++) {
+		const size_t begin = plan.col_ptr[j];
+		const size_t end   = plan.col_ptr[j + 1];
+
+		diag[j] = std::sqrt(diag[j]);
+
+		for (size_t p = begin; p < end; p++)
+			off[p] /= diag[j];
+
+		for (size_t p = begin; p < end; p++) {
+			const unsigned i = plan.row_ind[p];
+
+			// Scatter the positions of the entries of column i
+			for (size_t q = plan.col_ptr[i]; q < plan.col_ptr[i + 1]; q++)
+				pos[plan.row_ind[q]] = q;
+
+			diag[i] -= off[p] * off[p];
+
+			for (size_t q = p + 1; q < end; q++)
+				off[pos[plan.row_ind[q]]] -= off[q] * off[p];
+		}
+	}
+}
+
+/**
+ * Emit the source code of a C++ function performing the numeric factorization
+ * of cholesky_factorize() for the given plan as straight-line code, i.e. with
+ * all loops unrolled and all positions in the values array as constants. The
+ * emitted function has signature `void name(double *values)` and requires the
+ * <cmath> header.
+ *
+ * @param plan symbolic factorization
+ * @param out  stream to write the code to
+ * @param name name of the emitted function
+ */
+inline void emit_cholesky_kernel(const EliminationPlan &plan, std::ostream &out, const std::string &name) {
+	const size_t n = plan.n;
+
+	out << "// Cholesky factorization for a fixed pattern with " << n << " rows and "
+	    << plan.row_ind.size() << " off-diagonal nonzeros.\n";
+	out << "inline void " << name << "(double *v) {\n";
+
+	for (size_t j = 0; j < n; j++) {
+		const size_t begin = plan.col_ptr[j];
+		const size_t end   = plan.col_ptr[j + 1];
+
+		out << "\tv[" << j << "] = std::sqrt(v[" << j << "]);\n";
+
+		for (size_t p = begin; p < end; p++)
+			out << "\tv[" << n + p << "] /= v[" << j << "];\n";
+
+		for (size_t p = begin; p < end; p++) {
+			const unsigned i = plan.row_ind[p];
+
+			out << "\tv[" << i << "] -= v[" << n + p << "] * v[" << n + p << "];\n";
+
+			for (size_t q = p + 1; q < end; q++) {
+				out << "\tv[" << plan.position(plan.row_ind[q], i) << "] -= v["
+				    << n + q << "] * v[" << n + p << "];\n";
+			}
+		}
+	}
+
+	out << "}\n";
+}
+
+#endif // ALGO_ELIM_PLAN_H
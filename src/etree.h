@@ -0,0 +1,152 @@
+/**
+ * Elimination trees of ordered graphs, and reach sets in the filled graph
+ * computed on them, as needed by triangular solves with sparse right-hand
+ * sides.
+ *
+ * See: https://doi.org/10.1137/0611010
+ */
+
+#ifndef ALGO_ETREE_H
+#define ALGO_ETREE_H
+
+#include <limits>
+#include <vector>
+#include <cassert>
+#include <boost/graph/graph_concepts.hpp>
+
+#include "utils.h"
+#include "vertex_map.h"
+
+/**
+ * Elimination tree of an ordered graph: the parent of the j-th vertex of the
+ * order is the first vertex after it adjacent to it in the filled graph (i.e.
+ * the row of the first off-diagonal entry of column j of the Cholesky factor),
+ * if any. Vertices are identified by their position in the order.
+ */
+struct EliminationTree {
+	static constexpr unsigned none = std::numeric_limits<unsigned>::max();
+
+	std::vector<unsigned> parent;
+};
+
+/**
+ * Compute the elimination tree of an ordered graph in almost linear time with
+ * the algorithm by Liu, without computing the fill-in.
+ *
+ * @param  g     graph
+ * @param  order elimination order
+ * @return the elimination tree, a forest if `g` is not connected
+ *
+ * @pre `g` is a simple, undirected graph; `order` is an ordered sequence of
+ *      the vertices of `g`; `g` has less than 2^32 - 1 vertices
+ */
+template <class Graph>
+EliminationTree make_elimination_tree(const Graph &g, const VertexOrder<Graph> &order) {
+	BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<Graph>));
+	BOOST_CONCEPT_ASSERT((boost::AdjacencyGraphConcept<Graph>));
+
+	constexpr unsigned none = EliminationTree::none;
+	const unsigned n = order.size();
+	VertexStateMap<Graph, unsigned> index_of(g);
+	std::vector<unsigned> ancestor(n, none);
+	EliminationTree tree;
+
+	assert(order.size() < none);
+
+	tree.parent.assign(n, none);
+
+	for (unsigned j = 0; j < n; j++)
+		index_of[order[j]] = j;
+
+	for (unsigned j = 0; j < n; j++) {
+		// Climb from each earlier neighbor to the root of its current subtree,
+		// which becomes a child of j, compressing the path to j
+		for (const auto w : iter_neighbors(g, order[j])) {
+			unsigned next;
+
+			for (unsigned i = index_of[w]; i != none && i < j; i = next) {
+				next = ancestor[i];
+				ancestor[i] = j;
+
+				if (next == none)
+					tree.parent[i] = j;
+			}
+		}
+	}
+
+	return tree;
+}
+
+/**
+ * Computation of reach sets in the filled graph of an ordered graph: the reach
+ * of a set of vertices is the set of vertices reachable from it moving to later
+ * neighbors in the filled graph, i.e. the nonzero pattern of the solution x of
+ * Lx = b where L is the Cholesky factor and b has the pattern of the set. By
+ * the path theorem, it is the set of all the ancestors in the elimination tree
+ * of the vertices of the set.
+ *
+ * The workspace is reused between calls, so that each one takes time linear in
+ * the size of the set plus the size of its reach.
+ */
+class EliminationTreeReach {
+public:
+	/**
+	 * @param tree elimination tree, which must outlive this object
+	 */
+	explicit EliminationTreeReach(const EliminationTree &tree)
+		: tree_(tree), mark_(tree.parent.size(), 0), stamp_(0) {}
+
+	/**
+	 * Compute the reach of a set of vertices.
+	 *
+	 * @param  first, last range of positions of vertices in the order
+	 * @return the reach in topological order, i.e. with each vertex before all
+	 *         its ancestors (as needed by forward substitution), valid until
+	 *         the next call
+	 */
+	template <class It>
+	const std::vector<unsigned> &reach(It first, It last) {
+		const auto &parent = tree_.parent;
+
+		stamp_++;
+		reach_.clear();
+		path_.clear();
+
+		// Each path up to a vertex already reached goes before the paths found
+		// earlier, which contain its ancestors
+		for (; first != last; ++first) {
+			const size_t begin = path_.size();
+
+			for (unsigned i = *first; i != EliminationTree::none && mark_[i] != stamp_; i = parent[i]) {
+				mark_[i] = stamp_;
+				path_.push_back(i);
+			}
+
+			segments_.push_back(begin);
+		}
+
+		for (size_t end = path_.size(); !segments_.empty(); segments_.pop_back()) {
+			reach_.insert(reach_.end(), path_.begin() + segments_.back(), path_.begin() + end);
+			end = segments_.back();
+		}
+
+		return reach_;
+	}
+
+	/**
+	 * @return the reach of the given vertices (see above)
+	 */
+	const std::vector<unsigned> &reach(const std::vector<unsigned> &set) {
+		return reach(set.begin(), set.end());
+	}
+
+private:
+	const EliminationTree &tree_;
+	std::vector<size_t> mark_;
+	size_t stamp_;
+	std::vector<unsigned> path_;
+	std::vector<size_t> segments_;
+	std::vector<unsigned> reach_;
+};
+
+#endif // ALGO_ETREE_H
@@ -0,0 +1,408 @@
+/**
+ * Exact computation of minimum fill-in and minimum width (treewidth)
+ * elimination orders for small graphs, using branch and bound over subsets of
+ * eliminated vertices.
+ */
+
+#ifndef ALGO_EXACT_ORDER_H
+#define ALGO_EXACT_ORDER_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <array>
+#include <tuple>
+#include <algorithm>
+#include <mutex>
+#include <cassert>
+#include <unordered_map>
+#include <boost/functional/hash.hpp>
+#include <boost/graph/graph_concepts.hpp>
+
+#include "utils.h"
+#include "lex_m.h"
+#include "vertex_map.h"
+#include "metrics.h"
+
+/**
+ * Quantity minimized by exact_order().
+ */
+enum class ExactObjective {
+	// Number of edges of the fill-in
+	fill,
+	// Maximum number of neighbors of a vertex at the time of its elimination,
+	// i.e. the treewidth of the graph for an optimal order
+	width
+};
+
+/**
+ * Cache of the orders computed by exact_order(), so that each distinct block
+ * structure only needs to be solved once. Blocks are identified by their exact
+ * (labeled) adjacency structure, i.e. the graphs are not compared up to
+ * isomorphism. The cache can be shared between threads.
+ */
+class ExactOrderCache {
+public:
+	typedef std::vector<uint64_t> Key;
+	typedef std::vector<uint8_t> Value;
+
+	bool lookup(const Key &key, Value &value) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = map_.find(key);
+
+		if (it == map_.end()) {
+			misses_++;
+			AA_METRICS_COUNT("aa_exact_order_cache_lookups_total", "Number of lookups in the caches of exact_order().",
+				"result=\"miss\"", 1);
+			return false;
+		}
+
+		hits_++;
+		AA_METRICS_COUNT("aa_exact_order_cache_lookups_total", "Number of lookups in the caches of exact_order().",
+			"result=\"hit\"", 1);
+		value = it->second;
+		return true;
+	}
+
+	void insert(const Key &key, const Value &value) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		map_.emplace(key, value);
+	}
+
+	size_t size() const {
+		std::lock_guard<std::mutex> lock(mutex_);
+		return map_.size();
+	}
+
+	size_t hits() const {
+		std::lock_guard<std::mutex> lock(mutex_);
+		return hits_;
+	}
+
+	size_t misses() const {
+		std::lock_guard<std::mutex> lock(mutex_);
+		return misses_;
+	}
+
+	void clear() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		map_.clear();
+		hits_ = misses_ = 0;
+	}
+
+private:
+	mutable std::mutex mutex_;
+	std::unordered_map<Key, Value, boost::hash<Key>> map_;
+	size_t hits_ = 0;
+	size_t misses_ = 0;
+};
+
+/**
+ * Branch and bound search of an optimal elimination order for a graph of at
+ * most 64 vertices represented as adjacency bitmasks.
+ *
+ * The search explores the elimination game one vertex at a time. Since the
+ * graph obtained eliminating a set of vertices does not depend on the order in
+ * which they are eliminated (Lemma 4 of the paper), the cost of the cheapest
+ * way found to reach each set of eliminated vertices is memoized and any other
+ * way reaching the same set at a higher or equal cost is pruned. Simplicial
+ * vertices are always eliminated first without branching, which is safe for
+ * both objectives.
+ */
+class ExactOrderSearch {
+public:
+	typedef uint64_t Mask;
+	typedef std::array<Mask, 64> AdjMatrix;
+
+	// Upper bound on the number of memoized sets of eliminated vertices
+	static constexpr size_t max_memo_size = 1 << 22;
+
+	ExactOrderSearch(const std::vector<Mask> &adj, ExactObjective obj)
+		: n_(adj.size()), obj_(obj), levels_(adj.size() + 1), cur_order_(adj.size())
+	{
+		assert(n_ <= 64);
+		std::copy(adj.begin(), adj.end(), levels_[0].begin());
+	}
+
+	/**
+	 * Evaluate an elimination order and use it as the initial best solution if
+	 * it is better than the current one.
+	 */
+	void try_order(const std::vector<uint8_t> &order) {
+		AdjMatrix h = levels_[0];
+		unsigned cost = 0;
+
+		for (const auto v : order)
+			cost = combine(cost, eliminate(h, v));
+
+		if (cost < best_cost_) {
+			best_cost_ = cost;
+			best_order_ = order;
+		}
+	}
+
+	/**
+	 * Greedy order eliminating at each step the vertex with minimum fill-in
+	 * (for ExactObjective::fill) or minimum degree (ExactObjective::width).
+	 */
+	std::vector<uint8_t> greedy_order() const {
+		AdjMatrix h = levels_[0];
+		std::vector<uint8_t> order;
+		Mask remaining = all();
+
+		while (remaining) {
+			unsigned best_v = 0;
+			unsigned best_c = std::numeric_limits<unsigned>::max();
+
+			for (Mask m = remaining; m; m &= m - 1) {
+				const unsigned v = __builtin_ctzll(m);
+				const unsigned c = step_cost(h, v);
+
+				if (c < best_c) {
+					best_c = c;
+					best_v = v;
+				}
+			}
+
+			eliminate(h, best_v);
+			remaining &= ~bit(best_v);
+			order.push_back(best_v);
+		}
+
+		return order;
+	}
+
+	/**
+	 * Run the search and return an optimal elimination order.
+	 */
+	std::vector<uint8_t> run() {
+		try_order(greedy_order());
+		search(all(), 0, 0);
+		return best_order_;
+	}
+
+	unsigned best_cost() const { return best_cost_; }
+
+private:
+	static Mask bit(unsigned v) { return Mask(1) << v; }
+
+	Mask all() const { return n_ == 64 ? ~Mask(0) : bit(n_) - 1; }
+
+	unsigned combine(unsigned cost, unsigned step) const {
+		return obj_ == ExactObjective::fill ? cost + step : std::max(cost, step);
+	}
+
+	static unsigned fill_of(const AdjMatrix &h, unsigned v) {
+		const Mask nv = h[v];
+		unsigned missing = 0;
+
+		for (Mask m = nv; m; m &= m - 1) {
+			const unsigned u = __builtin_ctzll(m);
+			missing += __builtin_popcountll(nv & ~h[u] & ~bit(u));
+		}
+
+		return missing / 2;
+	}
+
+	unsigned step_cost(const AdjMatrix &h, unsigned v) const {
+		return obj_ == ExactObjective::fill ? fill_of(h, v) : __builtin_popcountll(h[v]);
+	}
+
+	/**
+	 * Eliminate v from the elimination graph h, making its neighbors a clique,
+	 * and return the cost of the elimination step.
+	 */
+	unsigned eliminate(AdjMatrix &h, unsigned v) const {
+		const Mask nv = h[v];
+		const unsigned c = step_cost(h, v);
+
+		for (Mask m = nv; m; m &= m - 1) {
+			const unsigned u = __builtin_ctzll(m);
+			h[u] = (h[u] | nv) & ~bit(u) & ~bit(v);
+		}
+
+		h[v] = 0;
+		return c;
+	}
+
+	static bool is_simplicial(const AdjMatrix &h, unsigned v) {
+		const Mask nv = h[v];
+
+		for (Mask m = nv; m; m &= m - 1) {
+			const unsigned u = __builtin_ctzll(m);
+
+			if (((h[u] | bit(u)) & nv) != nv)
+				return false;
+		}
+
+		return true;
+	}
+
+	void search(Mask remaining, unsigned cost, unsigned depth) {
+		const AdjMatrix &h = levels_[depth];
+
+		if (!remaining) {
+			if (cost < best_cost_) {
+				best_cost_ = cost;
+				best_order_ = cur_order_;
+			}
+
+			return;
+		}
+
+		if (cost >= best_cost_)
+			return;
+
+		// The minimum degree of the remaining graph is a lower bound for the
+		// width of any order
+		if (obj_ == ExactObjective::width) {
+			unsigned min_degree = std::numeric_limits<unsigned>::max();
+
+			for (Mask m = remaining; m; m &= m - 1)
+				min_degree = std::min<unsigned>(min_degree, __builtin_popcountll(h[__builtin_ctzll(m)]));
+
+			if (std::max(cost, min_degree) >= best_cost_)
+				return;
+		}
+
+		// Prune if this same set of vertices was already eliminated at a lower
+		// or equal cost
+		const Mask eliminated = all() & ~remaining;
+		auto it = memo_.find(eliminated);
+
+		if (it != memo_.end()) {
+			if (it->second <= cost)
+				return;
+
+			it->second = cost;
+		} else if (memo_.size() < max_memo_size) {
+			memo_.emplace(eliminated, cost);
+		}
+
+		// Eliminate a simplicial vertex without branching, if any
+		for (Mask m = remaining; m; m &= m - 1) {
+			const unsigned v = __builtin_ctzll(m);
+
+			if (is_simplicial(h, v)) {
+				levels_[depth + 1] = h;
+				const unsigned c = eliminate(levels_[depth + 1], v);
+				cur_order_[depth] = v;
+				search(remaining & ~bit(v), combine(cost, c), depth + 1);
+				return;
+			}
+		}
+
+		// Try the cheapest elimination steps first, to find good solutions
+		// early and prune more
+		std::vector<std::pair<unsigned, unsigned>> candidates;
+
+		for (Mask m = remaining; m; m &= m - 1) {
+			const unsigned v = __builtin_ctzll(m);
+			candidates.emplace_back(step_cost(h, v), v);
+		}
+
+		std::sort(candidates.begin(), candidates.end());
+
+		for (const auto &[c, v] : candidates) {
+			const unsigned new_cost = combine(cost, c);
+
+			if (new_cost >= best_cost_)
+				continue;
+
+			levels_[depth + 1] = levels_[depth];
+			eliminate(levels_[depth + 1], v);
+			cur_order_[depth] = v;
+			search(remaining & ~bit(v), new_cost, depth + 1);
+		}
+	}
+
+	const unsigned n_;
+	const ExactObjective obj_;
+	std::vector<AdjMatrix> levels_;
+	std::vector<uint8_t> cur_order_;
+	std::vector<uint8_t> best_order_;
+	unsigned best_cost_ = std::numeric_limits<unsigned>::max();
+	std::unordered_map<Mask, unsigned> memo_;
+};
+
+/**
+ * Compute an optimal elimination order for the given (small) graph, which
+ * minimizes either the fill-in or the width according to `obj`. The running
+ * time is exponential in the worst case, and this function is meant to be used
+ * for small blocks (up to about 40 vertices) that are factorized many times.
+ *
+ * @param  g     graph to compute the order for
+ * @param  obj   quantity to minimize
+ * @param  cache optional cache of already computed orders to use and update
+ * @return an optimal elimination order for the graph as an ordered sequence of
+ *         all its vertices
+ *
+ * @pre `g` is a simple, undirected graph with at most 64 vertices
+ */
+template <class Graph>
+VertexOrder<Graph> exact_order(const Graph &g, ExactObjective obj = ExactObjective::fill,
+		ExactOrderCache *cache = nullptr) {
+	typedef ExactOrderSearch::Mask Mask;
+
+	BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<Graph>));
+	BOOST_CONCEPT_ASSERT((boost::AdjacencyGraphConcept<Graph>));
+	AA_METRICS_CALL(exact_order, num_vertices(g), num_edges(g));
+
+	const auto n_vertices = num_vertices(g);
+	const auto vertex = std::make_from_tuple<VertexOrder<Graph>>(vertices(g));
+	VertexStateMap<Graph, uint8_t> index_of(g);
+	std::vector<Mask> adj(n_vertices);
+
+	assert(n_vertices <= 64);
+
+	for (uint8_t i = 0; i < n_vertices; i++)
+		index_of[vertex[i]] = i;
+
+	for (uint8_t i = 0; i < n_vertices; i++) {
+		for (const auto w : iter_neighbors(g, vertex[i]))
+			adj[i] |= Mask(1) << index_of[w];
+	}
+
+	ExactOrderCache::Key key;
+	ExactOrderCache::Value local_order;
+
+	if (cache) {
+		key = adj;
+		key.push_back(static_cast<uint64_t>(obj));
+
+		if (cache->lookup(key, local_order)) {
+			VertexOrder<Graph> order;
+
+			for (const auto i : local_order)
+				order.push_back(vertex[i]);
+
+			return order;
+		}
+	}
+
+	ExactOrderSearch search(adj, obj);
+
+	// Use the minimal order computed by LEX M as another initial upper bound
+	if (n_vertices > 0) {
+		std::vector<uint8_t> lex_m_order;
+
+		for (const auto v : lex_m(g))
+			lex_m_order.push_back(index_of[v]);
+
+		search.try_order(lex_m_order);
+	}
+
+	local_order = search.run();
+
+	if (cache)
+		cache->insert(key, local_order);
+
+	VertexOrder<Graph> order;
+
+	for (const auto i : local_order)
+		order.push_back(vertex[i]);
+
+	return order;
+}
+
+#endif // ALGO_EXACT_ORDER_H
@@ -9,11 +9,59 @@
 #ifndef ALGO_FILL_H
 #define ALGO_FILL_H
 
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
 #include <utility>
-#include <unordered_set>
-#include <unordered_map>
+#include <algorithm>
 
 #include "utils.h"
+#include "vertex_map.h"
+#include "sorted_set.h"
+#include "probes.h"
+#include "metrics.h"
+
+/**
+ * Compute the successors of each vertex of an ordered graph: w is a successor
+ * of v iff v--w and v comes before w in the given order. Vertices are
+ * identified by their position in the order.
+ *
+ * @param  g     graph
+ * @param  order ordered sequence of vertices of the graph
+ * @return sorted positions of the successors of each vertex, indexed by the
+ *         position of the vertex
+ * @tparam Containers container policy (see vertex_map.h)
+ *
+ * Probes: fill_successors(V, successors) when done.
+ *
+ * @pre `order` is an ordered sequence of the vertices of `g`; `g` has less
+ *      than 2^32 vertices
+ */
+template <class Graph, class Containers = DefaultContainers>
+std::vector<std::vector<uint32_t>> successor_lists(const Graph &g, const VertexOrder<Graph> &order) {
+	VertexStateMap<Graph, uint32_t, Containers> index_of(g);
+	std::vector<std::vector<uint32_t>> succ(order.size());
+	size_t n_succ = 0;
+
+	assert(order.size() <= std::numeric_limits<uint32_t>::max());
+
+	for (uint32_t i = 0; i < order.size(); i++)
+		index_of[order[i]] = i;
+
+	// Visiting the vertices in order, successors are appended in order
+	for (uint32_t i = 0; i < order.size(); i++) {
+		for (const auto w : iter_neighbors(g, order[i])) {
+			if (index_of[w] < i) {
+				succ[index_of[w]].push_back(i);
+				n_succ++;
+			}
+		}
+	}
+
+	AA_PROBE2(fill_successors, order.size(), n_succ);
+	return succ;
+}
 
 /**
  * Compute the chordal completion of an ordered graph, directly adding new edges
@@ -21,60 +69,76 @@
  *
  * @param g     graph to compute the chordal completion of
  * @param order ordered sequence of vertices of the graph
+ * @tparam Containers container policy (see vertex_map.h)
+ *
+ * Probes: fill_entry(V, E), fill_successors(V, successors), then for each merge
+ * of successors fill_merge(index, fill-in edges) and, at the end of the
+ * elimination, fill_return(V, successor merges, fill-in edges).
  *
  * @pre  `g` is a simple, connected, undirected graph; `order` is an ordered
- *       sequence of the vertices of `g`
+ *       sequence of the vertices of `g`; `g` has less than 2^32 vertices
  * @post `g` is the chordal completion of the original graph according to
  *       `order`
  */
-template <class Graph>
+template <class Graph, class Containers = DefaultContainers>
 void fill(Graph &g, const VertexOrder<Graph> &order) {
-	typedef typename VertexOrder<Graph>::value_type Vertex;
-	typedef typename VertexOrder<Graph>::size_type Index;
-
 	BOOST_CONCEPT_ASSERT((boost::MutableGraphConcept<Graph>));
 	BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<Graph>));
 	BOOST_CONCEPT_ASSERT((boost::AdjacencyGraphConcept<Graph>));
+	AA_METRICS_CALL(fill, order.size(), num_edges(g));
 
-	const auto n_vertices = boost::num_vertices(g);
-	std::unordered_map<Vertex, Index> index_of(n_vertices);
-	std::unordered_map<Vertex, std::unordered_set<Vertex>> succ(n_vertices);
-
-	for (Index i = 0; i < order.size(); i++)
-		index_of[order[i]] = i;
+	AA_PROBE2(fill_entry, order.size(), num_edges(g));
 
-	// Compute initial sets of successors: w is successor of v iff v--w and v
-	// comes before w in the given order
-	for (const auto v : iter_vertices(g)) {
-		for (const auto w : iter_neighbors(g, v)) {
-			if (index_of[v] < index_of[w])
-				succ[v].insert(w);
-		}
-	}
+	auto succ = successor_lists<Graph, Containers>(g, order);
+	std::vector<uint32_t> deficiency;
+	std::vector<uint32_t> merged;
+	size_t n_merges = 0, n_fill_in = 0;
+	// Number of successors stored, at most E + fill-in
+	size_t n_entries = num_edges(g), max_entries = n_entries;
 
 	// For each vertex v in the order
-	for (auto it = order.begin(); it != order.end() - 1; it++) {
-		const Vertex v = *it;
-		Index min_index = n_vertices;
-		Vertex closest;
-
-		// Find the closest successor of v in the order
-		for (const auto w : succ[v]) {
-			if (index_of[w] < min_index)
-				min_index = index_of[w];
+	for (uint32_t i = 0; i < succ.size(); i++) {
+		auto &s = succ[i];
+
+		// Vertices without successors (last of their connected component) do
+		// not produce any fill-in
+		if (s.empty())
+			continue;
+
+		// The closest successor of v in the order is the first one
+		auto &closest = succ[s.front()];
+
+		// Compute the successors of v that are not also successors of closest
+		// (i.e. the edges of the deficiency of v), add them to the graph and
+		// mark them as successors of closest
+		deficiency.resize(s.size() - 1);
+		deficiency.resize(sorted_difference(s.data() + 1, s.data() + s.size(),
+			closest.data(), closest.data() + closest.size(), deficiency.data()) - deficiency.data());
+
+		if (!deficiency.empty()) {
+			for (const auto w : deficiency)
+				add_edge(order[s.front()], order[w], g);
+
+			merged.resize(closest.size() + deficiency.size());
+			sorted_merge(closest.data(), closest.data() + closest.size(),
+				deficiency.data(), deficiency.data() + deficiency.size(), merged.data());
+			closest.swap(merged);
+			n_merges++;
+			n_fill_in += deficiency.size();
+			n_entries += deficiency.size();
+			max_entries = std::max(max_entries, n_entries);
+
+			AA_PROBE2(fill_merge, i, deficiency.size());
 		}
 
-		closest = order[min_index];
-
-		// Mark any other successor of v as a successor of closest and add edges
-		// to the graph as necessary (i.e. edges of the deficiency of v)
-		for (const auto w : succ[v]) {
-			if (w != closest && succ[closest].find(w) == succ[closest].end()) {
-				succ[closest].insert(w);
-				boost::add_edge(closest, w, g);
-			}
-		}
+		// The successors of v are not needed anymore
+		n_entries -= s.size();
+		std::vector<uint32_t>().swap(s);
 	}
+
+	AA_METRICS_SCRATCH(fill, max_entries * sizeof(uint32_t) + succ.size() * sizeof(succ[0]));
+
+	AA_PROBE3(fill_return, order.size(), n_merges, n_fill_in);
 }
 
 /**
@@ -85,64 +149,126 @@ void fill(Graph &g, const VertexOrder<Graph> &order) {
  * @param g     graph to compute the chordal completion of
  * @param order ordered sequence of vertices of the graph
  * @return edges of the fill-in of the graph as pairs of vertices
+ * @tparam Containers container policy (see vertex_map.h)
+ *
+ * Probes: fill_in_entry(V, E), fill_successors(V, successors), then for each
+ * merge of successors fill_merge(index, fill-in edges) and, at the end of the
+ * elimination, fill_in_return(V, successor merges, fill-in edges).
  *
  * @pre  `g` is a simple, connected, undirected graph; `order` is an ordered
- *       sequence of the vertices of `g`
+ *       sequence of the vertices of `g`; `g` has less than 2^32 vertices
  */
-template <class Graph>
+template <class Graph, class Containers = DefaultContainers>
 EdgeSet<Graph> fill_in(const Graph &g, const VertexOrder<Graph> &order) {
-	typedef typename VertexOrder<Graph>::value_type Vertex;
-	typedef typename VertexOrder<Graph>::size_type Index;
-
 	BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<Graph>));
 	BOOST_CONCEPT_ASSERT((boost::AdjacencyGraphConcept<Graph>));
+	AA_METRICS_CALL(fill_in, order.size(), num_edges(g));
 
-	const auto n_vertices = boost::num_vertices(g);
-	std::unordered_map<Vertex, Index> index_of(n_vertices);
-	std::unordered_map<Vertex, std::unordered_set<Vertex>> succ(n_vertices);
+	AA_PROBE2(fill_in_entry, order.size(), num_edges(g));
+
+	auto succ = successor_lists<Graph, Containers>(g, order);
+	std::vector<uint32_t> deficiency;
+	std::vector<uint32_t> merged;
 	EdgeSet<Graph> fill_in_edges;
+	size_t n_merges = 0;
+	// Number of successors stored, at most E + fill-in
+	size_t n_entries = num_edges(g), max_entries = n_entries;
 
-	for (Index i = 0; i < order.size(); i++)
-		index_of[order[i]] = i;
+	// For each vertex v in the order
+	for (uint32_t i = 0; i < succ.size(); i++) {
+		auto &s = succ[i];
+
+		// Vertices without successors (last of their connected component) do
+		// not produce any fill-in
+		if (s.empty())
+			continue;
+
+		// The closest successor of v in the order is the first one
+		const auto closest_vertex = order[s.front()];
+		auto &closest = succ[s.front()];
+
+		// Compute the successors of v that are not also successors of closest,
+		// add them to the fill-in and mark them as successors of closest
+		deficiency.resize(s.size() - 1);
+		deficiency.resize(sorted_difference(s.data() + 1, s.data() + s.size(),
+			closest.data(), closest.data() + closest.size(), deficiency.data()) - deficiency.data());
+
+		if (!deficiency.empty()) {
+			for (const auto pos : deficiency) {
+				const auto w = order[pos];
+
+				if (closest_vertex < w)
+					fill_in_edges.emplace(closest_vertex, w);
+				else
+					fill_in_edges.emplace(w, closest_vertex);
+			}
+
+			merged.resize(closest.size() + deficiency.size());
+			sorted_merge(closest.data(), closest.data() + closest.size(),
+				deficiency.data(), deficiency.data() + deficiency.size(), merged.data());
+			closest.swap(merged);
+			n_merges++;
+			n_entries += deficiency.size();
+			max_entries = std::max(max_entries, n_entries);
 
-	// Compute initial sets of successors: w is successor of v iff v--w and v
-	// comes before w in the given order
-	for (const auto v : iter_vertices(g)) {
-		for (const auto w : iter_neighbors(g, v)) {
-			if (index_of[v] < index_of[w])
-				succ[v].insert(w);
+			AA_PROBE2(fill_merge, i, deficiency.size());
 		}
+
+		// The successors of v are not needed anymore
+		n_entries -= s.size();
+		std::vector<uint32_t>().swap(s);
 	}
 
-	// For each vertex v in the order
-	for (auto it = order.begin(); it != order.end() - 1; it++) {
-		const Vertex v = *it;
-		Index min_index = n_vertices;
-		Vertex closest;
-
-		// Find the closest successor of v in the order
-		for (const auto w : succ[v]) {
-			if (index_of[w] < min_index)
-				min_index = index_of[w];
-		}
+	AA_METRICS_SCRATCH(fill_in, max_entries * sizeof(uint32_t) + succ.size() * sizeof(succ[0]));
+
+	AA_PROBE3(fill_in_return, order.size(), n_merges, fill_in_edges.size());
+	return fill_in_edges;
+}
+
+/**
+ * Count the edges of the fill-in of an ordered graph. This is the same function
+ * as fill_in(), only that it does not store the edges.
+ *
+ * @param  g     graph to compute the fill-in of
+ * @param  order ordered sequence of vertices of the graph
+ * @return number of edges of the fill-in of the graph
+ * @tparam Containers container policy (see vertex_map.h)
+ *
+ * @pre `g` is a simple, undirected graph; `order` is an ordered sequence of the
+ *      vertices of `g`; `g` has less than 2^32 vertices
+ */
+template <class Graph, class Containers = DefaultContainers>
+size_t fill_in_count(const Graph &g, const VertexOrder<Graph> &order) {
+	BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<Graph>));
+	BOOST_CONCEPT_ASSERT((boost::AdjacencyGraphConcept<Graph>));
 
-		closest = order[min_index];
+	auto succ = successor_lists<Graph, Containers>(g, order);
+	std::vector<uint32_t> deficiency;
+	std::vector<uint32_t> merged;
+	size_t count = 0;
 
-		// Mark any other successor of v as a successor of closest and add new
-		// edges to the fill-in as necessary
-		for (const auto w : succ[v]) {
-			if (w != closest && succ[closest].find(w) == succ[closest].end()) {
-				succ[closest].insert(w);
+	for (auto &s : succ) {
+		if (s.empty())
+			continue;
 
-				if (closest < w)
-					fill_in_edges.emplace(closest, w);
-				else
-					fill_in_edges.emplace(w, closest);
-			}
+		auto &closest = succ[s.front()];
+
+		deficiency.resize(s.size() - 1);
+		deficiency.resize(sorted_difference(s.data() + 1, s.data() + s.size(),
+			closest.data(), closest.data() + closest.size(), deficiency.data()) - deficiency.data());
+
+		if (!deficiency.empty()) {
+			count += deficiency.size();
+			merged.resize(closest.size() + deficiency.size());
+			sorted_merge(closest.data(), closest.data() + closest.size(),
+				deficiency.data(), deficiency.data() + deficiency.size(), merged.data());
+			closest.swap(merged);
 		}
+
+		std::vector<uint32_t>().swap(s);
 	}
 
-	return fill_in_edges;
+	return count;
 }
 
 /**
@@ -153,54 +279,33 @@ EdgeSet<Graph> fill_in(const Graph &g, const VertexOrder<Graph> &order) {
  * @param  g     graph
  * @param  order ordered sequence of vertices of the graph
  * @return true/false whether `order` is a perfect elimination order for `g`
+ * @tparam Containers container policy (see vertex_map.h)
  *
- * @pre `g` is a simple, connected, undirected graph
+ * @pre `g` is a simple, connected, undirected graph; `g` has less than 2^32
+ *      vertices
  */
-template <class Graph>
+template <class Graph, class Containers = DefaultContainers>
 bool is_perfect_elimination_order(const Graph &g, const VertexOrder<Graph> &order) {
-	typedef typename VertexOrder<Graph>::value_type Vertex;
-	typedef typename VertexOrder<Graph>::size_type Index;
-
 	BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<Graph>));
 	BOOST_CONCEPT_ASSERT((boost::AdjacencyGraphConcept<Graph>));
 
-	const auto n_vertices = boost::num_vertices(g);
-	std::unordered_map<Vertex, Index> index_of(n_vertices);
-	std::unordered_map<Vertex, std::unordered_set<Vertex>> succ(n_vertices);
-
-	for (Index i = 0; i < order.size(); i++)
-		index_of[order[i]] = i;
-
-	// Compute initial sets of successors: w is successor of v iff v--w and v
-	// comes before w in the given order
-	for (const auto v : iter_vertices(g)) {
-		for (const auto w : iter_neighbors(g, v)) {
-			if (index_of[v] < index_of[w])
-				succ[v].insert(w);
-		}
-	}
+	const auto succ = successor_lists<Graph, Containers>(g, order);
 
 	// For each vertex v in the order
-	for (auto it = order.begin(); it != order.end() - 1; it++) {
-		const Vertex v = *it;
-		Index min_index = n_vertices;
-		Vertex closest;
-
-		// Find the closest successor of v in the order
-		for (const auto w : succ[v]) {
-			if (index_of[w] < min_index)
-				min_index = index_of[w];
-		}
+	for (const auto &s : succ) {
+		// Vertices without successors (last of their connected component) do
+		// not produce any fill-in
+		if (s.empty())
+			continue;
 
-		closest = order[min_index];
+		const auto &closest = succ[s.front()];
 
 		// If there is any other successor w of v that is not also a successor
 		// of closest then the given order was not a perfect elimination order,
-		// as the edge closest--w would be part of the deficiency of v.
-		for (const auto w : succ[v]) {
-			if (w != closest && succ[closest].find(w) == succ[closest].end())
-				return false;
-		}
+		// as the edge closest--w would be part of the deficiency of v. Since
+		// no fill-in is produced otherwise, successors never change.
+		if (!sorted_includes(closest.data(), closest.data() + closest.size(), s.data() + 1, s.data() + s.size()))
+			return false;
 	}
 
 	return true;
@@ -0,0 +1,159 @@
+/**
+ * Queries of single fill-in edges of an ordered graph, answered on the
+ * elimination tree without computing the fill-in.
+ */
+
+#ifndef ALGO_FILL_ORACLE_H
+#define ALGO_FILL_ORACLE_H
+
+#include <tuple>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <boost/graph/graph_concepts.hpp>
+
+#include "utils.h"
+#include "vertex_map.h"
+#include "etree.h"
+
+/**
+ * Oracle telling whether pairs of vertices are edges of the filled graph of an
+ * ordered graph. By the fill path theorem, u--v with u before v is an edge of
+ * the filled graph iff v has an earlier neighbor w in the original graph such
+ * that u is an ancestor of w (or w itself) in the elimination tree, i.e. iff
+ * some earlier neighbor of v is in the subtree of u.
+ *
+ * Numbering the elimination tree in postorder, each subtree is an interval of
+ * numbers, so each query is a binary search in the sorted numbers of the
+ * earlier neighbors of v, after building the tree in almost linear time.
+ * Memory is O(V+E).
+ */
+template <class Graph>
+class FillOracle {
+public:
+	typedef VertexDesc<Graph> Vertex;
+
+	/**
+	 * @param g     graph
+	 * @param order elimination order
+	 *
+	 * @pre `g` is a simple, undirected graph; `order` is an ordered sequence of
+	 *      the vertices of `g`; `g` has less than 2^32 - 1 vertices
+	 */
+	FillOracle(const Graph &g, const VertexOrder<Graph> &order)
+		: index_of_(g), number_(order.size()), size_(order.size(), 1), offsets_(1, 0)
+	{
+		BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<Graph>));
+		BOOST_CONCEPT_ASSERT((boost::AdjacencyGraphConcept<Graph>));
+
+		constexpr unsigned none = EliminationTree::none;
+		const unsigned n = order.size();
+		const auto tree = make_elimination_tree(g, order);
+		std::vector<unsigned> next(n);
+
+		for (unsigned j = 0; j < n; j++)
+			index_of_[order[j]] = j;
+
+		// Parents come after their children
+		for (unsigned j = 0; j < n; j++) {
+			if (tree.parent[j] != none)
+				size_[tree.parent[j]] += size_[j];
+		}
+
+		// Give each subtree an interval of numbers, ending with its root, and
+		// the next free part of it to the following child
+		for (unsigned j = n, next_root = 0; j-- > 0;) {
+			const unsigned p = tree.parent[j];
+			unsigned &first = p == none ? next_root : next[p];
+
+			next[j] = first;
+			number_[j] = first + size_[j] - 1;
+			first += size_[j];
+		}
+
+		for (unsigned j = 0; j < n; j++) {
+			const size_t begin = numbers_.size();
+
+			for (const auto w : iter_neighbors(g, order[j])) {
+				const unsigned i = index_of_[w];
+
+				if (i < j)
+					numbers_.push_back(number_[i]);
+			}
+
+			std::sort(numbers_.begin() + begin, numbers_.end());
+			offsets_.push_back(numbers_.size());
+		}
+	}
+
+	/**
+	 * @return true/false whether u--v is an edge of the filled graph, either
+	 *         original or fill-in
+	 */
+	bool is_filled_edge(Vertex u, Vertex v) const {
+		const auto [root, last, it] = find(u, v);
+
+		return it != last;
+	}
+
+	/**
+	 * @return true/false whether u--v is a fill-in edge, i.e. an edge of the
+	 *         filled graph but not of the original graph
+	 */
+	bool is_fill_edge(Vertex u, Vertex v) const {
+		const auto [root, last, it] = find(u, v);
+
+		// The root of the subtree, if present, is the last one and an original
+		// neighbor
+		return it != last && *(last - 1) != root;
+	}
+
+	/**
+	 * @return whether each pair of vertices is a fill-in edge (see above)
+	 */
+	std::vector<bool> is_fill_edge(const std::vector<std::pair<Vertex, Vertex>> &queries) const {
+		std::vector<bool> res(queries.size());
+
+		for (size_t i = 0; i < queries.size(); i++)
+			res[i] = is_fill_edge(queries[i].first, queries[i].second);
+
+		return res;
+	}
+
+private:
+	typedef std::vector<unsigned>::const_iterator Iterator;
+
+	/**
+	 * Helper function: find the first earlier neighbor of the later vertex in
+	 * the subtree of the earlier one.
+	 *
+	 * @return the number of the earlier vertex (i.e. of the root of its
+	 *         subtree), the end of the numbers of the earlier neighbors of the
+	 *         later vertex up to it, and the first one in the subtree or the
+	 *         end
+	 */
+	std::tuple<unsigned, Iterator, Iterator> find(Vertex u, Vertex v) const {
+		unsigned a = index_of_[u], b = index_of_[v];
+
+		if (a > b)
+			std::swap(a, b);
+
+		const auto begin = numbers_.begin() + offsets_[b];
+		const auto end = numbers_.begin() + offsets_[b + 1];
+		const auto last = std::upper_bound(begin, end, number_[a]);
+		const auto it = std::lower_bound(begin, last, number_[a] - size_[a] + 1);
+
+		return {number_[a], last, it};
+	}
+
+	// Position of each vertex in the order, only read after construction
+	mutable VertexStateMap<Graph, unsigned> index_of_;
+	// Postorder number of each vertex and size of its subtree
+	std::vector<unsigned> number_;
+	std::vector<unsigned> size_;
+	// Sorted numbers of the earlier neighbors of each vertex
+	std::vector<size_t> offsets_;
+	std::vector<unsigned> numbers_;
+};
+
+#endif // ALGO_FILL_ORACLE_H
@@ -0,0 +1,361 @@
+/**
+ * Open-addressing hash containers in the style of Swiss tables, used for the
+ * per-vertex state of the algorithms when graphs have no vertex index.
+ *
+ * See: https://abseil.io/about/design/swisstables
+ */
+
+#ifndef FLAT_HASH_H
+#define FLAT_HASH_H
+
+#include <cstdint>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * Hash table with open addressing storing elements of type Slot, identified by
+ * keys of type Key extracted with KeyOf.
+ *
+ * Each slot has a control byte which is either empty, deleted or holds the 7
+ * lowest bits of the hash of the key of the element in the slot (H2), while
+ * the other bits of the hash (H1) select the first group of 16 slots to probe,
+ * followed by the next groups. The control bytes of a whole group are compared
+ * with H2 at once (with SSE2 if available), so that keys only need to be
+ * compared for likely matches.
+ *
+ * The number of groups is not restricted to powers of two, so that reserving
+ * room for n elements (e.g. one per vertex) takes just above n slots.
+ */
+template <class Key, class Slot, class KeyOf, class Hash>
+class FlatHashTable {
+public:
+	FlatHashTable() = default;
+
+	FlatHashTable(const FlatHashTable &other) {
+		reserve(other.size_);
+		other.for_each_slot([this](const Slot &s) {
+			insert_new(KeyOf()(s), s);
+		});
+	}
+
+	FlatHashTable(FlatHashTable &&other) noexcept {
+		swap(other);
+	}
+
+	FlatHashTable &operator=(FlatHashTable other) noexcept {
+		swap(other);
+		return *this;
+	}
+
+	~FlatHashTable() {
+		destroy();
+	}
+
+	void swap(FlatHashTable &other) noexcept {
+		std::swap(ctrl_, other.ctrl_);
+		std::swap(slots_, other.slots_);
+		std::swap(n_groups_, other.n_groups_);
+		std::swap(size_, other.size_);
+		std::swap(growth_left_, other.growth_left_);
+	}
+
+	size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+
+	/**
+	 * Make room for at least n elements without rehashing.
+	 */
+	void reserve(size_t n) {
+		if (n > size_ + growth_left_)
+			rehash(n);
+	}
+
+	/**
+	 * Remove all the elements, keeping the allocated memory.
+	 */
+	void clear() {
+		for (size_t pos = 0; pos < n_groups_ * group_size; pos++) {
+			if (ctrl_[pos] >= 0) {
+				slots_[pos].~Slot();
+				ctrl_[pos] = empty_ctrl;
+			} else if (ctrl_[pos] == deleted_ctrl) {
+				ctrl_[pos] = empty_ctrl;
+			}
+		}
+
+		size_ = 0;
+		growth_left_ = n_groups_ * group_load;
+	}
+
+	/**
+	 * @return pointer to the element with the given key, or nullptr
+	 */
+	Slot *find(const Key &key) const {
+		if (!ctrl_)
+			return nullptr;
+
+		const uint64_t h = hash(key);
+
+		for (size_t g = first_group(h); ; g = next_group(g)) {
+			const int8_t *group = ctrl_ + g * group_size;
+
+			for (uint32_t m = match(group, h2(h)); m; m &= m - 1) {
+				const size_t pos = g * group_size + __builtin_ctz(m);
+
+				if (KeyOf()(slots_[pos]) == key)
+					return slots_ + pos;
+			}
+
+			if (match(group, empty_ctrl))
+				return nullptr;
+		}
+	}
+
+	/**
+	 * Insert a new element constructed from args if none with the given key
+	 * exists.
+	 *
+	 * @return pointer to the element with the given key, and true/false
+	 *         whether it was inserted
+	 */
+	template <class... Args>
+	std::pair<Slot *, bool> try_emplace(const Key &key, Args &&...args) {
+		Slot *s = find(key);
+
+		if (s)
+			return {s, false};
+
+		return {insert_new(key, std::forward<Args>(args)...), true};
+	}
+
+	/**
+	 * @return true/false whether the element with the given key was erased
+	 */
+	bool erase(const Key &key) {
+		Slot *s = find(key);
+
+		if (!s)
+			return false;
+
+		const size_t pos = s - slots_;
+		s->~Slot();
+		ctrl_[pos] = deleted_ctrl;
+		size_--;
+		return true;
+	}
+
+	template <class F>
+	void for_each_slot(F f) const {
+		for (size_t pos = 0; pos < n_groups_ * group_size; pos++) {
+			if (ctrl_[pos] >= 0)
+				f(slots_[pos]);
+		}
+	}
+
+private:
+	static constexpr size_t group_size = 16;
+	// Maximum number of elements per group on average
+	static constexpr size_t group_load = group_size * 7 / 8;
+	static constexpr int8_t empty_ctrl = -128;
+	static constexpr int8_t deleted_ctrl = -2;
+
+	static uint64_t hash(const Key &key) {
+		// Mix the bits, as std::hash is the identity for integers and pointers
+		uint64_t h = static_cast<uint64_t>(Hash()(key)) * 0x9e3779b97f4a7c15ULL;
+		return h ^ (h >> 32);
+	}
+
+	static size_t h1(uint64_t h) { return h >> 7; }
+	static int8_t h2(uint64_t h) { return h & 0x7f; }
+
+	// The upper 32 bits of H1 scaled to [0, n_groups_) without a division
+	size_t first_group(uint64_t h) const {
+		return ((h1(h) >> 25) * n_groups_) >> 32;
+	}
+
+	size_t next_group(size_t g) const {
+		return g + 1 < n_groups_ ? g + 1 : 0;
+	}
+
+	/**
+	 * @return bitmask of the control bytes of the group equal to c
+	 */
+	static uint32_t match(const int8_t *group, int8_t c) {
+#ifdef __SSE2__
+		const __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(c)));
+#else
+		uint32_t res = 0;
+
+		for (size_t i = 0; i < group_size; i++)
+			res |= uint32_t(group[i] == c) << i;
+
+		return res;
+#endif
+	}
+
+	/**
+	 * @return bitmask of the empty or deleted control bytes of the group
+	 */
+	static uint32_t match_free(const int8_t *group) {
+#ifdef __SSE2__
+		const __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+		return _mm_movemask_epi8(ctrl);
+#else
+		uint32_t res = 0;
+
+		for (size_t i = 0; i < group_size; i++)
+			res |= uint32_t(group[i] < 0) << i;
+
+		return res;
+#endif
+	}
+
+	/**
+	 * Insert a new element, knowing that none with the same key exists.
+	 */
+	template <class... Args>
+	Slot *insert_new(const Key &key, Args &&...args) {
+		// Grow geometrically, dropping the deleted slots
+		if (growth_left_ == 0)
+			rehash(2 * size_ + 1);
+
+		const uint64_t h = hash(key);
+
+		for (size_t g = first_group(h); ; g = next_group(g)) {
+			const uint32_t m = match_free(ctrl_ + g * group_size);
+
+			if (m) {
+				const size_t pos = g * group_size + __builtin_ctz(m);
+
+				// Reusing a deleted slot does not reduce the room left
+				if (ctrl_[pos] == empty_ctrl)
+					growth_left_--;
+
+				new (slots_ + pos) Slot(std::forward<Args>(args)...);
+				ctrl_[pos] = h2(h);
+				size_++;
+				return slots_ + pos;
+			}
+		}
+	}
+
+	/**
+	 * Move all the elements to a new table with room for at least n elements
+	 * (and no deleted slots), keeping the load factor below 7/8.
+	 */
+	void rehash(size_t n) {
+		const size_t n_groups = std::max<size_t>((std::max(n, size_) + group_load - 1) / group_load, 1);
+
+		assert(n_groups <= UINT32_MAX);
+
+		FlatHashTable t;
+		t.n_groups_ = n_groups;
+		t.ctrl_ = new int8_t[n_groups * group_size];
+		t.slots_ = std::allocator<Slot>().allocate(n_groups * group_size);
+		t.growth_left_ = n_groups * group_load;
+		std::memset(t.ctrl_, empty_ctrl, n_groups * group_size);
+
+		for (size_t pos = 0; pos < n_groups_ * group_size; pos++) {
+			if (ctrl_[pos] >= 0)
+				t.insert_new(KeyOf()(slots_[pos]), std::move(slots_[pos]));
+		}
+
+		swap(t);
+	}
+
+	void destroy() {
+		if (!ctrl_)
+			return;
+
+		for (size_t pos = 0; pos < n_groups_ * group_size; pos++) {
+			if (ctrl_[pos] >= 0)
+				slots_[pos].~Slot();
+		}
+
+		std::allocator<Slot>().deallocate(slots_, n_groups_ * group_size);
+		delete[] ctrl_;
+	}
+
+	int8_t *ctrl_ = nullptr;
+	Slot *slots_ = nullptr;
+	size_t n_groups_ = 0;
+	size_t size_ = 0;
+	size_t growth_left_ = 0;
+};
+
+template <class Key>
+struct FlatHashSetKeyOf {
+	const Key &operator()(const Key &k) const { return k; }
+};
+
+template <class Key, class Value>
+struct FlatHashMapKeyOf {
+	const Key &operator()(const std::pair<Key, Value> &s) const { return s.first; }
+};
+
+/**
+ * Set of keys stored in a FlatHashTable, with the same interface of
+ * std::unordered_set for the operations the algorithms need.
+ */
+template <class Key, class Hash = std::hash<Key>>
+class FlatHashSet {
+public:
+	FlatHashSet() = default;
+	FlatHashSet(size_t n) { table_.reserve(n); }
+
+	std::pair<const Key *, bool> insert(const Key &key) {
+		return table_.try_emplace(key, key);
+	}
+
+	size_t erase(const Key &key) { return table_.erase(key); }
+	size_t count(const Key &key) const { return table_.find(key) != nullptr; }
+	size_t size() const { return table_.size(); }
+	bool empty() const { return table_.empty(); }
+	void clear() { table_.clear(); }
+	void reserve(size_t n) { table_.reserve(n); }
+
+private:
+	FlatHashTable<Key, Key, FlatHashSetKeyOf<Key>, Hash> table_;
+};
+
+/**
+ * Map of keys to values stored in a FlatHashTable, with the same interface of
+ * std::unordered_map for the operations the algorithms need.
+ */
+template <class Key, class Value, class Hash = std::hash<Key>>
+class FlatHashMap {
+public:
+	typedef Key key_type;
+	typedef Value mapped_type;
+
+	FlatHashMap() = default;
+	FlatHashMap(size_t n) { table_.reserve(n); }
+
+	Value &operator[](const Key &key) {
+		return table_.try_emplace(key, std::piecewise_construct, std::forward_as_tuple(key),
+			std::forward_as_tuple()).first->second;
+	}
+
+	size_t erase(const Key &key) { return table_.erase(key); }
+	size_t count(const Key &key) const { return table_.find(key) != nullptr; }
+	size_t size() const { return table_.size(); }
+	bool empty() const { return table_.empty(); }
+	void clear() { table_.clear(); }
+	void reserve(size_t n) { table_.reserve(n); }
+
+private:
+	FlatHashTable<Key, std::pair<Key, Value>, FlatHashMapKeyOf<Key, Value>, Hash> table_;
+};
+
+#endif // FLAT_HASH_H
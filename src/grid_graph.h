@@ -0,0 +1,305 @@
+/**
+ * Implicit graphs of regular structured grids, whose neighbors are computed
+ * from the coordinates of the vertices instead of being stored.
+ */
+
+#ifndef GRID_GRAPH_H
+#define GRID_GRAPH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <cassert>
+#include <algorithm>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+
+/**
+ * Simple, undirected graph of a Dims-dimensional grid of points, where each
+ * point is adjacent to the points at the offsets given by a stencil, modeling
+ * the VertexListGraph and AdjacencyGraph concepts of the Boost Graph Library.
+ * Only the sizes of the grid and the stencil are stored, so the graph takes
+ * constant memory.
+ *
+ * Vertices are the integers in [0, num_vertices(g)), numbered with the first
+ * coordinate varying fastest, and are their own indices.
+ */
+template <unsigned Dims, class Index = unsigned>
+class GridGraph {
+public:
+	typedef std::array<Index, Dims> Coords;
+	typedef std::array<int, Dims> Offset;
+	typedef std::vector<Offset> Stencil;
+
+	class adjacency_iterator;
+
+	typedef Index vertex_descriptor;
+	typedef std::pair<Index, Index> edge_descriptor;
+	typedef boost::undirected_tag directed_category;
+	typedef boost::disallow_parallel_edge_tag edge_parallel_category;
+	typedef boost::counting_iterator<Index> vertex_iterator;
+	typedef Index vertices_size_type;
+	typedef std::size_t edges_size_type;
+	typedef unsigned degree_size_type;
+
+	struct traversal_category :
+		virtual boost::vertex_list_graph_tag,
+		virtual boost::adjacency_graph_tag {};
+
+	static_assert(Dims > 0);
+	static_assert(!std::numeric_limits<Index>::is_signed);
+
+	/**
+	 * @param sizes   number of points along each dimension
+	 * @param stencil offsets of the neighbors of each point
+	 *
+	 * @pre the product of `sizes` fits in Index; `stencil` does not contain
+	 *      the zero offset or duplicates, and contains the opposite of each
+	 *      of its offsets
+	 */
+	GridGraph(const Coords &sizes, Stencil stencil = star_stencil())
+		: sizes_(sizes), stencil_(std::move(stencil)), linear_(stencil_.size())
+	{
+		Index stride = 1;
+
+		for (unsigned d = 0; d < Dims; d++) {
+			strides_[d] = stride;
+			stride *= sizes_[d];
+			radius_[d] = 0;
+		}
+
+		n_vertices_ = stride;
+
+		for (size_t k = 0; k < stencil_.size(); k++) {
+			assert(std::count(stencil_.begin(), stencil_.end(), opposite(stencil_[k])) == 1);
+			assert(stencil_[k] != Offset{});
+
+			linear_[k] = 0;
+
+			for (unsigned d = 0; d < Dims; d++) {
+				linear_[k] += std::ptrdiff_t(stencil_[k][d]) * std::ptrdiff_t(strides_[d]);
+				radius_[d] = std::max<Index>(radius_[d], std::abs(stencil_[k][d]));
+			}
+		}
+	}
+
+	/**
+	 * Stencil of the neighbors along the axes, i.e. the 5-point stencil in 2D
+	 * and the 7-point stencil in 3D.
+	 */
+	static Stencil star_stencil() {
+		Stencil s;
+
+		for (unsigned d = 0; d < Dims; d++) {
+			for (const int step : {-1, 1}) {
+				Offset o{};
+				o[d] = step;
+				s.push_back(o);
+			}
+		}
+
+		return s;
+	}
+
+	/**
+	 * Stencil of all the neighbors within distance 1 along each axis, i.e. the
+	 * 9-point stencil in 2D and the 27-point stencil in 3D.
+	 */
+	static Stencil box_stencil() {
+		Stencil s;
+		Offset o;
+
+		o.fill(-1);
+
+		// Count in base 3 with digits in [-1, 1]
+		for (;;) {
+			if (o != Offset{})
+				s.push_back(o);
+
+			unsigned d = 0;
+
+			for (; d < Dims && o[d] == 1; d++)
+				o[d] = -1;
+
+			if (d == Dims)
+				return s;
+
+			o[d]++;
+		}
+	}
+
+	const Coords &sizes() const { return sizes_; }
+	const Stencil &stencil() const { return stencil_; }
+
+	/**
+	 * @return the coordinates of the given vertex
+	 */
+	Coords coords(Index v) const {
+		Coords c;
+
+		for (unsigned d = 0; d < Dims; d++) {
+			c[d] = v % sizes_[d];
+			v /= sizes_[d];
+		}
+
+		return c;
+	}
+
+	/**
+	 * @return the vertex at the given coordinates
+	 */
+	Index vertex(const Coords &c) const {
+		Index v = 0;
+
+		for (unsigned d = 0; d < Dims; d++)
+			v += c[d] * strides_[d];
+
+		return v;
+	}
+
+	/**
+	 * Iterator over the neighbors of a vertex, skipping the offsets of the
+	 * stencil falling outside of the grid. Vertices far enough from the
+	 * boundary (the vast majority in large grids) skip the bounds checks.
+	 */
+	class adjacency_iterator : public boost::iterator_facade<adjacency_iterator, Index,
+		boost::forward_traversal_tag, Index>
+	{
+	public:
+		adjacency_iterator() : g_(nullptr), v_(0), k_(0), interior_(true) {}
+
+		adjacency_iterator(const GridGraph *g, Index v, size_t k)
+			: g_(g), v_(v), coords_(g->coords(v)), k_(k), interior_(g->is_interior(coords_))
+		{
+			skip();
+		}
+
+	private:
+		friend class boost::iterator_core_access;
+
+		void skip() {
+			if (!interior_) {
+				while (k_ < g_->stencil_.size() && !g_->in_bounds(coords_, k_))
+					k_++;
+			}
+		}
+
+		void increment() {
+			k_++;
+			skip();
+		}
+
+		Index dereference() const {
+			return Index(std::ptrdiff_t(v_) + g_->linear_[k_]);
+		}
+
+		bool equal(const adjacency_iterator &other) const {
+			return k_ == other.k_;
+		}
+
+		const GridGraph *g_;
+		Index v_;
+		Coords coords_;
+		size_t k_;
+		bool interior_;
+	};
+
+	static vertex_descriptor null_vertex() {
+		return std::numeric_limits<Index>::max();
+	}
+
+	friend Index num_vertices(const GridGraph &g) {
+		return g.n_vertices_;
+	}
+
+	// Each offset s of the stencil joins the prod(sizes[d] - |s[d]|) points
+	// having a neighbor at s, and s and -s give the same edges
+	friend std::size_t num_edges(const GridGraph &g) {
+		std::size_t n = 0;
+
+		for (const auto &s : g.stencil_) {
+			std::size_t n_points = 1;
+
+			for (unsigned d = 0; d < Dims; d++) {
+				const Index a = std::abs(s[d]);
+				n_points *= g.sizes_[d] > a ? g.sizes_[d] - a : 0;
+			}
+
+			n += n_points;
+		}
+
+		return n / 2;
+	}
+
+	friend std::pair<vertex_iterator, vertex_iterator> vertices(const GridGraph &g) {
+		return {vertex_iterator(0), vertex_iterator(g.n_vertices_)};
+	}
+
+	friend std::pair<adjacency_iterator, adjacency_iterator> adjacent_vertices(Index v, const GridGraph &g) {
+		return {adjacency_iterator(&g, v, 0), adjacency_iterator(&g, v, g.stencil_.size())};
+	}
+
+	friend unsigned degree(Index v, const GridGraph &g) {
+		const Coords c = g.coords(v);
+
+		if (g.is_interior(c))
+			return g.stencil_.size();
+
+		unsigned n = 0;
+
+		for (size_t k = 0; k < g.stencil_.size(); k++)
+			n += g.in_bounds(c, k);
+
+		return n;
+	}
+
+	// Vertices are their own indices
+	friend boost::typed_identity_property_map<Index> get(boost::vertex_index_t, const GridGraph &) {
+		return {};
+	}
+
+private:
+	static Offset opposite(Offset o) {
+		for (auto &x : o)
+			x = -x;
+
+		return o;
+	}
+
+	// Whether all the neighbors of the point are in the grid
+	bool is_interior(const Coords &c) const {
+		for (unsigned d = 0; d < Dims; d++) {
+			if (c[d] < radius_[d] || sizes_[d] - c[d] <= radius_[d])
+				return false;
+		}
+
+		return true;
+	}
+
+	// Whether the k-th neighbor of the point is in the grid
+	bool in_bounds(const Coords &c, size_t k) const {
+		for (unsigned d = 0; d < Dims; d++) {
+			const std::ptrdiff_t x = std::ptrdiff_t(c[d]) + stencil_[k][d];
+
+			if (x < 0 || x >= std::ptrdiff_t(sizes_[d]))
+				return false;
+		}
+
+		return true;
+	}
+
+	Coords sizes_;
+	Coords strides_;
+	Coords radius_;
+	Index n_vertices_;
+	Stencil stencil_;
+	std::vector<std::ptrdiff_t> linear_;
+};
+
+#endif // GRID_GRAPH_H
@@ -0,0 +1,173 @@
+/**
+ * Symbolic incomplete Cholesky/LU factorization with level of fill k (ILU(k)):
+ * computation of the entries of the factors whose level of fill is at most k.
+ *
+ * Original entries have level 0, and eliminating vertex u gives the entry v--w
+ * level min(level(v, w), level(v, u) + level(u, w) + 1). By the fill path
+ * theorem of Hysom & Pothen, v--w (with v before w) has level l iff the
+ * shortest path from v to w whose inner vertices all come before v in the
+ * order has length l + 1, so each column of the factor is computed on its own
+ * with a breadth-first search, which lets columns be computed in parallel.
+ *
+ * See: https://doi.org/10.1137/S1064827500376193
+ */
+
+#ifndef ALGO_ILUK_H
+#define ALGO_ILUK_H
+
+#include <limits>
+#include <vector>
+#include <utility>
+#include <cassert>
+#include <algorithm>
+#include <boost/graph/graph_concepts.hpp>
+
+#include "utils.h"
+#include "vertex_map.h"
+#include "parallel.h"
+#include "probes.h"
+
+/**
+ * Structure of the strictly lower triangle of an ILU(k) factor of a symmetric
+ * matrix whose sparsity pattern is the one of a graph with vertices permuted
+ * according to an elimination order, along with the level of each entry.
+ *
+ * Row and column j of the matrix correspond to the j-th vertex of the order.
+ * The entries of column j are at positions [col_ptr[j], col_ptr[j + 1]) of
+ * row_ind (ascending) and level.
+ */
+struct IlukPattern {
+	size_t n = 0;
+	std::vector<size_t> col_ptr;
+	std::vector<unsigned> row_ind;
+	std::vector<unsigned> level;
+};
+
+/**
+ * Compute the ILU(k) pattern for the given ordered graph.
+ *
+ * @param  g         graph with the sparsity pattern of the matrix
+ * @param  order     elimination order, i.e. permutation of the rows/columns
+ * @param  max_level maximum level of fill k of the entries to keep
+ * @param  n_threads number of threads computing columns
+ * @return the pattern, which is the full chordal completion for k >= V - 2
+ *
+ * Probes: iluk_entry(V, E, k) and iluk_return(V, entries).
+ *
+ * @pre `g` is a simple, undirected graph; `order` is an ordered sequence of
+ *      the vertices of `g`; `g` has less than 2^32 vertices; `n_threads` > 0
+ */
+template <class Graph>
+IlukPattern symbolic_iluk(const Graph &g, const VertexOrder<Graph> &order, unsigned max_level, unsigned n_threads = 1) {
+	BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<Graph>));
+	BOOST_CONCEPT_ASSERT((boost::AdjacencyGraphConcept<Graph>));
+
+	// Columns computed by each task, small enough for load balancing
+	constexpr unsigned task_size = 256;
+
+	const unsigned n = order.size();
+	VertexStateMap<Graph, unsigned> index_of(g);
+	std::vector<size_t> adj_ptr(n + 1, 0);
+	std::vector<unsigned> adj;
+	IlukPattern pattern;
+
+	AA_PROBE3(iluk_entry, order.size(), num_edges(g), max_level);
+
+	assert(order.size() <= std::numeric_limits<unsigned>::max());
+	assert(n_threads > 0);
+
+	for (unsigned i = 0; i < n; i++)
+		index_of[order[i]] = i;
+
+	// Graph with vertices numbered by position in the order
+	for (unsigned i = 0; i < n; i++) {
+		for (const auto w : iter_neighbors(g, order[i]))
+			adj.push_back(index_of[w]);
+
+		adj_ptr[i + 1] = adj.size();
+	}
+
+	struct Task {
+		std::vector<unsigned> rows;
+		std::vector<unsigned> levels;
+	};
+
+	struct Scratch {
+		std::vector<unsigned> seen;
+		std::vector<unsigned> frontier, next;
+		std::vector<std::pair<unsigned, unsigned>> entries;
+	};
+
+	const size_t n_tasks = (size_t(n) + task_size - 1) / task_size;
+	std::vector<Task> tasks(n_tasks);
+	std::vector<Scratch> scratch(n_threads);
+
+	pattern.n = n;
+	pattern.col_ptr.resize(n + 1, 0);
+
+	parallel_tasks(n_tasks, n_threads, [&](unsigned thread, size_t t) {
+		Scratch &s = scratch[thread];
+		Task &task = tasks[t];
+		const unsigned first = t * task_size;
+		const unsigned last = std::min<size_t>(size_t(first) + task_size, n);
+
+		if (s.seen.empty())
+			s.seen.assign(n, std::numeric_limits<unsigned>::max());
+
+		for (unsigned j = first; j < last; j++) {
+			// Search from j through vertices before j, at distance d + 1
+			// finding the entries of level d
+			s.seen[j] = j;
+			s.frontier.assign(1, j);
+			s.entries.clear();
+
+			for (unsigned d = 0; d <= max_level && !s.frontier.empty(); d++) {
+				s.next.clear();
+
+				for (const auto u : s.frontier) {
+					for (size_t p = adj_ptr[u]; p < adj_ptr[u + 1]; p++) {
+						const unsigned w = adj[p];
+
+						if (s.seen[w] == j)
+							continue;
+
+						s.seen[w] = j;
+
+						if (w > j)
+							s.entries.emplace_back(w, d);
+						else if (d < max_level)
+							s.next.push_back(w);
+					}
+				}
+
+				s.frontier.swap(s.next);
+			}
+
+			std::sort(s.entries.begin(), s.entries.end());
+			pattern.col_ptr[j + 1] = s.entries.size();
+
+			for (const auto &[w, d] : s.entries) {
+				task.rows.push_back(w);
+				task.levels.push_back(d);
+			}
+		}
+	});
+
+	for (unsigned j = 0; j < n; j++)
+		pattern.col_ptr[j + 1] += pattern.col_ptr[j];
+
+	pattern.row_ind.reserve(pattern.col_ptr[n]);
+	pattern.level.reserve(pattern.col_ptr[n]);
+
+	for (auto &task : tasks) {
+		pattern.row_ind.insert(pattern.row_ind.end(), task.rows.begin(), task.rows.end());
+		pattern.level.insert(pattern.level.end(), task.levels.begin(), task.levels.end());
+		std::vector<unsigned>().swap(task.rows);
+		std::vector<unsigned>().swap(task.levels);
+	}
+
+	AA_PROBE2(iluk_return, order.size(), pattern.row_ind.size());
+	return pattern;
+}
+
+#endif // ALGO_ILUK_H
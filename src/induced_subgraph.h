@@ -0,0 +1,213 @@
+/**
+ * Views of induced subgraphs of graphs in compressed sparse row format,
+ * filtering the vertices with a bitmask instead of copying the subgraph.
+ */
+
+#ifndef INDUCED_SUBGRAPH_H
+#define INDUCED_SUBGRAPH_H
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <cassert>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+
+#include "utils.h"
+#include "csr_graph.h"
+
+/**
+ * Subgraph induced by a subset of the vertices of a CsrGraph or CsrGraphView,
+ * modeling the VertexListGraph and AdjacencyGraph concepts of the Boost Graph
+ * Library. The base graph is referenced, and must outlive the view.
+ *
+ * Vertices are the integers in [0, num_vertices(g)) and are their own indices:
+ * vertex i of the view is the i-th vertex of the subset in increasing order.
+ * The subset is stored as a bitmask over the vertices of the base graph, plus
+ * the number of vertices of the subset before each 64-bit word of the mask, so
+ * that the local id of a vertex of the base graph is computed with a popcount.
+ * Creating a view takes O(V / 64) time and memory for the mask plus O(E) time
+ * to count the edges of the subset, and neighbors outside of the subset are
+ * skipped while iterating. Hence views suit linear time algorithms and many
+ * small subsets best: LEX M, scanning the neighbors V times, runs about 40%
+ * slower than on a copy made with make_induced_csr_graph().
+ */
+template <class Base = CsrGraph<>>
+class InducedSubgraphView {
+public:
+	typedef typename Base::vertex_descriptor Index;
+	typedef typename Base::edges_size_type Offset;
+
+	class adjacency_iterator;
+
+	typedef Index vertex_descriptor;
+	typedef std::pair<Index, Index> edge_descriptor;
+	typedef boost::undirected_tag directed_category;
+	typedef boost::disallow_parallel_edge_tag edge_parallel_category;
+	typedef boost::counting_iterator<Index> vertex_iterator;
+	typedef Index vertices_size_type;
+	typedef Offset edges_size_type;
+	typedef Offset degree_size_type;
+
+	struct traversal_category :
+		virtual boost::vertex_list_graph_tag,
+		virtual boost::adjacency_graph_tag {};
+
+	/**
+	 * @param base   graph
+	 * @param subset sequence of (distinct) vertices of the graph, in any order
+	 */
+	InducedSubgraphView(const Base &base, const std::vector<Index> &subset)
+		: base_(&base), mask_((num_vertices(base) + 63) / 64), ranks_(mask_.size()), n_edges_(0)
+	{
+		for (const auto v : subset)
+			mask_[v / 64] |= uint64_t(1) << (v % 64);
+
+		Index rank = 0;
+
+		for (size_t i = 0; i < mask_.size(); i++) {
+			ranks_[i] = rank;
+			rank += __builtin_popcountll(mask_[i]);
+		}
+
+		assert(rank == subset.size());
+		globals_.reserve(rank);
+
+		for (size_t i = 0; i < mask_.size(); i++) {
+			for (uint64_t bits = mask_[i]; bits; bits &= bits - 1)
+				globals_.push_back(i * 64 + __builtin_ctzll(bits));
+		}
+
+		for (const auto v : globals_) {
+			for (const auto w : iter_neighbors(base, v))
+				n_edges_ += contains(w);
+		}
+
+		n_edges_ /= 2;
+	}
+
+	const Base &base() const { return *base_; }
+
+	/**
+	 * @return whether the given vertex of the base graph is in the subset
+	 */
+	bool contains(Index global) const {
+		return mask_[global / 64] >> (global % 64) & 1;
+	}
+
+	/**
+	 * @return the vertex of the view corresponding to the given vertex of the
+	 *         base graph
+	 *
+	 * @pre `global` is in the subset
+	 */
+	Index local(Index global) const {
+		const uint64_t below = (uint64_t(1) << (global % 64)) - 1;
+		return ranks_[global / 64] + __builtin_popcountll(mask_[global / 64] & below);
+	}
+
+	/**
+	 * @return the vertex of the base graph corresponding to the given vertex of
+	 *         the view
+	 */
+	Index global(Index local) const {
+		return globals_[local];
+	}
+
+	/**
+	 * @return the vertices of the base graph corresponding to the vertices of
+	 *         the view, i.e. the subset in increasing order
+	 */
+	const std::vector<Index> &globals() const { return globals_; }
+
+	/**
+	 * Iterator over the neighbors of a vertex in the base graph, skipping those
+	 * outside of the subset and translating the others to local ids.
+	 */
+	class adjacency_iterator : public boost::iterator_facade<adjacency_iterator, Index,
+		boost::forward_traversal_tag, Index>
+	{
+	public:
+		adjacency_iterator() : g_(nullptr), cur_(nullptr), end_(nullptr) {}
+
+		adjacency_iterator(const InducedSubgraphView *g, const Index *cur, const Index *end)
+			: g_(g), cur_(cur), end_(end)
+		{
+			skip();
+		}
+
+	private:
+		friend class boost::iterator_core_access;
+
+		void skip() {
+			while (cur_ != end_ && !g_->contains(*cur_))
+				cur_++;
+		}
+
+		void increment() {
+			cur_++;
+			skip();
+		}
+
+		Index dereference() const {
+			return g_->local(*cur_);
+		}
+
+		bool equal(const adjacency_iterator &other) const {
+			return cur_ == other.cur_;
+		}
+
+		const InducedSubgraphView *g_;
+		const Index *cur_;
+		const Index *end_;
+	};
+
+	static vertex_descriptor null_vertex() {
+		return std::numeric_limits<Index>::max();
+	}
+
+	friend Index num_vertices(const InducedSubgraphView &g) {
+		return g.globals_.size();
+	}
+
+	friend Offset num_edges(const InducedSubgraphView &g) {
+		return g.n_edges_;
+	}
+
+	friend std::pair<vertex_iterator, vertex_iterator> vertices(const InducedSubgraphView &g) {
+		return {vertex_iterator(0), vertex_iterator(g.globals_.size())};
+	}
+
+	friend std::pair<adjacency_iterator, adjacency_iterator> adjacent_vertices(Index v, const InducedSubgraphView &g) {
+		const auto [first, last] = adjacent_vertices(g.globals_[v], *g.base_);
+		return {adjacency_iterator(&g, first, last), adjacency_iterator(&g, last, last)};
+	}
+
+	friend Offset degree(Index v, const InducedSubgraphView &g) {
+		Offset n = 0;
+
+		for (const auto w : iter_neighbors(*g.base_, g.globals_[v]))
+			n += g.contains(w);
+
+		return n;
+	}
+
+	// Vertices are their own indices
+	friend boost::typed_identity_property_map<Index> get(boost::vertex_index_t, const InducedSubgraphView &) {
+		return {};
+	}
+
+private:
+	const Base *base_;
+	std::vector<uint64_t> mask_;
+	std::vector<Index> ranks_;
+	std::vector<Index> globals_;
+	Offset n_edges_;
+};
+
+#endif // INDUCED_SUBGRAPH_H
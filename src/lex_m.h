@@ -11,47 +11,61 @@
 #include <limits>
 #include <vector>
 #include <deque>
-#include <unordered_map>
-#include <unordered_set>
+#include <algorithm>
 #include <boost/graph/graph_concepts.hpp>
 
 #include "utils.h"
 #include "radix_sort.h"
+#include "vertex_map.h"
+#include "probes.h"
+#include "metrics.h"
 
 /**
- * Compute a minimal elimination order for the given graph.
+ * Compute a minimal elimination order for the given graph, ending with the given
+ * vertex.
  *
- * @param  g graph to compute the order for
+ * @param  g     graph to compute the order for
+ * @param  start vertex to number first, i.e. to eliminate last
  * @return a minimal elimination order for the graph as an ordered sequence of
  *         all its vertices
+ * @tparam Containers container policy (see vertex_map.h)
+ *
+ * Probes: lex_m_entry(V, E), then for each step lex_m_search(index, reached)
+ * and lex_m_relabel(index, unique labels), and lex_m_return(V, scanned edges).
  *
  * @pre `g` is a simple, connected, undirected graph
  */
-template <class Graph>
-VertexOrder<Graph> lex_m(const Graph &g) {
+template <class Graph, class Containers = DefaultContainers>
+VertexOrder<Graph> lex_m(const Graph &g, VertexDesc<Graph> start) {
 	typedef VertexDesc<Graph> Vertex;
 	typedef VertexSizeT<Graph> Label;
-	typedef std::unordered_set<Vertex> VertexSet;
 
 	static_assert(!std::numeric_limits<Label>::is_signed);
 	BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<Graph>));
 	BOOST_CONCEPT_ASSERT((boost::AdjacencyGraphConcept<Graph>));
+	AA_METRICS_CALL(lex_m, num_vertices(g), num_edges(g));
 
-	const auto n_vertices = boost::num_vertices(g);
-	VertexSet unnumbered = std::make_from_tuple<VertexSet>(boost::vertices(g));
+	const auto n_vertices = num_vertices(g);
+	std::vector<Vertex> unnumbered = std::make_from_tuple<std::vector<Vertex>>(vertices(g));
+	VertexStateSet<Graph, Containers> numbered(g);
 	Label n_unique_labels = 1;
 	VertexOrder<Graph> order(n_vertices);
-	std::unordered_map<Vertex, Label> label(n_vertices);
-	std::unordered_map<Label, std::deque<Vertex>> to_reach;
-	VertexSet reached;
+	VertexStateMap<Graph, Label, Containers> label(g);
+	typename Containers::template Map<Label, std::deque<Vertex>> to_reach;
+	VertexStateSet<Graph, Containers> reached(g);
+	size_t n_scanned = 0;
 
-	// Start with any vertex
-	Vertex cur_vertex = *unnumbered.begin();
+	AA_PROBE2(lex_m_entry, n_vertices, num_edges(g));
+
+	// Start with the given vertex
+	std::iter_swap(std::find(unnumbered.begin(), unnumbered.end(), start), unnumbered.end() - 1);
+	Vertex cur_vertex = unnumbered.back();
+	unnumbered.pop_back();
 
 	// Number each vertex of the graph in reverse order
 	for (size_t index = n_vertices - 1; index < n_vertices; index--) {
 		// Assign index to cur_vertex
-		unnumbered.erase(cur_vertex);
+		numbered.insert(cur_vertex);
 		order[index] = cur_vertex;
 
 		to_reach.clear();
@@ -60,7 +74,7 @@ VertexOrder<Graph> lex_m(const Graph &g) {
 		// Mark each neighbor of cur_vertex as reached and increment its label,
 		// while also adding it to the queue for reaching other vertices
 		for (const auto v : iter_neighbors(g, cur_vertex)) {
-			if (unnumbered.find(v) != unnumbered.end()) {
+			if (!numbered.contains(v)) {
 				reached.insert(v);
 				to_reach[label[v]].push_back(v);
 				label[v]++;
@@ -79,9 +93,9 @@ VertexOrder<Graph> lex_m(const Graph &g) {
 
 				// For all neighbors of the vertex
 				for (const auto w : iter_neighbors(g, v)) {
-					if (unnumbered.find(w) != unnumbered.end() && reached.find(w) == reached.end()) {
-						reached.insert(w);
+					n_scanned++;
 
+					if (!numbered.contains(w) && reached.insert(w)) {
 						if (label[w] > l) {
 							// We reached this vertex with a chain of lower
 							// labeled vertives, increase its label
@@ -98,19 +112,20 @@ VertexOrder<Graph> lex_m(const Graph &g) {
 			}
 		}
 
+		AA_PROBE2(lex_m_search, index, reached.size());
+
 		if (unnumbered.empty())
 			break;
 
 		// Sort and recompute the labels of all unnumbered vertices to be
 		// [0, 2, ..., 2 * n_unique_labels) while also counting the number of
 		// unique labels
-		std::vector<Vertex> to_relabel(unnumbered.begin(), unnumbered.end());
-		radix_sort(to_relabel.begin(), to_relabel.end(), label);
+		radix_sort(unnumbered.begin(), unnumbered.end(), label);
 
-		Label prev_label = label[to_relabel.front()];
+		Label prev_label = label[unnumbered.front()];
 		n_unique_labels = 1;
 
-		for (const auto v : to_relabel) {
+		for (const auto v : unnumbered) {
 			if (label[v] != prev_label) {
 				n_unique_labels++;
 				prev_label = label[v];
@@ -119,11 +134,36 @@ VertexOrder<Graph> lex_m(const Graph &g) {
 			label[v] = 2 * (n_unique_labels - 1);
 		}
 
+		AA_PROBE2(lex_m_relabel, index, n_unique_labels);
+
 		// Pick the highest labeled vertex as the next one
-		cur_vertex = to_relabel.back();
+		cur_vertex = unnumbered.back();
+		unnumbered.pop_back();
 	}
 
+	AA_PROBE2(lex_m_return, n_vertices, n_scanned);
 	return order;
 }
 
+/**
+ * Compute a minimal elimination order for the given graph, ending with the last
+ * vertex enumerated by vertices(g).
+ *
+ * @param  g graph to compute the order for
+ * @return a minimal elimination order for the graph as an ordered sequence of
+ *         all its vertices
+ * @tparam Containers container policy (see vertex_map.h)
+ *
+ * @pre `g` is a simple, connected, undirected graph
+ */
+template <class Graph, class Containers = DefaultContainers>
+VertexOrder<Graph> lex_m(const Graph &g) {
+	VertexDesc<Graph> last{};
+
+	for (const auto v : iter_vertices(g))
+		last = v;
+
+	return lex_m<Graph, Containers>(g, last);
+}
+
 #endif // ALGO_LEXM_H
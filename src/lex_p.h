@@ -10,116 +10,289 @@
 
 #include <limits>
 #include <vector>
-#include <unordered_map>
-#include <unordered_set>
+#include <utility>
+#include <type_traits>
 #include <boost/graph/graph_concepts.hpp>
+#include <boost/iterator/iterator_categories.hpp>
 
 #include "utils.h"
+#include "vertex_map.h"
+#include "flat_hash.h"
+#include "parallel.h"
+#include "probes.h"
+#include "metrics.h"
+
+// Default minimum degree of the vertices whose neighbors lex_p() processes in
+// parallel
+constexpr size_t lex_p_parallel_degree = size_t(1) << 16;
 
 /**
  * Compute a perfect elimination order for the given perfect elimination graph.
  *
- * @param  g graph to compute the order for
+ * When a vertex of degree at least `parallel_degree` is numbered, the labels of
+ * its neighbors are refined by `n_threads` threads, each handling a part of its
+ * adjacency list, giving the same result as a sequential refinement. This is
+ * only done for graphs with a vertex index and random access adjacency
+ * iterators.
+ *
+ * @param  g               graph to compute the order for
+ * @param  n_threads       number of threads to use for high degree vertices
+ * @param  parallel_degree minimum degree of vertices processed in parallel
  * @return a perfect elimination order for the graph as an ordered sequence of
  *         all its vertices
+ * @tparam Containers container policy (see vertex_map.h)
+ *
+ * Probes: lex_p_entry(V, E), then for each step lex_p_split(index, new labels),
+ * and lex_p_return(V, labels).
  *
  * @pre `g` is a simple, connected, undirected, perfect elimination graph
  */
-template <class Graph>
-VertexOrder<Graph> lex_p(const Graph &g) {
+template <class Graph, class Containers = DefaultContainers>
+VertexOrder<Graph> lex_p(const Graph &g, unsigned n_threads = 1, size_t parallel_degree = lex_p_parallel_degree) {
 	struct Label;
-	struct LabeledVertex;
 
 	typedef VertexDesc<Graph> Vertex;
 	typedef VertexSizeT<Graph> VertexSz;
-	typedef std::unordered_map<Vertex, LabeledVertex *> LabeledVertexMap;
+	typedef typename boost::graph_traits<Graph>::adjacency_iterator AdjacencyIter;
 
-	struct Label {
-		LabeledVertexMap vertex_map;
-		Label *prev;
-		Label *next;
-
-		Label() = delete;
-		Label(VertexSz n): vertex_map(n), prev(nullptr), next(nullptr) {}
-	};
+	constexpr bool can_parallelize = HasVertexIndex<Graph>::value
+		&& std::is_convertible<typename boost::iterator_traversal<AdjacencyIter>::type,
+			boost::random_access_traversal_tag>::value;
+	constexpr size_t none = std::numeric_limits<size_t>::max();
 
+	// Unnumbered vertex in the list of vertices of its label, or numbered
+	// vertex if label is null
 	struct LabeledVertex {
 		Vertex id;
-		Label *label;
+		Label *label = nullptr;
+		LabeledVertex *prev = nullptr;
+		LabeledVertex *next = nullptr;
+	};
+
+	struct Label {
+		LabeledVertex *first = nullptr;
+		Label *prev = nullptr;
+		Label *next = nullptr;
+		// New label preceeding this one created in the current step, if any
+		Label *fix = nullptr;
+		// Last neighbor with this label seen so far in a parallel refinement
+		size_t last_neighbor = 0;
+
+		void insert(LabeledVertex *v) {
+			v->label = this;
+			v->prev = nullptr;
+			v->next = first;
+
+			if (first)
+				first->prev = v;
+
+			first = v;
+		}
 
-		LabeledVertex() = delete;
-		LabeledVertex(Vertex id, Label *l) : id(id), label(l) {}
+		void erase(LabeledVertex *v) {
+			if (v->prev)
+				v->prev->next = v->next;
+			else
+				first = v->next;
+
+			if (v->next)
+				v->next->prev = v->prev;
+
+			v->label = nullptr;
+		}
 	};
 
 	static_assert(!std::numeric_limits<VertexSz>::is_signed);
 	BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<Graph>));
 	BOOST_CONCEPT_ASSERT((boost::AdjacencyGraphConcept<Graph>));
+	AA_METRICS_CALL(lex_p, num_vertices(g), num_edges(g));
 
-	const auto n_vertices = boost::num_vertices(g);
-	Label *head = new Label(n_vertices);
-	LabeledVertexMap unnumbered(n_vertices);
+	const auto n_vertices = num_vertices(g);
+	Label *head = new Label();
+	VertexStateMap<Graph, LabeledVertex, Containers> labeled(g);
 	VertexOrder<Graph> order(n_vertices);
-	std::unordered_map<Label *, Label *> fix;
-	LabeledVertex *cur_vertex;
+	std::vector<Label *> fixed;
+	size_t n_labels = 1;
+
+	// Unnumbered neighbor of a vertex in a parallel refinement, linked to the
+	// previous and next neighbors with the same label
+	struct Neighbor {
+		LabeledVertex *v;
+		Label *label;
+		size_t prev;
+		size_t next;
+	};
+
+	// Labels of the neighbors of a chunk, in order of first appearance
+	struct ChunkLabel {
+		Label *label;
+		size_t first;
+		size_t last;
+	};
+
+	std::vector<Neighbor> neighbors;
+	std::vector<std::vector<ChunkLabel>> chunk_labels(n_threads);
+
+	// Move each unnumbered neighbor of v from its label to the new label
+	// preceeding it, in parallel: the result is the same as visiting the
+	// neighbors in order, moving each one to the head of its new label
+	auto refine_parallel = [&](auto first, auto last) {
+		neighbors.resize(last - first);
+
+		// Collect the unnumbered neighbors of each chunk and link the ones with
+		// the same label
+		parallel_chunks(neighbors.size(), n_threads, [&](unsigned c, size_t begin, size_t end) {
+			FlatHashMap<Label *, size_t> index;
+
+			chunk_labels[c].clear();
+
+			for (size_t i = begin; i < end; i++) {
+				LabeledVertex *v = &labeled[*(first + i)];
+				Label *label = v->label;
+
+				neighbors[i] = {v, label, none, none};
+
+				if (!label)
+					continue;
+
+				// Mark the neighbor as removed from its list
+				v->label = nullptr;
+
+				size_t &l = index[label];
+
+				if (l == 0) {
+					chunk_labels[c].push_back({label, i, i});
+					l = chunk_labels[c].size();
+				} else {
+					ChunkLabel &cl = chunk_labels[c][l - 1];
+					neighbors[cl.last].next = i;
+					neighbors[i].prev = cl.last;
+					cl.last = i;
+				}
+			}
+		});
+
+		// Create the new labels in order of first appearance and link the
+		// neighbors with the same label across chunks
+		for (const auto &labels : chunk_labels) {
+			for (const auto &cl : labels) {
+				Label *label = cl.label;
+
+				if (!label->fix) {
+					label->fix = new Label();
+					fixed.push_back(label);
+				} else {
+					neighbors[label->last_neighbor].next = cl.first;
+					neighbors[cl.first].prev = label->last_neighbor;
+				}
+
+				label->last_neighbor = cl.last;
+			}
+		}
+
+		// Remove the neighbors from their old lists: each run of consecutive
+		// neighbors in a list is unlinked by the thread handling its first one
+		parallel_chunks(neighbors.size(), n_threads, [&](unsigned, size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				const Neighbor &n = neighbors[i];
+
+				if (!n.label || (n.v->prev && !n.v->prev->label))
+					continue;
+
+				LabeledVertex *next = n.v->next;
+
+				while (next && !next->label)
+					next = next->next;
+
+				if (n.v->prev)
+					n.v->prev->next = next;
+				else
+					n.label->first = next;
+
+				if (next)
+					next->prev = n.v->prev;
+			}
+		});
+
+		// Link the neighbors in their new lists in reverse order
+		parallel_chunks(neighbors.size(), n_threads, [&](unsigned, size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				const Neighbor &n = neighbors[i];
+
+				if (!n.label)
+					continue;
+
+				n.v->label = n.label->fix;
+				n.v->prev = n.next != none ? neighbors[n.next].v : nullptr;
+				n.v->next = n.prev != none ? neighbors[n.prev].v : nullptr;
+
+				if (n.next == none)
+					n.label->fix->first = n.v;
+			}
+		});
+	};
+
+	AA_PROBE2(lex_p_entry, n_vertices, num_edges(g));
 
 	// Assign the empty label to all the vertices of the graph
 	for (const auto id : iter_vertices(g)) {
-		LabeledVertex *v = new LabeledVertex(id, head);
-		head->vertex_map[id] = v;
-		unnumbered[id] = v;
+		LabeledVertex &v = labeled[id];
+		v.id = id;
+		head->insert(&v);
 	}
 
 	// Number each vertex of the graph in reverse order
 	for (auto index = n_vertices - 1; index < n_vertices; index--) {
-		cur_vertex = nullptr;
-
-		// Find cur_vertex as the highest-labeled unnumbered vertex scanning the
-		// linked list of labels
-		for (auto label = head; !cur_vertex && label; label = label->next) {
-			for (const auto [id, v] : label->vertex_map) {
-				auto it = unnumbered.find(id);
-
-				if (it != unnumbered.end()) {
-					cur_vertex = v;
-					unnumbered.erase(it);
-					break;
-				}
-			}
+		// Find cur_vertex as the highest-labeled unnumbered vertex, dropping
+		// the labels left without vertices from the head of the list
+		while (!head->first) {
+			Label *next = head->next;
+			delete head;
+			head = next;
+			head->prev = nullptr;
 		}
 
+		LabeledVertex *cur_vertex = head->first;
+
 		// Assign index to cur_vertex
-		assert(cur_vertex);
+		head->erase(cur_vertex);
 		order[index] = cur_vertex->id;
 
+		const auto [first, last] = adjacent_vertices(cur_vertex->id, g);
+		bool refined = false;
+
+		if constexpr (can_parallelize) {
+			if (n_threads > 1 && size_t(last - first) >= parallel_degree) {
+				refine_parallel(first, last);
+				refined = true;
+			}
+		}
+
 		// For each unnumbered neighbor of the current vertex
-		for (const auto neighbor_id : iter_neighbors(g, cur_vertex->id)) {
-			auto it = unnumbered.find(neighbor_id);
+		for (const auto neighbor_id : boost::make_iterator_range(first, refined ? first : last)) {
+			LabeledVertex &neighbor = labeled[neighbor_id];
+			Label *label = neighbor.label;
 
-			if (it != unnumbered.end()) {
+			if (label) {
 				// Create a new label (if not already created) which preceeds
 				// the current neighbor's label of exactly one position in the
 				// list of labels
-				auto neighbor = (*it).second;
-				auto prev_it = fix.find(neighbor->label);
-				Label *new_label;
-
-				if (prev_it != fix.end()) {
-					new_label = (*prev_it).second;
-				} else {
-					new_label = new Label(1);
-					fix[neighbor->label] = new_label;
+				if (!label->fix) {
+					label->fix = new Label();
+					fixed.push_back(label);
 				}
 
 				// Remove this neighbor from its current label and assign it to
 				// the newly created label
-				neighbor->label->vertex_map.erase(neighbor_id);
-				neighbor->label = new_label;
-				neighbor->label->vertex_map[neighbor_id] = neighbor;
+				label->erase(&neighbor);
+				label->fix->insert(&neighbor);
 			}
 		}
 
 		// Add newly created labels to the list
-		for (const auto [label, new_label] : fix) {
+		for (const auto label : fixed) {
+			Label *new_label = label->fix;
+
 			if (label->prev)
 				label->prev->next = new_label;
 			else
@@ -128,21 +301,21 @@ VertexOrder<Graph> lex_p(const Graph &g) {
 			new_label->next = label;
 			new_label->prev = label->prev;
 			label->prev = new_label;
+			label->fix = nullptr;
 		}
 
-		fix.clear();
+		AA_PROBE2(lex_p_split, index, fixed.size());
+		n_labels += fixed.size();
+		fixed.clear();
 	}
 
 	while (head) {
 		auto nxt = head->next;
-
-		for (auto v : head->vertex_map)
-			delete v.second;
 		delete head;
-
 		head = nxt;
 	}
 
+	AA_PROBE2(lex_p_return, n_vertices, n_labels);
 	return order;
 }
 
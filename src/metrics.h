@@ -0,0 +1,573 @@
+/**
+ * Registry of aggregate metrics (counters, histograms and maxima) updated by
+ * the algorithms, and rendered in the Prometheus text exposition format, e.g.
+ * to be served by an embedding service or written periodically for the
+ * textfile collector of the node exporter:
+ *
+ *     write_metrics(MetricsRegistry::global(), "/var/lib/node_exporter/aa.prom");
+ *
+ * Updates are lock-free and uncontended: each thread has its own shard of the
+ * values of each registry, updated with relaxed loads and stores, and shards
+ * are summed (or maxed) only when rendering. Shards of exited threads are
+ * reused by new threads, keeping their values.
+ *
+ * The algorithms record in the global registry the number of calls, duration
+ * and number of vertices and edges of each engine, their peak scratch memory
+ * when it is not linear in the number of vertices, and the cache hit rate of
+ * exact_order(). This can be disabled by defining AA_NO_METRICS.
+ *
+ * See: https://prometheus.io/docs/instrumenting/exposition_formats/
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <limits>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+#include <utility>
+#include <algorithm>
+#include <charconv>
+#include <unordered_map>
+
+#ifndef AA_NO_METRICS
+#define AA_METRICS_ENABLED 1
+#else
+#define AA_METRICS_ENABLED 0
+#endif
+
+class MetricsRegistry;
+
+/**
+ * Values of one thread, one 64-bit slot per value (integers, or doubles stored
+ * by their bits), only written by the thread that claimed the shard.
+ */
+struct MetricsShard {
+	explicit MetricsShard(size_t n_slots) : slots(new std::atomic<uint64_t>[n_slots]) {
+		for (size_t i = 0; i < n_slots; i++)
+			slots[i].store(0, std::memory_order_relaxed);
+	}
+
+	std::unique_ptr<std::atomic<uint64_t>[]> slots;
+	// Whether a running thread owns the shard
+	std::atomic<bool> claimed{true};
+	// Whether the registry was destroyed
+	std::atomic<bool> orphaned{false};
+};
+
+/**
+ * Monotonic counter, e.g. of calls.
+ */
+class MetricCounter {
+public:
+	void add(uint64_t n = 1) const;
+
+private:
+	friend class MetricsRegistry;
+	MetricCounter(MetricsRegistry *registry, unsigned slot) : registry_(registry), slot_(slot) {}
+
+	MetricsRegistry *registry_;
+	unsigned slot_;
+};
+
+/**
+ * Maximum of the observed values, e.g. of peak memory, rendered as a gauge.
+ */
+class MetricMax {
+public:
+	void update(uint64_t value) const;
+
+private:
+	friend class MetricsRegistry;
+	MetricMax(MetricsRegistry *registry, unsigned slot) : registry_(registry), slot_(slot) {}
+
+	MetricsRegistry *registry_;
+	unsigned slot_;
+};
+
+/**
+ * Distribution of the observed values, counted in buckets with the given upper
+ * bounds, plus their sum.
+ */
+class MetricHistogram {
+public:
+	void observe(double value) const;
+
+private:
+	friend class MetricsRegistry;
+	MetricHistogram(MetricsRegistry *registry, unsigned slot, const std::vector<double> *bounds)
+		: registry_(registry), slot_(slot), bounds_(bounds) {}
+
+	MetricsRegistry *registry_;
+	// Slots of the count of each bucket, then of the +Inf bucket and the sum
+	unsigned slot_;
+	const std::vector<double> *bounds_;
+};
+
+/**
+ * Registry of metrics. Each metric is a family of series with the same name and
+ * different labels, registered once (registering the same series again returns
+ * the same handle) and then updated through its handle from any thread.
+ *
+ * Each thread updating the metrics of a registry takes max_slots * 8 bytes for
+ * its shard, so registries hold a bounded number of values: series registered
+ * beyond it are still valid, but not rendered.
+ */
+class MetricsRegistry {
+public:
+	static constexpr unsigned max_slots = 1024;
+
+	enum class Type {
+		counter,
+		gauge,
+		histogram,
+	};
+
+	MetricsRegistry() : id_(next_id().fetch_add(1) + 1) {}
+
+	MetricsRegistry(const MetricsRegistry &) = delete;
+	MetricsRegistry &operator=(const MetricsRegistry &) = delete;
+
+	~MetricsRegistry() {
+		// The shards of running threads are freed when they exit
+		for (const auto &shard : shards_)
+			shard->orphaned.store(true, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @return the registry updated by the algorithms
+	 */
+	static MetricsRegistry &global() {
+		static MetricsRegistry registry;
+		return registry;
+	}
+
+	/**
+	 * Register a series of a counter.
+	 *
+	 * @param name   name of the metric, conventionally ending with _total
+	 * @param help   description of the metric
+	 * @param labels labels of the series as `name="value",...`, or empty
+	 *
+	 * @pre `name` and `labels` are valid Prometheus metric names and labels;
+	 *      series of the same name have the same type, help (and bounds)
+	 */
+	MetricCounter counter(const std::string &name, const std::string &help, const std::string &labels = "") {
+		return {this, add_series(name, help, labels, Type::counter, {}, 1)};
+	}
+
+	/**
+	 * Register a series of a maximum, with the same parameters as counter().
+	 */
+	MetricMax max(const std::string &name, const std::string &help, const std::string &labels = "") {
+		return {this, add_series(name, help, labels, Type::gauge, {}, 1)};
+	}
+
+	/**
+	 * Register a series of a histogram, with the same parameters as counter()
+	 * plus the increasing upper bounds of its buckets (without +Inf).
+	 */
+	MetricHistogram histogram(const std::string &name, const std::string &help, const std::vector<double> &bounds,
+			const std::string &labels = "") {
+		std::lock_guard<std::mutex> lock(mutex_);
+		const unsigned slot = add_series_locked(name, help, labels, Type::histogram, bounds, bounds.size() + 2);
+
+		return {this, slot, slot == sink ? &no_bounds_ : &families_[family_of_.at(name)].bounds};
+	}
+
+	/**
+	 * Render all the series in the Prometheus text format, in order of
+	 * registration of their families and then of themselves.
+	 */
+	std::string render() const {
+		std::lock_guard<std::mutex> lock(mutex_);
+		std::string out;
+
+		for (const auto &family : families_) {
+			const char *types[] = {"counter", "gauge", "histogram"};
+
+			out += "# HELP " + family.name + ' ' + escape(family.help) + '\n';
+			out += "# TYPE " + family.name + ' ' + types[int(family.type)] + '\n';
+
+			for (const auto &series : family.series) {
+				const std::string sep = series.labels.empty() ? "" : ",";
+
+				if (family.type == Type::counter) {
+					out += family.name + braces(series.labels) + ' ' + std::to_string(sum(series.slot)) + '\n';
+				} else if (family.type == Type::gauge) {
+					out += family.name + braces(series.labels) + ' ' + std::to_string(maximum(series.slot)) + '\n';
+				} else {
+					const size_t n_bounds = family.bounds.size();
+					uint64_t count = 0;
+
+					for (size_t i = 0; i <= n_bounds; i++) {
+						const std::string le = i < n_bounds ? format(family.bounds[i]) : "+Inf";
+
+						count += sum(series.slot + i);
+						out += family.name + "_bucket{" + series.labels + sep + "le=\"" + le + "\"} "
+							+ std::to_string(count) + '\n';
+					}
+
+					out += family.name + "_sum" + braces(series.labels) + ' '
+						+ format(sum_doubles(series.slot + n_bounds + 1)) + '\n';
+					out += family.name + "_count" + braces(series.labels) + ' ' + std::to_string(count) + '\n';
+				}
+			}
+		}
+
+		return out;
+	}
+
+private:
+	friend class MetricCounter;
+	friend class MetricMax;
+	friend class MetricHistogram;
+
+	struct Series {
+		std::string labels;
+		unsigned slot;
+	};
+
+	struct Family {
+		std::string name, help;
+		Type type;
+		std::vector<double> bounds;
+		std::vector<Series> series;
+	};
+
+	// Shards claimed by a thread, released when it exits
+	struct ThreadShards {
+		std::vector<std::pair<uint64_t, std::shared_ptr<MetricsShard>>> shards;
+
+		~ThreadShards() {
+			for (const auto &[id, shard] : shards)
+				shard->claimed.store(false, std::memory_order_release);
+		}
+	};
+
+	// Slots of the series registered beyond max_slots, never rendered: as many
+	// as a histogram without bounds
+	static constexpr unsigned sink = max_slots;
+	static constexpr unsigned n_slots = max_slots + 2;
+
+	static std::atomic<uint64_t> &next_id() {
+		static std::atomic<uint64_t> id{0};
+		return id;
+	}
+
+	unsigned add_series(const std::string &name, const std::string &help, const std::string &labels, Type type,
+			const std::vector<double> &bounds, unsigned size) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		return add_series_locked(name, help, labels, type, bounds, size);
+	}
+
+	unsigned add_series_locked(const std::string &name, const std::string &help, const std::string &labels,
+			Type type, const std::vector<double> &bounds, unsigned size) {
+		auto [it, added] = family_of_.emplace(name, families_.size());
+
+		if (added)
+			families_.push_back({name, help, type, bounds, {}});
+
+		Family &family = families_[it->second];
+
+		assert(family.type == type && family.bounds == bounds);
+
+		for (const auto &series : family.series) {
+			if (series.labels == labels)
+				return series.slot;
+		}
+
+		if (n_used_ + size > max_slots)
+			return sink;
+
+		family.series.push_back({labels, n_used_});
+		n_used_ += size;
+
+		return family.series.back().slot;
+	}
+
+	/**
+	 * Helper function: return the shard of the calling thread, claiming a free
+	 * shard or creating one at its first update.
+	 */
+	MetricsShard &shard() {
+		// Last registry updated by the thread, to skip the lookup
+		static thread_local uint64_t last_id = 0;
+		static thread_local MetricsShard *last_shard = nullptr;
+
+		if (last_id != id_) {
+			last_shard = &claim_shard();
+			last_id = id_;
+		}
+
+		return *last_shard;
+	}
+
+	MetricsShard &claim_shard() {
+		static thread_local ThreadShards thread_shards;
+		auto &claimed = thread_shards.shards;
+
+		// Forget the shards of the destroyed registries
+		claimed.erase(std::remove_if(claimed.begin(), claimed.end(), [](const auto &p) {
+			return p.second->orphaned.load(std::memory_order_relaxed);
+		}), claimed.end());
+
+		for (const auto &[id, shard] : claimed) {
+			if (id == id_)
+				return *shard;
+		}
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		std::shared_ptr<MetricsShard> res;
+
+		for (const auto &shard : shards_) {
+			bool expected = false;
+
+			if (shard->claimed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+				res = shard;
+				break;
+			}
+		}
+
+		if (!res) {
+			res = std::make_shared<MetricsShard>(n_slots);
+			shards_.push_back(res);
+		}
+
+		claimed.emplace_back(id_, res);
+		return *res;
+	}
+
+	uint64_t sum(unsigned slot) const {
+		uint64_t res = 0;
+
+		for (const auto &shard : shards_)
+			res += shard->slots[slot].load(std::memory_order_relaxed);
+
+		return res;
+	}
+
+	uint64_t maximum(unsigned slot) const {
+		uint64_t res = 0;
+
+		for (const auto &shard : shards_)
+			res = std::max(res, shard->slots[slot].load(std::memory_order_relaxed));
+
+		return res;
+	}
+
+	double sum_doubles(unsigned slot) const {
+		double res = 0;
+
+		for (const auto &shard : shards_)
+			res += to_double(shard->slots[slot].load(std::memory_order_relaxed));
+
+		return res;
+	}
+
+	static double to_double(uint64_t bits) {
+		double x;
+		std::memcpy(&x, &bits, sizeof(x));
+		return x;
+	}
+
+	static uint64_t to_bits(double x) {
+		uint64_t bits;
+		std::memcpy(&bits, &x, sizeof(x));
+		return bits;
+	}
+
+	/**
+	 * Helper function: shortest representation of a double that reads back as
+	 * the same value.
+	 */
+	static std::string format(double x) {
+		if (x == std::numeric_limits<double>::infinity())
+			return "+Inf";
+
+		char buf[32];
+		const auto res = std::to_chars(buf, buf + sizeof(buf), x);
+
+		return std::string(buf, res.ptr);
+	}
+
+	static std::string braces(const std::string &labels) {
+		return labels.empty() ? "" : '{' + labels + '}';
+	}
+
+	static std::string escape(const std::string &help) {
+		std::string res;
+
+		for (const char c : help) {
+			if (c == '\\')
+				res += "\\\\";
+			else if (c == '\n')
+				res += "\\n";
+			else
+				res += c;
+		}
+
+		return res;
+	}
+
+	const uint64_t id_;
+	mutable std::mutex mutex_;
+	// Families are never moved, so histograms can refer to their bounds
+	std::deque<Family> families_;
+	std::unordered_map<std::string, size_t> family_of_;
+	std::vector<std::shared_ptr<MetricsShard>> shards_;
+	unsigned n_used_ = 0;
+	const std::vector<double> no_bounds_;
+};
+
+// Only the owning thread writes to its slots, so updates need no atomic
+// read-modify-write
+inline void MetricCounter::add(uint64_t n) const {
+	auto &slot = registry_->shard().slots[slot_];
+
+	slot.store(slot.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+inline void MetricMax::update(uint64_t value) const {
+	auto &slot = registry_->shard().slots[slot_];
+
+	if (value > slot.load(std::memory_order_relaxed))
+		slot.store(value, std::memory_order_relaxed);
+}
+
+inline void MetricHistogram::observe(double value) const {
+	auto &slots = registry_->shard().slots;
+	const size_t n_bounds = bounds_->size();
+	const size_t bucket = std::lower_bound(bounds_->begin(), bounds_->end(), value) - bounds_->begin();
+	auto &count = slots[slot_ + bucket];
+	auto &sum = slots[slot_ + n_bounds + 1];
+
+	count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	sum.store(MetricsRegistry::to_bits(MetricsRegistry::to_double(sum.load(std::memory_order_relaxed)) + value),
+		std::memory_order_relaxed);
+}
+
+/**
+ * Write the metrics of a registry in the Prometheus text format to a file,
+ * atomically replacing it (through a temporary file in the same directory), so
+ * that readers never see a partial file.
+ *
+ * @param  registry metrics to write
+ * @param  path     path of the file
+ * @return true/false whether the file was written
+ */
+inline bool write_metrics(const MetricsRegistry &registry, const std::string &path) {
+	const std::string text = registry.render();
+	const std::string tmp = path + ".tmp";
+	std::FILE *f = std::fopen(tmp.c_str(), "w");
+
+	if (!f)
+		return false;
+
+	const bool written = std::fwrite(text.data(), 1, text.size(), f) == text.size();
+
+	if (std::fclose(f) != 0 || !written || std::rename(tmp.c_str(), path.c_str()) != 0) {
+		std::remove(tmp.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Metrics of the calls of an engine (an ordering algorithm), in the global
+ * registry, labeled with the name of the engine.
+ */
+struct EngineMetrics {
+	explicit EngineMetrics(const std::string &engine, MetricsRegistry &registry = MetricsRegistry::global())
+		: calls(registry.counter("aa_engine_calls_total", "Number of calls of each engine.", label(engine))),
+		  duration(registry.histogram("aa_engine_duration_seconds", "Duration of the calls of each engine.",
+			  {1e-5, 1e-4, 1e-3, 1e-2, 0.1, 1, 10, 100}, label(engine))),
+		  vertices(registry.histogram("aa_engine_vertices", "Number of vertices of the inputs of each engine.",
+			  {1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7}, label(engine))),
+		  edges(registry.histogram("aa_engine_edges", "Number of edges of the inputs of each engine.",
+			  {1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8}, label(engine)))
+	{}
+
+	static std::string label(const std::string &engine) {
+		return "engine=\"" + engine + '"';
+	}
+
+	MetricCounter calls;
+	MetricHistogram duration, vertices, edges;
+};
+
+/**
+ * Call of an engine, recording its input size when created and its duration
+ * when destroyed.
+ */
+class EngineCall {
+public:
+	EngineCall(const EngineMetrics &metrics, size_t n_vertices, size_t n_edges)
+		: metrics_(metrics), start_(std::chrono::steady_clock::now())
+	{
+		metrics_.vertices.observe(n_vertices);
+		metrics_.edges.observe(n_edges);
+	}
+
+	EngineCall(const EngineCall &) = delete;
+	EngineCall &operator=(const EngineCall &) = delete;
+
+	~EngineCall() {
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+
+		metrics_.calls.add();
+		metrics_.duration.observe(elapsed.count());
+	}
+
+private:
+	const EngineMetrics &metrics_;
+	std::chrono::steady_clock::time_point start_;
+};
+
+#if AA_METRICS_ENABLED
+
+/**
+ * Record the call of the enclosing function as a call of the given engine,
+ * with the given input size, until the end of the enclosing scope.
+ */
+#define AA_METRICS_CALL(engine, n_vertices, n_edges) \
+	static const EngineMetrics aa_metrics_engine_(#engine); \
+	const EngineCall aa_metrics_call_(aa_metrics_engine_, n_vertices, n_edges)
+
+/**
+ * Record the peak scratch memory (in bytes) of a call of the given engine.
+ */
+#define AA_METRICS_SCRATCH(engine, bytes) do { \
+		static const MetricMax aa_metrics_max_ = MetricsRegistry::global().max("aa_engine_scratch_bytes_max", \
+			"Peak scratch memory of a call of each engine, in bytes.", EngineMetrics::label(#engine)); \
+		aa_metrics_max_.update(bytes); \
+	} while (0)
+
+/**
+ * Add n to the counter series with the given name, help and labels.
+ */
+#define AA_METRICS_COUNT(name, help, labels, n) do { \
+		static const MetricCounter aa_metrics_counter_ = MetricsRegistry::global().counter(name, help, labels); \
+		aa_metrics_counter_.add(n); \
+	} while (0)
+
+#else
+
+// Arguments are not evaluated, only referenced to avoid unused warnings
+#define AA_METRICS_CALL(engine, n_vertices, n_edges) ((void)sizeof(n_vertices), (void)sizeof(n_edges))
+#define AA_METRICS_SCRATCH(engine, bytes)            ((void)sizeof(bytes))
+#define AA_METRICS_COUNT(name, help, labels, n)      ((void)sizeof(n))
+
+#endif // AA_METRICS_ENABLED
+
+#endif // METRICS_H
@@ -0,0 +1,223 @@
+/**
+ * Minimum degree elimination orders, computed on the quotient graph.
+ */
+
+#ifndef ALGO_MIN_DEGREE_H
+#define ALGO_MIN_DEGREE_H
+
+#include <limits>
+#include <vector>
+#include <boost/graph/graph_concepts.hpp>
+
+#include "utils.h"
+#include "csr_graph.h"
+#include "quotient_graph.h"
+#include "probes.h"
+#include "metrics.h"
+
+/**
+ * Binary min-heap of the variables of a quotient graph keyed by degree, then by
+ * index, which knows the position of each variable so that its degree can be
+ * updated in place: memory is O(V) however many updates there are.
+ */
+class DegreeHeap {
+public:
+	typedef QuotientGraph::Index Index;
+
+	explicit DegreeHeap(Index n_vertices) : deg_(n_vertices), pos_(n_vertices, npos) {
+		heap_.reserve(n_vertices);
+	}
+
+	/**
+	 * @return the number of bytes allocated by a heap of the given number of
+	 *         vertices
+	 */
+	static size_t memory(Index n_vertices) {
+		return size_t(n_vertices) * (sizeof(size_t) + 2 * sizeof(Index));
+	}
+
+	bool empty() const { return heap_.empty(); }
+
+	/**
+	 * @return the degree of a variable in the heap
+	 */
+	size_t degree(Index v) const { return deg_[v]; }
+
+	/**
+	 * @return the variable of minimum degree, with the least index among them
+	 */
+	Index top() const { return heap_.front(); }
+
+	void pop() {
+		pos_[heap_.front()] = npos;
+		heap_.front() = heap_.back();
+		heap_.pop_back();
+
+		if (!heap_.empty()) {
+			pos_[heap_.front()] = 0;
+			sift_down(0);
+		}
+	}
+
+	/**
+	 * Insert a variable, or update its degree if already in the heap, in
+	 * O(log V) time.
+	 */
+	void update(Index v, size_t deg) {
+		if (pos_[v] == npos) {
+			pos_[v] = heap_.size();
+			heap_.push_back(v);
+		} else if (deg > deg_[v]) {
+			deg_[v] = deg;
+			sift_down(pos_[v]);
+			return;
+		}
+
+		deg_[v] = deg;
+		sift_up(pos_[v]);
+	}
+
+private:
+	static constexpr Index npos = std::numeric_limits<Index>::max();
+
+	bool less(Index v, Index w) const {
+		return deg_[v] < deg_[w] || (deg_[v] == deg_[w] && v < w);
+	}
+
+	void place(Index i, Index v) {
+		heap_[i] = v;
+		pos_[v] = i;
+	}
+
+	void sift_up(Index i) {
+		const Index v = heap_[i];
+
+		for (Index parent; i > 0 && less(v, heap_[parent = (i - 1) / 2]); i = parent)
+			place(i, heap_[parent]);
+
+		place(i, v);
+	}
+
+	void sift_down(Index i) {
+		const Index v = heap_[i];
+		const Index n = heap_.size();
+
+		for (Index child; (child = 2 * i + 1) < n; i = child) {
+			if (child + 1 < n && less(heap_[child + 1], heap_[child]))
+				child++;
+			if (!less(heap_[child], v))
+				break;
+
+			place(i, heap_[child]);
+		}
+
+		place(i, v);
+	}
+
+	std::vector<size_t> deg_;
+	// Position of each variable in the heap, or npos
+	std::vector<Index> pos_;
+	std::vector<Index> heap_;
+};
+
+/**
+ * Eliminate all the variables of a quotient graph, choosing at each step a
+ * variable of minimum degree. Ties are broken by index. Besides the graph,
+ * memory is O(V) (see DegreeHeap::memory()).
+ *
+ * The degrees of the neighbors of each eliminated variable are not computed
+ * right away, but replaced by lower bounds: they are only computed when the
+ * variables come up as minimum, which variables updated several times before
+ * being eliminated rarely do.
+ *
+ * @param  q quotient graph, with all the variables eliminated on return
+ * @return the variables in elimination order
+ *
+ * Probes: minimum_degree_entry(variables, entries) and
+ * minimum_degree_return(variables, degree updates).
+ */
+inline std::vector<QuotientGraph::Index> minimum_degree_elimination(QuotientGraph &q) {
+	typedef QuotientGraph::Index Index;
+
+	const Index n_vars = q.n_remaining();
+	DegreeHeap heap(q.n_vertices());
+	// Variables whose degree in the heap is a lower bound
+	std::vector<bool> outdated(q.n_vertices());
+	std::vector<Index> order;
+	size_t n_updates = 0;
+
+	AA_PROBE2(minimum_degree_entry, n_vars, q.num_entries());
+
+	order.reserve(n_vars);
+
+	for (Index v = 0; v < q.n_vertices(); v++) {
+		if (!q.is_eliminated(v))
+			heap.update(v, q.degree(v));
+	}
+
+	while (!heap.empty()) {
+		const Index v = heap.top();
+
+		if (outdated[v]) {
+			outdated[v] = false;
+			heap.update(v, q.degree(v));
+			n_updates++;
+			continue;
+		}
+
+		heap.pop();
+		order.push_back(v);
+
+		// Neighbors lose v, at most, and are adjacent to each other
+		const auto &changed = q.eliminate(v);
+
+		for (const auto w : changed) {
+			const size_t deg = heap.degree(w);
+
+			outdated[w] = true;
+			heap.update(w, std::max<size_t>(deg > 0 ? deg - 1 : 0, changed.size() - 1));
+		}
+	}
+
+	AA_PROBE2(minimum_degree_return, n_vars, n_updates);
+	return order;
+}
+
+/**
+ * Compute an elimination order for the given graph, eliminating at each step
+ * a vertex of minimum degree in the graph of the remaining vertices (with the
+ * fill-in of the previous steps). Ties are broken by position in vertices(g).
+ * The elimination is carried out on a QuotientGraph, so memory stays O(V+E).
+ *
+ * @param  g graph to compute the order for
+ * @return an elimination order for the graph as an ordered sequence of all its
+ *         vertices
+ *
+ * Probes: see minimum_degree_elimination().
+ *
+ * @pre `g` is a simple, undirected graph
+ */
+template <class Graph>
+VertexOrder<Graph> minimum_degree_order(const Graph &g) {
+	BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<Graph>));
+	BOOST_CONCEPT_ASSERT((boost::AdjacencyGraphConcept<Graph>));
+	AA_METRICS_CALL(minimum_degree_order, num_vertices(g), num_edges(g));
+
+	const auto snap = make_csr_snapshot(g);
+	QuotientGraph q(snap.graph);
+	VertexOrder<Graph> order;
+
+	order.reserve(snap.vertices.size());
+
+	for (const auto v : minimum_degree_elimination(q))
+		order.push_back(snap.vertices[v]);
+
+	// The snapshot, the quotient graph at its largest, and the degree heap
+	// and the order of minimum_degree_elimination()
+	AA_METRICS_SCRATCH(minimum_degree_order, snap.graph.memory() + snap.vertices.capacity() * sizeof(snap.vertices[0])
+		+ q.peak_memory() + DegreeHeap::memory(q.n_vertices()) + q.n_vertices() * sizeof(QuotientGraph::Index));
+
+	return order;
+}
+
+#endif // ALGO_MIN_DEGREE_H
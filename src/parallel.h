@@ -0,0 +1,66 @@
+/**
+ * Simple fork-join parallelism with std::thread, for the parallel phases of the
+ * algorithms.
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstddef>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <atomic>
+
+/**
+ * Split [0, n) into n_chunks contiguous chunks of (almost) the same size and
+ * call f(chunk, begin, end) for each one, on a separate thread for all chunks
+ * but the first, which is run by the calling thread. Returns when all the calls
+ * have returned, so consecutive calls act as barriers.
+ *
+ * @param n        size of the range to split
+ * @param n_chunks number of chunks (and threads)
+ * @param f        function to call for each chunk
+ *
+ * @pre `n_chunks` > 0; `f` does not throw
+ */
+template <class F>
+void parallel_chunks(size_t n, unsigned n_chunks, F f) {
+	std::vector<std::thread> threads;
+	auto chunk_begin = [n, n_chunks](unsigned c) { return n / n_chunks * c + std::min<size_t>(c, n % n_chunks); };
+
+	threads.reserve(n_chunks - 1);
+
+	for (unsigned c = 1; c < n_chunks; c++)
+		threads.emplace_back(f, c, chunk_begin(c), chunk_begin(c + 1));
+
+	f(0u, chunk_begin(0), chunk_begin(1));
+
+	for (auto &t : threads)
+		t.join();
+}
+
+/**
+ * Call f(thread, i) for each i in [0, n) on n_threads threads, including the
+ * calling one, where thread in [0, n_threads) identifies the thread running
+ * the task (e.g. to use per-thread buffers). Each thread takes the next index
+ * when done with the previous one, so tasks of very different cost are
+ * balanced as long as the most expensive ones come first.
+ *
+ * @param n         number of tasks
+ * @param n_threads number of threads
+ * @param f         function to call for each task
+ *
+ * @pre `n_threads` > 0; `f` does not throw
+ */
+template <class F>
+void parallel_tasks(size_t n, unsigned n_threads, F f) {
+	std::atomic<size_t> next(0);
+
+	parallel_chunks(n_threads, n_threads, [n, &next, &f](unsigned thread, size_t, size_t) {
+		for (size_t i; (i = next++) < n;)
+			f(thread, i);
+	});
+}
+
+#endif // PARALLEL_H
@@ -0,0 +1,58 @@
+/**
+ * Explicit instantiations of the algorithms for the most common graph types,
+ * compiled once into a static library (see `make precompiled`).
+ *
+ * Including this header instead of algos.h declares the instantiations as
+ * extern templates, so that translation units using the algorithms on these
+ * graph types do not instantiate (i.e. compile) them again, and only need to be
+ * linked with the library. Other graph types can still be used as usual.
+ */
+
+#ifndef PRECOMPILED_H
+#define PRECOMPILED_H
+
+#include <boost/graph/adjacency_list.hpp>
+
+#include "algos.h"
+#include "csr_graph.h"
+#include "dynamic_graph.h"
+#include "induced_subgraph.h"
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> AdjacencyListGraph;
+
+// Instantiations of the algorithms not modifying the graph: EXTERN is either
+// `extern` (declaration) or empty (definition)
+#define AA_INSTANTIATE_CONST_ALGOS(EXTERN, Graph) \
+	EXTERN template VertexOrder<Graph> lex_m<Graph>(const Graph &); \
+	EXTERN template VertexOrder<Graph> lex_m<Graph>(const Graph &, VertexDesc<Graph>); \
+	EXTERN template VertexOrder<Graph> block_lex_m<Graph>(const Graph &, unsigned); \
+	EXTERN template VertexOrder<Graph> lex_p<Graph>(const Graph &, unsigned, size_t); \
+	EXTERN template VertexOrder<Graph> minimum_degree_order<Graph>(const Graph &); \
+	EXTERN template EdgeSet<Graph> fill_in<Graph>(const Graph &, const VertexOrder<Graph> &); \
+	EXTERN template size_t fill_in_count<Graph>(const Graph &, const VertexOrder<Graph> &); \
+	EXTERN template bool is_perfect_elimination_order<Graph>(const Graph &, const VertexOrder<Graph> &); \
+	EXTERN template VertexOrder<Graph> exact_order<Graph>(const Graph &, ExactObjective, ExactOrderCache *); \
+	EXTERN template VertexOrder<Graph> distributed_order<Graph>(const Graph &, unsigned, bool, const LexMBlockOrder &); \
+	EXTERN template SchurComplement<Graph> schur_complement<Graph>(const Graph &, const VertexOrder<Graph> &); \
+	EXTERN template ChordalSubgraph<Graph> maximal_chordal_subgraph<Graph>(const Graph &); \
+	EXTERN template IlukPattern symbolic_iluk<Graph>(const Graph &, const VertexOrder<Graph> &, unsigned, unsigned); \
+	EXTERN template EliminationTree make_elimination_tree<Graph>(const Graph &, const VertexOrder<Graph> &); \
+	EXTERN template CliqueTree make_clique_tree<Graph>(const Graph &, const VertexOrder<Graph> &); \
+	EXTERN template class FillOracle<Graph>; \
+	EXTERN template EliminationPlan make_elimination_plan<Graph>(const Graph &, const VertexOrder<Graph> &); \
+	EXTERN template CsrSnapshot<Graph> make_csr_snapshot<Graph>(const Graph &);
+
+#define AA_INSTANTIATE_ALL(EXTERN) \
+	AA_INSTANTIATE_CONST_ALGOS(EXTERN, AdjacencyListGraph) \
+	AA_INSTANTIATE_CONST_ALGOS(EXTERN, CsrGraph<>) \
+	AA_INSTANTIATE_CONST_ALGOS(EXTERN, CsrGraphView<>) \
+	AA_INSTANTIATE_CONST_ALGOS(EXTERN, InducedSubgraphView<>) \
+	AA_INSTANTIATE_CONST_ALGOS(EXTERN, DynamicGraphSnapshot<>) \
+	EXTERN template void fill<AdjacencyListGraph>(AdjacencyListGraph &, const VertexOrder<AdjacencyListGraph> &);
+
+// Defined only when compiling the library itself
+#ifndef AA_PRECOMPILED_DEFINITIONS
+AA_INSTANTIATE_ALL(extern)
+#endif
+
+#endif // PRECOMPILED_H
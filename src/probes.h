@@ -0,0 +1,96 @@
+/**
+ * Statically defined tracepoints (USDT) in the SystemTap SDT format, which can
+ * be attached to in running processes by perf, bpftrace, SystemTap and other
+ * tools without recompiling. Each probe is a single nop instruction plus an
+ * ELF note (section .note.stapsdt) describing its location and where to find
+ * its arguments, so probes cost nothing measurable when not attached.
+ *
+ * All probes are under the "aa" provider, and each phase probe fires at the end
+ * of its phase, e.g.:
+ *
+ *     perf buildid-cache --add ./program && perf list sdt_aa:*
+ *     bpftrace -e 'usdt:./program:aa:lex_m_entry { @[arg0] = count(); }'
+ *
+ * Probes are only emitted on x86-64 and AArch64 with GCC or Clang, and can be
+ * disabled by defining AA_NO_PROBES. Otherwise they do nothing, without even
+ * evaluating their arguments.
+ *
+ * See: https://sourceware.org/systemtap/wiki/UserSpaceProbeImplementation
+ */
+
+#ifndef PROBES_H
+#define PROBES_H
+
+#include <type_traits>
+
+#if !defined(AA_NO_PROBES) && defined(__GNUC__) && (defined(__x86_64__) || defined(__aarch64__))
+#define AA_PROBES_ENABLED 1
+#else
+#define AA_PROBES_ENABLED 0
+#endif
+
+#if AA_PROBES_ENABLED
+
+// Size of an argument in the argument description of a probe, negative for
+// signed types
+#define AA_PROBE_ARG_SIZE(x) \
+	((std::is_signed<std::decay_t<decltype(x)>>::value ? 1 : -1) * int(sizeof(x)))
+
+// Assembler operands of the i-th argument: its size (printed negated with %n)
+// and its location, either a constant, a register or a memory operand
+#define AA_PROBE_ARG(i, x) [aa_size##i] "n" (AA_PROBE_ARG_SIZE(x)), [aa_arg##i] "nor" (x)
+#define AA_PROBE_ARG_DESC(i) "%n[aa_size" #i "]@%[aa_arg" #i "]"
+
+#define AA_PROBE_ASM(name, desc, ...)                                                    \
+	__asm__ __volatile__(                                                                \
+		"990: nop\n"                                                                     \
+		".pushsection .note.stapsdt,\"?\",\"note\"\n"                                    \
+		".balign 4\n"                                                                    \
+		".4byte 992f-991f, 994f-993f, 3\n"                                               \
+		"991: .asciz \"stapsdt\"\n"                                                      \
+		"992: .balign 4\n"                                                               \
+		"993: .8byte 990b\n"                                                             \
+		".8byte _.stapsdt.base\n"                                                        \
+		".8byte 0\n"                                                                     \
+		".asciz \"aa\"\n"                                                                \
+		".asciz \"" #name "\"\n"                                                         \
+		".asciz \"" desc "\"\n"                                                          \
+		"994: .balign 4\n"                                                               \
+		".popsection\n"                                                                  \
+		".ifndef _.stapsdt.base\n"                                                       \
+		".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n"          \
+		".weak _.stapsdt.base\n"                                                         \
+		".hidden _.stapsdt.base\n"                                                       \
+		"_.stapsdt.base: .space 1\n"                                                     \
+		".size _.stapsdt.base, 1\n"                                                      \
+		".popsection\n"                                                                  \
+		".endif\n"                                                                       \
+		:: __VA_ARGS__)
+
+/**
+ * Fire the probe with the given name and integer or pointer arguments.
+ */
+#define AA_PROBE1(name, a1) \
+	AA_PROBE_ASM(name, AA_PROBE_ARG_DESC(1), AA_PROBE_ARG(1, a1))
+#define AA_PROBE2(name, a1, a2) \
+	AA_PROBE_ASM(name, AA_PROBE_ARG_DESC(1) " " AA_PROBE_ARG_DESC(2), \
+		AA_PROBE_ARG(1, a1), AA_PROBE_ARG(2, a2))
+#define AA_PROBE3(name, a1, a2, a3) \
+	AA_PROBE_ASM(name, AA_PROBE_ARG_DESC(1) " " AA_PROBE_ARG_DESC(2) " " AA_PROBE_ARG_DESC(3), \
+		AA_PROBE_ARG(1, a1), AA_PROBE_ARG(2, a2), AA_PROBE_ARG(3, a3))
+#define AA_PROBE4(name, a1, a2, a3, a4) \
+	AA_PROBE_ASM(name, AA_PROBE_ARG_DESC(1) " " AA_PROBE_ARG_DESC(2) " " AA_PROBE_ARG_DESC(3) " " \
+		AA_PROBE_ARG_DESC(4), AA_PROBE_ARG(1, a1), AA_PROBE_ARG(2, a2), AA_PROBE_ARG(3, a3), \
+		AA_PROBE_ARG(4, a4))
+
+#else
+
+// Arguments are not evaluated, only referenced to avoid unused warnings
+#define AA_PROBE1(name, a1)             ((void)sizeof(a1))
+#define AA_PROBE2(name, a1, a2)         ((void)sizeof(a1), (void)sizeof(a2))
+#define AA_PROBE3(name, a1, a2, a3)     ((void)sizeof(a1), (void)sizeof(a2), (void)sizeof(a3))
+#define AA_PROBE4(name, a1, a2, a3, a4) ((void)sizeof(a1), (void)sizeof(a2), (void)sizeof(a3), (void)sizeof(a4))
+
+#endif // AA_PROBES_ENABLED
+
+#endif // PROBES_H
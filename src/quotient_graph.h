@@ -0,0 +1,365 @@
+/**
+ * Quotient graph representation of the elimination game, as used by minimum
+ * degree ordering algorithms: eliminated vertices are kept as "elements"
+ * standing for the cliques they would create, instead of adding the edges of
+ * the cliques, so that the representation never takes more memory than the
+ * original graph.
+ *
+ * See: https://doi.org/10.1137/1031001
+ */
+
+#ifndef QUOTIENT_GRAPH_H
+#define QUOTIENT_GRAPH_H
+
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include <cassert>
+#include <algorithm>
+
+#include "utils.h"
+#include "vertex_map.h"
+
+/**
+ * Graph under elimination, where each vertex is either a "variable" (not yet
+ * eliminated) or an "element" (eliminated). Each variable u stores its adjacent
+ * variables A(u) and its adjacent elements E(u), each element e stores its
+ * adjacent variables L(e), and the neighbors of u in the filled graph are the
+ * variables of A(u) and of L(e) for each e in E(u).
+ *
+ * Eliminating a variable v turns it into an element with L(v) the neighbors of
+ * v, and absorbs the elements of E(v) into it, since their variables are now
+ * all neighbors of v, as well as any other element whose variables are all
+ * neighbors of v (aggressive absorption). Edges between neighbors of v are also
+ * removed from the A() lists, as L(v) represents them. Hence the total number
+ * of entries of the lists never exceeds its initial value, 2E for a graph.
+ *
+ * Upper bounds of the degrees of the variables are updated at each elimination
+ * as in the approximate minimum degree algorithm, without scanning the
+ * variables of the elements (see https://doi.org/10.1137/S0895479894278952).
+ *
+ * Vertices are identified by their index in [0, n_vertices()).
+ */
+class QuotientGraph {
+public:
+	typedef unsigned Index;
+
+	/**
+	 * Create the quotient graph of a graph with no vertex eliminated.
+	 *
+	 * @param g graph, whose vertices are identified by their vertex index
+	 *
+	 * @pre `g` is a simple, undirected graph with a vertex index (see
+	 *      HasVertexIndex)
+	 */
+	template <class Graph>
+	explicit QuotientGraph(const Graph &g)
+		: nodes_(num_vertices(g)), approx_degree_(num_vertices(g)), external_(num_vertices(g)),
+		  mark_(num_vertices(g), 0), stamp_(0)
+	{
+		static_assert(HasVertexIndex<Graph>::value);
+
+		const auto index = get(boost::vertex_index, g);
+
+		for (const auto v : iter_vertices(g)) {
+			auto &vars = nodes_[get(index, v)].vars;
+
+			for (const auto w : iter_neighbors(g, v))
+				vars.push_back(get(index, w));
+
+			vars.shrink_to_fit();
+			approx_degree_[get(index, v)] = vars.size();
+		}
+
+		n_remaining_ = nodes_.size();
+		peak_memory_ = memory_ = initial_memory();
+	}
+
+	/**
+	 * Create the quotient graph of a graph given as a union of cliques, with
+	 * one element already eliminated for each clique: the variables are not
+	 * adjacent to each other, and are neighbors iff they share a clique. This
+	 * takes memory proportional to the total size of the cliques, which can be
+	 * much less than the number of edges of the graph (e.g. for the column
+	 * intersection graph of a matrix, whose rows are the cliques).
+	 *
+	 * @param n_vars      number of variables, with indices in [0, n_vars)
+	 * @param n_cliques   number of cliques, whose elements have indices in
+	 *                    [n_vars, n_vars + n_cliques)
+	 * @param clique_ptr  array of n_cliques + 1 offsets of the variables of
+	 *                    each clique in `clique_vars`
+	 * @param clique_vars variables of all the cliques, one after the other
+	 *
+	 * @pre no clique contains a variable twice
+	 */
+	template <class Offset>
+	QuotientGraph(Index n_vars, Index n_cliques, const Offset *clique_ptr, const Index *clique_vars)
+		: nodes_(size_t(n_vars) + n_cliques), n_remaining_(n_vars), approx_degree_(nodes_.size()),
+		  external_(nodes_.size()), mark_(nodes_.size(), 0), stamp_(0)
+	{
+		for (Index i = 0; i < n_cliques; i++) {
+			Node &e = nodes_[n_vars + i];
+
+			e.vars.assign(clique_vars + clique_ptr[i], clique_vars + clique_ptr[i + 1]);
+			e.eliminated = true;
+
+			for (const auto v : e.vars) {
+				nodes_[v].elems.push_back(n_vars + i);
+				approx_degree_[v] += e.vars.size() - 1;
+			}
+		}
+
+		for (Index v = 0; v < n_vars; v++)
+			nodes_[v].elems.shrink_to_fit();
+
+		peak_memory_ = memory_ = initial_memory();
+	}
+
+	/**
+	 * @return the number of vertices, including the elements of the initial
+	 *         cliques (if any)
+	 */
+	Index n_vertices() const { return nodes_.size(); }
+
+	/**
+	 * @return the number of variables (i.e. non-eliminated vertices)
+	 */
+	Index n_remaining() const { return n_remaining_; }
+
+	bool is_eliminated(Index v) const { return nodes_[v].eliminated; }
+
+	/**
+	 * @return the total number of entries of the adjacency lists, which never
+	 *         exceeds its initial value
+	 */
+	size_t num_entries() const {
+		size_t n = 0;
+
+		for (const auto &node : nodes_)
+			n += node.vars.size() + node.elems.size();
+
+		return n;
+	}
+
+	/**
+	 * @return the number of bytes currently allocated by the graph
+	 */
+	size_t memory() const { return memory_; }
+
+	/**
+	 * @return the maximum number of bytes allocated by the graph at any time
+	 */
+	size_t peak_memory() const { return peak_memory_; }
+
+	/**
+	 * Call f(w) once for each neighbor w of a variable, i.e. each variable that
+	 * would be adjacent to it if the eliminated vertices were removed adding
+	 * the edges of their cliques, in O(|A(v)| + sum of |L(e)| for e in E(v))
+	 * time.
+	 *
+	 * @pre `v` is not eliminated
+	 */
+	template <class F>
+	void for_each_neighbor(Index v, F f) const {
+		assert(!nodes_[v].eliminated);
+
+		const size_t stamp = next_stamp();
+		mark_[v] = stamp;
+
+		auto visit = [&](Index w) {
+			if (mark_[w] != stamp) {
+				mark_[w] = stamp;
+				f(w);
+			}
+		};
+
+		for (const auto w : nodes_[v].vars)
+			visit(w);
+
+		for (const auto e : nodes_[v].elems) {
+			for (const auto w : nodes_[e].vars)
+				visit(w);
+		}
+	}
+
+	/**
+	 * @return the neighbors of a variable (see for_each_neighbor()), in no
+	 *         particular order
+	 *
+	 * @pre `v` is not eliminated
+	 */
+	std::vector<Index> neighbors(Index v) const {
+		std::vector<Index> res;
+
+		for_each_neighbor(v, [&res](Index w) { res.push_back(w); });
+		return res;
+	}
+
+	/**
+	 * @return the number of neighbors of a variable, in the same time as
+	 *         for_each_neighbor()
+	 *
+	 * @pre `v` is not eliminated
+	 */
+	size_t degree(Index v) const {
+		size_t n = 0;
+
+		for_each_neighbor(v, [&n](Index) { n++; });
+		return n;
+	}
+
+	/**
+	 * @return an upper bound of the number of neighbors of a variable, in O(1)
+	 *         time: the exact degree initially, then, when a neighbor p is
+	 *         eliminated, the least of the previous bound plus |L(p)| - 1 and
+	 *         of |A(v)| + |L(p)| - 1 plus the size of L(e) \ L(p) for each
+	 *         other element e in E(v)
+	 *
+	 * @pre `v` is not eliminated
+	 */
+	size_t approximate_degree(Index v) const {
+		assert(!nodes_[v].eliminated);
+		return std::min<size_t>(approx_degree_[v], n_remaining_ - 1);
+	}
+
+	/**
+	 * @return the elements adjacent to a variable
+	 *
+	 * @pre `v` is not eliminated
+	 */
+	const std::vector<Index> &elements(Index v) const {
+		assert(!nodes_[v].eliminated);
+		return nodes_[v].elems;
+	}
+
+	/**
+	 * Eliminate a variable, turning it into an element and absorbing its
+	 * adjacent elements, in the same time as for_each_neighbor() plus
+	 * O(|A(w)| + |E(w)|) for each neighbor w, updating the approximate degrees
+	 * of the neighbors.
+	 *
+	 * @return the neighbors of the variable before its elimination, i.e. the
+	 *         variables whose neighbors (and degree) changed, in no particular
+	 *         order and valid until the new element is absorbed
+	 *
+	 * @pre `v` is not eliminated
+	 */
+	const std::vector<Index> &eliminate(Index v) {
+		Node &node = nodes_[v];
+		std::vector<Index> clique;
+
+		for_each_neighbor(v, [&clique](Index w) { clique.push_back(w); });
+		clique.shrink_to_fit();
+		memory_ += clique.capacity() * sizeof(Index);
+		peak_memory_ = std::max(peak_memory_, memory_);
+
+		// Absorb the adjacent elements
+		for (const auto e : node.elems)
+			absorb(e);
+
+		memory_ -= (node.vars.capacity() + node.elems.capacity()) * sizeof(Index);
+		std::vector<Index>().swap(node.elems);
+		node.vars.swap(clique);
+		node.eliminated = true;
+		n_remaining_--;
+
+		// Neighbors of v (marked by for_each_neighbor) now reach each other
+		// through v
+		const size_t stamp = stamp_;
+		const size_t n_clique = node.vars.size();
+
+		// Number of variables of each other element adjacent to the neighbors
+		// of v which are not neighbors of v, marking the elements as well
+		for (const auto w : node.vars) {
+			for (const auto e : nodes_[w].elems) {
+				if (nodes_[e].absorbed)
+					continue;
+
+				if (mark_[e] != stamp) {
+					mark_[e] = stamp;
+					external_[e] = nodes_[e].vars.size();
+				}
+
+				external_[e]--;
+			}
+		}
+
+		for (const auto w : node.vars) {
+			auto &vars = nodes_[w].vars;
+			auto &elems = nodes_[w].elems;
+			const size_t capacity = elems.capacity();
+			size_t n_external = 0;
+			size_t n_elems = 0;
+
+			vars.erase(std::remove_if(vars.begin(), vars.end(), [this, stamp](Index x) {
+				return mark_[x] == stamp;
+			}), vars.end());
+
+			// Elements with no other variables are redundant
+			for (const auto e : elems) {
+				if (!nodes_[e].absorbed && external_[e] == 0)
+					absorb(e);
+
+				if (!nodes_[e].absorbed) {
+					elems[n_elems++] = e;
+					n_external += external_[e];
+				}
+			}
+
+			elems.resize(n_elems);
+			elems.push_back(v);
+			memory_ += (elems.capacity() - capacity) * sizeof(Index);
+
+			approx_degree_[w] = std::min(approx_degree_[w] + n_clique - 1, vars.size() + n_clique - 1 + n_external);
+		}
+
+		peak_memory_ = std::max(peak_memory_, memory_);
+		return node.vars;
+	}
+
+private:
+	struct Node {
+		// Adjacent variables of a variable, or variables of an element
+		std::vector<Index> vars;
+		// Adjacent elements of a variable
+		std::vector<Index> elems;
+		bool eliminated = false;
+		bool absorbed = false;
+	};
+
+	size_t next_stamp() const {
+		return ++stamp_;
+	}
+
+	size_t initial_memory() const {
+		size_t n = nodes_.capacity() * sizeof(Node) + mark_.capacity() * sizeof(size_t)
+			+ (approx_degree_.capacity() + external_.capacity()) * sizeof(size_t);
+
+		for (const auto &node : nodes_)
+			n += (node.vars.capacity() + node.elems.capacity()) * sizeof(Index);
+
+		return n;
+	}
+
+	void absorb(Index e) {
+		memory_ -= nodes_[e].vars.capacity() * sizeof(Index);
+		std::vector<Index>().swap(nodes_[e].vars);
+		nodes_[e].absorbed = true;
+	}
+
+	std::vector<Node> nodes_;
+	Index n_remaining_;
+	// Upper bounds of the degrees of the variables
+	std::vector<size_t> approx_degree_;
+	// Number of variables of each element which are not neighbors of the last
+	// eliminated variable, valid if the element is marked with the last stamp
+	std::vector<size_t> external_;
+	// Bytes allocated by the graph, currently and at most
+	size_t memory_;
+	size_t peak_memory_;
+	// Vertices visited by the last traversal are marked with its stamp
+	mutable std::vector<size_t> mark_;
+	mutable size_t stamp_;
+};
+
+#endif // QUOTIENT_GRAPH_H
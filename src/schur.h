@@ -0,0 +1,151 @@
+/**
+ * Partial vertex elimination: computation of the graph of the Schur complement
+ * obtained eliminating only a subset of the vertices of a graph.
+ */
+
+#ifndef ALGO_SCHUR_H
+#define ALGO_SCHUR_H
+
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <boost/graph/graph_concepts.hpp>
+
+#include "utils.h"
+#include "csr_graph.h"
+#include "vertex_map.h"
+
+/**
+ * Graph of the Schur complement of a partial elimination, along with the
+ * mapping of its vertices to the vertices of the original graph.
+ */
+template <class Graph>
+struct SchurComplement {
+	// Reduced graph on the remaining (non-eliminated) vertices
+	CsrGraph<> graph;
+	// Original vertex corresponding to each vertex of the reduced graph
+	VertexOrder<Graph> vertices;
+};
+
+/**
+ * Eliminate the given subset of vertices of a graph and compute the graph on
+ * the remaining vertices after the elimination, without computing any fill-in
+ * between eliminated vertices.
+ *
+ * The result does not depend on the order in which the vertices are eliminated:
+ * by Lemma 4 of the paper, two remaining vertices v and w are adjacent after
+ * the elimination iff v--w is an edge of the original graph or there is a path
+ * from v to w whose inner vertices are all eliminated. Therefore, each
+ * connected component of the subgraph induced by the eliminated vertices turns
+ * its remaining neighbors into a clique, which is all this function computes.
+ *
+ * @param  g          graph to partially eliminate
+ * @param  eliminated sequence of (distinct) vertices of the graph to eliminate
+ * @return the reduced graph on the remaining vertices, numbered in the same
+ *         order in which they are enumerated by vertices(g)
+ *
+ * @pre `g` is a simple, undirected graph
+ */
+template <class Graph>
+SchurComplement<Graph> schur_complement(const Graph &g, const VertexOrder<Graph> &eliminated) {
+	typedef VertexDesc<Graph> Vertex;
+	typedef typename CsrGraph<>::vertex_descriptor Index;
+	typedef typename CsrGraph<>::edges_size_type Offset;
+
+	BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<Graph>));
+	BOOST_CONCEPT_ASSERT((boost::AdjacencyGraphConcept<Graph>));
+
+	const auto n_vertices = num_vertices(g);
+	VertexStateSet<Graph> to_eliminate(g);
+	VertexStateMap<Graph, Index> local(g);
+	SchurComplement<Graph> res;
+
+	assert(n_vertices - eliminated.size() <= std::numeric_limits<Index>::max());
+
+	for (const auto v : eliminated)
+		to_eliminate.insert(v);
+
+	// Number the remaining vertices
+	for (const auto v : iter_vertices(g)) {
+		if (!to_eliminate.contains(v)) {
+			local[v] = res.vertices.size();
+			res.vertices.push_back(v);
+		}
+	}
+
+	const Index n_remaining = res.vertices.size();
+	std::vector<std::vector<Index>> adj(n_remaining);
+
+	// Keep the original edges between remaining vertices
+	for (Index i = 0; i < n_remaining; i++) {
+		for (const auto w : iter_neighbors(g, res.vertices[i])) {
+			if (!to_eliminate.contains(w))
+				adj[i].push_back(local[w]);
+		}
+	}
+
+	VertexStateSet<Graph> visited(g);
+	std::vector<Vertex> stack;
+	std::vector<Index> boundary;
+	std::vector<size_t> seen_by(n_remaining, std::numeric_limits<size_t>::max());
+	size_t component = 0;
+
+	// Find each connected component of the subgraph induced by the eliminated
+	// vertices, along with its boundary (i.e. its remaining neighbors), which
+	// becomes a clique after the elimination
+	for (const auto s : eliminated) {
+		if (!visited.insert(s))
+			continue;
+
+		stack.push_back(s);
+		boundary.clear();
+
+		while (!stack.empty()) {
+			const auto v = stack.back();
+			stack.pop_back();
+
+			for (const auto w : iter_neighbors(g, v)) {
+				if (!to_eliminate.contains(w)) {
+					const Index i = local[w];
+
+					if (seen_by[i] != component) {
+						seen_by[i] = component;
+						boundary.push_back(i);
+					}
+				} else if (visited.insert(w)) {
+					stack.push_back(w);
+				}
+			}
+		}
+
+		for (const auto a : boundary) {
+			for (const auto b : boundary) {
+				if (a != b)
+					adj[a].push_back(b);
+			}
+		}
+
+		component++;
+	}
+
+	std::vector<Offset> offsets(n_remaining + 1);
+	std::vector<Index> targets;
+
+	// Remove duplicate edges and build the final compressed graph
+	for (Index i = 0; i < n_remaining; i++) {
+		auto &a = adj[i];
+
+		std::sort(a.begin(), a.end());
+		a.erase(std::unique(a.begin(), a.end()), a.end());
+		targets.insert(targets.end(), a.begin(), a.end());
+		offsets[i + 1] = targets.size();
+
+		std::vector<Index>().swap(a);
+	}
+
+	res.graph = CsrGraph<>(std::move(offsets), std::move(targets));
+	return res;
+}
+
+#endif // ALGO_SCHUR_H
@@ -0,0 +1,69 @@
+/**
+ * Runtime selection of the instruction set of the SIMD kernels, so that one
+ * binary built for a baseline CPU uses the widest vectors of the host.
+ *
+ * Kernels for each level are compiled with the target attribute instead of
+ * compiler flags, and selected at the first call from the features of the CPU,
+ * capped by the AA_SIMD environment variable (scalar, sse4.1 or avx2) if set,
+ * e.g. to compare the levels in benchmarks.
+ */
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cstdlib>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define AA_SIMD_X86 1
+#include <immintrin.h>
+#define AA_TARGET(isa) __attribute__((target(isa)))
+// Inline all the calls of a kernel into it, so that helpers compiled for any
+// subset of its instruction set are specialized for it
+#define AA_TARGET_KERNEL(isa) __attribute__((target(isa), flatten))
+#else
+#define AA_SIMD_X86 0
+#endif
+
+/**
+ * Instruction sets of the SIMD kernels, each one a superset of the previous.
+ */
+enum class SimdLevel {
+	scalar,
+	sse41,
+	avx2,
+};
+
+constexpr const char *simd_level_names[] = {"scalar", "sse4.1", "avx2"};
+
+/**
+ * @return the widest level supported by the CPU (and enabled by the OS)
+ */
+inline SimdLevel simd_detect() {
+#if AA_SIMD_X86
+	if (__builtin_cpu_supports("avx2"))
+		return SimdLevel::avx2;
+	if (__builtin_cpu_supports("sse4.1"))
+		return SimdLevel::sse41;
+#endif
+
+	return SimdLevel::scalar;
+}
+
+/**
+ * @return the level to use: the detected one, capped by AA_SIMD if set to the
+ *         name of a level (and ignored otherwise)
+ */
+inline SimdLevel simd_level() {
+	const SimdLevel detected = simd_detect();
+	const char *name = std::getenv("AA_SIMD");
+
+	for (int i = 0; name && i <= int(detected); i++) {
+		if (!std::strcmp(name, simd_level_names[i]))
+			return SimdLevel(i);
+	}
+
+	return detected;
+}
+
+#endif // SIMD_H
@@ -0,0 +1,465 @@
+/**
+ * Set operations on sorted arrays of distinct elements, running in linear time
+ * with branchless comparisons. The overloads for arrays of uint32_t compare
+ * whole blocks of elements at once with AVX2 or SSE4.1, selected at runtime
+ * (see simd.h).
+ *
+ * See: Schlegel et al., "Fast Sorted-Set Intersection using SIMD
+ *      Instructions", and Inoue et al., "SIMD- and Cache-Friendly Algorithm for
+ *      Sorting an Array of Structures".
+ */
+
+#ifndef SORTED_SET_H
+#define SORTED_SET_H
+
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#include "simd.h"
+
+/**
+ * Compute the elements of the first range not in the second one.
+ *
+ * @param first1 start of the first range
+ * @param last1  end of the first range
+ * @param first2 start of the second range
+ * @param last2  end of the second range
+ * @param out    start of the output range
+ * @return end of the output range
+ *
+ * @pre  both ranges are sorted and hold distinct elements; `out` has room for
+ *       `last1 - first1` elements and does not overlap the input ranges
+ * @post [out, return value) is sorted
+ */
+template <class T>
+T *sorted_difference(const T *first1, const T *last1, const T *first2, const T *last2, T *out) {
+	while (first1 != last1 && first2 != last2) {
+		const T a = *first1;
+		const T b = *first2;
+
+		*out = a;
+		out += a < b;
+		first1 += a <= b;
+		first2 += b <= a;
+	}
+
+	return std::copy(first1, last1, out);
+}
+
+/**
+ * Merge two disjoint ranges.
+ *
+ * @param first1 start of the first range
+ * @param last1  end of the first range
+ * @param first2 start of the second range
+ * @param last2  end of the second range
+ * @param out    start of the output range
+ * @return end of the output range
+ *
+ * @pre  both ranges are sorted and hold distinct elements, no element is in
+ *       both; `out` has room for the elements of both ranges and does not
+ *       overlap the input ranges
+ * @post [out, return value) is sorted
+ */
+template <class T>
+T *sorted_merge(const T *first1, const T *last1, const T *first2, const T *last2, T *out) {
+	while (first1 != last1 && first2 != last2) {
+		const T a = *first1;
+		const T b = *first2;
+		const bool take_first = a < b;
+
+		*out++ = take_first ? a : b;
+		first1 += take_first;
+		first2 += !take_first;
+	}
+
+	out = std::copy(first1, last1, out);
+	return std::copy(first2, last2, out);
+}
+
+/**
+ * Determine whether all the elements of the second range are in the first one.
+ *
+ * @param first1 start of the first range
+ * @param last1  end of the first range
+ * @param first2 start of the second range
+ * @param last2  end of the second range
+ * @return true/false whether [first2, last2) is a subset of [first1, last1)
+ *
+ * @pre both ranges are sorted and hold distinct elements
+ */
+template <class T>
+bool sorted_includes(const T *first1, const T *last1, const T *first2, const T *last2) {
+	if (last2 - first2 > last1 - first1)
+		return false;
+
+	while (first1 != last1 && first2 != last2) {
+		const T a = *first1;
+		const T b = *first2;
+
+		// An element of the second range was skipped
+		if (b < a)
+			return false;
+
+		first1++;
+		first2 += a == b;
+	}
+
+	return first2 == last2;
+}
+
+#if AA_SIMD_X86
+
+/**
+ * Table of byte shuffles moving the 32-bit lanes of a 128-bit vector selected
+ * by a 4-bit mask to the front of the vector.
+ */
+struct SortedSetCompactTable {
+	alignas(16) uint8_t shuffle[16][16];
+
+	constexpr SortedSetCompactTable() : shuffle() {
+		for (unsigned mask = 0; mask < 16; mask++) {
+			unsigned pos = 0;
+
+			for (unsigned lane = 0; lane < 4; lane++) {
+				if (mask & (1u << lane)) {
+					for (unsigned byte = 0; byte < 4; byte++)
+						shuffle[mask][4 * pos + byte] = 4 * lane + byte;
+
+					pos++;
+				}
+			}
+
+			for (; pos < 4; pos++) {
+				for (unsigned byte = 0; byte < 4; byte++)
+					shuffle[mask][4 * pos + byte] = 0x80;
+			}
+		}
+	}
+};
+
+inline constexpr SortedSetCompactTable sorted_set_compact_table;
+
+/**
+ * Store the lanes of v selected by a 4-bit mask contiguously at out.
+ *
+ * @return end of the stored lanes
+ *
+ * @pre `out` has room for 4 elements
+ */
+AA_TARGET("sse4.1") inline uint32_t *sorted_set_compact_store(__m128i v, unsigned mask, uint32_t *out) {
+	const __m128i shuffle = _mm_load_si128(reinterpret_cast<const __m128i *>(sorted_set_compact_table.shuffle[mask]));
+
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_shuffle_epi8(v, shuffle));
+	return out + __builtin_popcount(mask);
+}
+
+/**
+ * Block operations of each instruction set: match() gives the bitmask of the
+ * elements of block a equal to any element of block b, and store() stores the
+ * elements of block a selected by a bitmask contiguously at out, returning the
+ * end of the stored elements (writing up to a whole block).
+ */
+struct SortedSetSse41 {
+	// Blocks of 4 elements compared with SSE4.1
+	static constexpr ptrdiff_t block = 4;
+
+	AA_TARGET("sse4.1") static unsigned match(const uint32_t *pa, const uint32_t *pb) {
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pa));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pb));
+		const __m128i eq = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi32(a, b), _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 3, 2, 1)))),
+			_mm_or_si128(_mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(1, 0, 3, 2))),
+				_mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 1, 0, 3)))));
+
+		return _mm_movemask_ps(_mm_castsi128_ps(eq));
+	}
+
+	AA_TARGET("sse4.1") static uint32_t *store(const uint32_t *pa, unsigned mask, uint32_t *out) {
+		return sorted_set_compact_store(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pa)), mask, out);
+	}
+};
+
+struct SortedSetAvx2 {
+	// Blocks of 8 elements compared with AVX2
+	static constexpr ptrdiff_t block = 8;
+
+	AA_TARGET("avx2") static unsigned match(const uint32_t *pa, const uint32_t *pb) {
+		const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pa));
+		__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pb));
+		const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+		__m256i eq = _mm256_cmpeq_epi32(a, b);
+
+		// Compare with all the rotations of b
+		for (int i = 1; i < 8; i++) {
+			b = _mm256_permutevar8x32_epi32(b, rotate);
+			eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(a, b));
+		}
+
+		return _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+	}
+
+	AA_TARGET("avx2") static uint32_t *store(const uint32_t *pa, unsigned mask, uint32_t *out) {
+		const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pa));
+
+		out = sorted_set_compact_store(_mm256_castsi256_si128(a), mask & 0xf, out);
+		return sorted_set_compact_store(_mm256_extracti128_si256(a, 1), mask >> 4, out);
+	}
+};
+
+/**
+ * Compute the elements of the first range not in the second one, comparing
+ * whole blocks of elements (see sorted_difference()).
+ */
+template <class Isa>
+uint32_t *sorted_difference_blocks(const uint32_t *first1, const uint32_t *last1, const uint32_t *first2,
+		const uint32_t *last2, uint32_t *out) {
+	constexpr ptrdiff_t block = Isa::block;
+	constexpr unsigned full_block = (1u << block) - 1;
+	unsigned matched = 0;
+
+	// Compare a block of each range and advance the one with the lowest last
+	// element, accumulating the matches of the current block of the first
+	while (last1 - first1 >= block && last2 - first2 >= block) {
+		const uint32_t max1 = first1[block - 1];
+		const uint32_t max2 = first2[block - 1];
+
+		matched |= Isa::match(first1, first2);
+
+		if (max1 <= max2) {
+			out = Isa::store(first1, ~matched & full_block, out);
+			first1 += block;
+			matched = 0;
+		}
+
+		if (max2 <= max1)
+			first2 += block;
+	}
+
+	// Finish the current block of the first range, which can only match
+	// elements of the second one from first2 onwards
+	if (matched) {
+		for (ptrdiff_t i = 0; i < block; i++, first1++) {
+			if (matched & (1u << i))
+				continue;
+
+			while (first2 != last2 && *first2 < *first1)
+				first2++;
+
+			if (first2 == last2 || *first2 != *first1)
+				*out++ = *first1;
+		}
+	}
+
+	return sorted_difference<uint32_t>(first1, last1, first2, last2, out);
+}
+
+/**
+ * Determine whether all the elements of the second range are in the first one,
+ * comparing whole blocks of elements (see sorted_includes()).
+ */
+template <class Isa>
+bool sorted_includes_blocks(const uint32_t *first1, const uint32_t *last1, const uint32_t *first2,
+		const uint32_t *last2) {
+	constexpr ptrdiff_t block = Isa::block;
+	constexpr unsigned full_block = (1u << block) - 1;
+	unsigned matched = 0;
+
+	if (last2 - first2 > last1 - first1)
+		return false;
+
+	// Same as sorted_difference(), stopping at the first block of the second
+	// range with an element not in the first one
+	while (last1 - first1 >= block && last2 - first2 >= block) {
+		const uint32_t max1 = first1[block - 1];
+		const uint32_t max2 = first2[block - 1];
+
+		matched |= Isa::match(first2, first1);
+
+		if (max2 <= max1) {
+			if (matched != full_block)
+				return false;
+
+			first2 += block;
+			matched = 0;
+		}
+
+		if (max1 <= max2)
+			first1 += block;
+	}
+
+	if (matched) {
+		for (ptrdiff_t i = 0; i < block; i++, first2++) {
+			if (matched & (1u << i))
+				continue;
+
+			while (first1 != last1 && *first1 < *first2)
+				first1++;
+
+			if (first1 == last1 || *first1 != *first2)
+				return false;
+		}
+	}
+
+	return sorted_includes<uint32_t>(first1, last1, first2, last2);
+}
+
+/**
+ * Sort the 8 elements of two sorted vectors, leaving the lowest 4 in lo and the
+ * highest 4 in hi, with a bitonic merge network.
+ */
+AA_TARGET("sse4.1") inline void sorted_set_bitonic_merge(__m128i &lo, __m128i &hi) {
+	// Merge lo with hi reversed: both halves are then bitonic sequences, with
+	// the lowest 4 elements in the first one
+	const __m128i rev = _mm_shuffle_epi32(hi, _MM_SHUFFLE(0, 1, 2, 3));
+	const __m128i l1 = _mm_min_epu32(lo, rev);
+	const __m128i h1 = _mm_max_epu32(lo, rev);
+
+	// Compare elements at distance 2 within each half
+	const __m128i a2 = _mm_unpacklo_epi64(l1, h1);
+	const __m128i b2 = _mm_unpackhi_epi64(l1, h1);
+	const __m128i l2 = _mm_min_epu32(a2, b2);
+	const __m128i h2 = _mm_max_epu32(a2, b2);
+
+	// Compare elements at distance 1 within each half
+	const __m128 l2f = _mm_castsi128_ps(l2);
+	const __m128 h2f = _mm_castsi128_ps(h2);
+	const __m128i a3 = _mm_castps_si128(_mm_shuffle_ps(l2f, h2f, _MM_SHUFFLE(2, 0, 2, 0)));
+	const __m128i b3 = _mm_castps_si128(_mm_shuffle_ps(l2f, h2f, _MM_SHUFFLE(3, 1, 3, 1)));
+	const __m128i l3 = _mm_min_epu32(a3, b3);
+	const __m128i h3 = _mm_max_epu32(a3, b3);
+	const __m128i x = _mm_unpacklo_epi32(l3, h3);
+	const __m128i y = _mm_unpackhi_epi32(l3, h3);
+
+	lo = _mm_unpacklo_epi64(x, y);
+	hi = _mm_unpackhi_epi64(x, y);
+}
+
+/**
+ * Merge two disjoint ranges with a bitonic merge network on blocks of 4
+ * elements (see sorted_merge()), used by all the SIMD levels.
+ */
+AA_TARGET_KERNEL("sse4.1") inline uint32_t *sorted_merge_sse41(const uint32_t *first1, const uint32_t *last1,
+		const uint32_t *first2, const uint32_t *last2, uint32_t *out) {
+	const uint32_t *begin1 = first1;
+	const uint32_t *begin2 = first2;
+
+	if (last1 - first1 >= 4 && last2 - first2 >= 4) {
+		__m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first1));
+		__m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first2));
+
+		first1 += 4;
+		first2 += 4;
+
+		for (;;) {
+			sorted_set_bitonic_merge(lo, hi);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(out), lo);
+			out += 4;
+
+			// Continue with the range with the lowest next element, while it
+			// has a whole block left
+			const bool take_first = first2 == last2 || (first1 != last1 && *first1 < *first2);
+			const uint32_t *&next = take_first ? first1 : first2;
+
+			if ((take_first ? last1 : last2) - next < 4)
+				break;
+
+			lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(next));
+			next += 4;
+		}
+
+		// The elements left in hi are the greatest ones read so far from each
+		// range: put them back and merge the rest
+		const uint32_t last_out = out[-1];
+
+		while (first1 != begin1 && first1[-1] > last_out)
+			first1--;
+		while (first2 != begin2 && first2[-1] > last_out)
+			first2--;
+	}
+
+	return sorted_merge<uint32_t>(first1, last1, first2, last2, out);
+}
+
+// Kernels of each level, with all the block operations inlined
+AA_TARGET_KERNEL("sse4.1") inline uint32_t *sorted_difference_sse41(const uint32_t *first1, const uint32_t *last1,
+		const uint32_t *first2, const uint32_t *last2, uint32_t *out) {
+	return sorted_difference_blocks<SortedSetSse41>(first1, last1, first2, last2, out);
+}
+
+AA_TARGET_KERNEL("avx2") inline uint32_t *sorted_difference_avx2(const uint32_t *first1, const uint32_t *last1,
+		const uint32_t *first2, const uint32_t *last2, uint32_t *out) {
+	return sorted_difference_blocks<SortedSetAvx2>(first1, last1, first2, last2, out);
+}
+
+AA_TARGET_KERNEL("sse4.1") inline bool sorted_includes_sse41(const uint32_t *first1, const uint32_t *last1,
+		const uint32_t *first2, const uint32_t *last2) {
+	return sorted_includes_blocks<SortedSetSse41>(first1, last1, first2, last2);
+}
+
+AA_TARGET_KERNEL("avx2") inline bool sorted_includes_avx2(const uint32_t *first1, const uint32_t *last1,
+		const uint32_t *first2, const uint32_t *last2) {
+	return sorted_includes_blocks<SortedSetAvx2>(first1, last1, first2, last2);
+}
+
+#endif // AA_SIMD_X86
+
+/**
+ * Kernels of the uint32_t overloads for a SIMD level.
+ */
+struct SortedSetKernels {
+	uint32_t *(*difference)(const uint32_t *, const uint32_t *, const uint32_t *, const uint32_t *, uint32_t *);
+	uint32_t *(*merge)(const uint32_t *, const uint32_t *, const uint32_t *, const uint32_t *, uint32_t *);
+	bool (*includes)(const uint32_t *, const uint32_t *, const uint32_t *, const uint32_t *);
+
+	static SortedSetKernels of(SimdLevel level) {
+		switch (level) {
+#if AA_SIMD_X86
+		case SimdLevel::avx2:
+			return {sorted_difference_avx2, sorted_merge_sse41, sorted_includes_avx2};
+		case SimdLevel::sse41:
+			return {sorted_difference_sse41, sorted_merge_sse41, sorted_includes_sse41};
+#endif
+		default:
+			return {sorted_difference<uint32_t>, sorted_merge<uint32_t>, sorted_includes<uint32_t>};
+		}
+	}
+};
+
+/**
+ * @return the kernels in use, initially the ones of simd_level()
+ */
+inline SortedSetKernels &sorted_set_kernels() {
+	static SortedSetKernels kernels = SortedSetKernels::of(simd_level());
+	return kernels;
+}
+
+/**
+ * Use the kernels of the given level from now on, e.g. to test or benchmark
+ * each level. Not thread-safe with calls of the kernels.
+ *
+ * @pre `level` is supported by the CPU, i.e. not greater than simd_detect()
+ */
+inline void sorted_set_use(SimdLevel level) {
+	assert(level <= simd_detect());
+	sorted_set_kernels() = SortedSetKernels::of(level);
+}
+
+inline uint32_t *sorted_difference(const uint32_t *first1, const uint32_t *last1, const uint32_t *first2,
+		const uint32_t *last2, uint32_t *out) {
+	return sorted_set_kernels().difference(first1, last1, first2, last2, out);
+}
+
+inline uint32_t *sorted_merge(const uint32_t *first1, const uint32_t *last1, const uint32_t *first2,
+		const uint32_t *last2, uint32_t *out) {
+	return sorted_set_kernels().merge(first1, last1, first2, last2, out);
+}
+
+inline bool sorted_includes(const uint32_t *first1, const uint32_t *last1, const uint32_t *first2,
+		const uint32_t *last2) {
+	return sorted_set_kernels().includes(first1, last1, first2, last2);
+}
+
+#endif // SORTED_SET_H
@@ -8,6 +8,7 @@
 #include <utility>
 #include <vector>
 #include <unordered_set>
+#include <boost/unordered_set.hpp>
 #include <boost/graph/graph_traits.hpp>
 #include <boost/range/iterator_range.hpp>
 
@@ -23,7 +24,9 @@ using VertexOrder = std::vector<VertexDesc<Graph>>;
 template <class Graph>
 using EdgeSet = boost::unordered_set<std::pair<VertexDesc<Graph>, VertexDesc<Graph>>>;
 
-#define iter_vertices(g)     boost::make_iterator_range(boost::vertices(g))
-#define iter_neighbors(g, v) boost::make_iterator_range(boost::adjacent_vertices(v, g))
+// Graph functions are called unqualified so that they are found through ADL,
+// which also makes graph types defined outside the boost namespace usable
+#define iter_vertices(g)     boost::make_iterator_range(vertices(g))
+#define iter_neighbors(g, v) boost::make_iterator_range(adjacent_vertices(v, g))
 
 #endif // UTILS_H
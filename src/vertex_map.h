@@ -0,0 +1,212 @@
+/**
+ * Maps and sets keyed by the vertices of a graph, used for the per-vertex state
+ * of the algorithms. If the graph has a vertex_index property map, they are
+ * backed by plain vectors indexed by it, otherwise by the hash tables of a
+ * container policy.
+ */
+
+#ifndef VERTEX_MAP_H
+#define VERTEX_MAP_H
+
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/properties.hpp>
+
+#include "utils.h"
+#include "flat_hash.h"
+
+/**
+ * Container policy using the node-based hash containers of the standard
+ * library.
+ */
+struct StdContainers {
+	template <class Key, class Value>
+	using Map = std::unordered_map<Key, Value>;
+
+	template <class Key>
+	using Set = std::unordered_set<Key>;
+};
+
+/**
+ * Container policy using open-addressing hash containers.
+ */
+struct FlatContainers {
+	template <class Key, class Value>
+	using Map = FlatHashMap<Key, Value>;
+
+	template <class Key>
+	using Set = FlatHashSet<Key>;
+};
+
+typedef FlatContainers DefaultContainers;
+
+template <class Graph>
+struct IsAdjacencyList : std::false_type {};
+
+template <class OEL, class VL, class D, class VP, class EP, class GP, class EL>
+struct IsAdjacencyList<boost::adjacency_list<OEL, VL, D, VP, EP, GP, EL>> : std::true_type {};
+
+// Asking an adjacency_list for a property it does not have is a hard error, so
+// look at its vertex storage and vertex properties instead
+template <class Graph>
+struct AdjacencyListHasVertexIndex : std::false_type {};
+
+template <class OEL, class VL, class D, class VP, class EP, class GP, class EL>
+struct AdjacencyListHasVertexIndex<boost::adjacency_list<OEL, VL, D, VP, EP, GP, EL>>
+	: std::integral_constant<bool, std::is_same<VL, boost::vecS>::value
+		|| boost::lookup_one_property<VP, boost::vertex_index_t>::found> {};
+
+template <class Graph, class = void>
+struct GraphHasVertexIndex : std::false_type {};
+
+template <class Graph>
+struct GraphHasVertexIndex<Graph, std::void_t<decltype(get(boost::vertex_index, std::declval<const Graph &>()))>>
+	: std::true_type {};
+
+/**
+ * Whether get(boost::vertex_index, g) is available for graphs of the given
+ * type, mapping their vertices to the integers in [0, num_vertices(g)).
+ */
+template <class Graph>
+struct HasVertexIndex : std::conditional_t<IsAdjacencyList<Graph>::value,
+	AdjacencyListHasVertexIndex<Graph>, GraphHasVertexIndex<Graph>> {};
+
+template <class Graph>
+using VertexIndexMap = decltype(get(boost::vertex_index, std::declval<const Graph &>()));
+
+/**
+ * Map of the vertices of a graph to values of type T, with all the values
+ * initially default-constructed.
+ */
+template <class Graph, class T, class Containers = DefaultContainers, bool Indexed = HasVertexIndex<Graph>::value>
+class VertexStateMap;
+
+template <class Graph, class T, class Containers>
+class VertexStateMap<Graph, T, Containers, true> {
+public:
+	typedef VertexDesc<Graph> key_type;
+	typedef T mapped_type;
+
+	// The reference of std::vector<bool> is not a real reference
+	static_assert(!std::is_same<T, bool>::value);
+
+	VertexStateMap(const Graph &g) : index_(get(boost::vertex_index, g)), values_(num_vertices(g)) {}
+
+	T &operator[](key_type v) {
+		return values_[get(index_, v)];
+	}
+
+private:
+	VertexIndexMap<Graph> index_;
+	std::vector<T> values_;
+};
+
+template <class Graph, class T, class Containers>
+class VertexStateMap<Graph, T, Containers, false> {
+public:
+	typedef VertexDesc<Graph> key_type;
+	typedef T mapped_type;
+
+	VertexStateMap(const Graph &g) : values_(num_vertices(g)) {}
+
+	T &operator[](key_type v) {
+		return values_[v];
+	}
+
+private:
+	typename Containers::template Map<key_type, T> values_;
+};
+
+/**
+ * Set of vertices of a graph, initially empty.
+ */
+template <class Graph, class Containers = DefaultContainers, bool Indexed = HasVertexIndex<Graph>::value>
+class VertexStateSet;
+
+template <class Graph, class Containers>
+class VertexStateSet<Graph, Containers, true> {
+public:
+	typedef VertexDesc<Graph> value_type;
+
+	VertexStateSet(const Graph &g) : index_(get(boost::vertex_index, g)), stamp_(num_vertices(g)) {}
+
+	/**
+	 * @return true/false whether v was inserted (i.e. was not already present)
+	 */
+	bool insert(value_type v) {
+		unsigned &s = stamp_[get(index_, v)];
+
+		if (s == cur_stamp_)
+			return false;
+
+		s = cur_stamp_;
+		size_++;
+		return true;
+	}
+
+	/**
+	 * @return true/false whether v was erased (i.e. was present)
+	 */
+	bool erase(value_type v) {
+		unsigned &s = stamp_[get(index_, v)];
+
+		if (s != cur_stamp_)
+			return false;
+
+		s = 0;
+		size_--;
+		return true;
+	}
+
+	bool contains(value_type v) const {
+		return stamp_[get(index_, v)] == cur_stamp_;
+	}
+
+	size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+
+	/**
+	 * Remove all the vertices, in constant time except once every 2^32 calls.
+	 */
+	void clear() {
+		if (++cur_stamp_ == 0) {
+			std::fill(stamp_.begin(), stamp_.end(), 0);
+			cur_stamp_ = 1;
+		}
+
+		size_ = 0;
+	}
+
+private:
+	VertexIndexMap<Graph> index_;
+	// A vertex is in the set iff its stamp is the current one
+	std::vector<unsigned> stamp_;
+	unsigned cur_stamp_ = 1;
+	size_t size_ = 0;
+};
+
+template <class Graph, class Containers>
+class VertexStateSet<Graph, Containers, false> {
+public:
+	typedef VertexDesc<Graph> value_type;
+
+	VertexStateSet(const Graph &g) : set_(num_vertices(g)) {}
+
+	bool insert(value_type v) { return set_.insert(v).second; }
+	bool erase(value_type v) { return set_.erase(v) > 0; }
+	bool contains(value_type v) const { return set_.count(v) > 0; }
+	size_t size() const { return set_.size(); }
+	bool empty() const { return set_.empty(); }
+	void clear() { set_.clear(); }
+
+private:
+	typename Containers::template Set<value_type> set_;
+};
+
+#endif // VERTEX_MAP_H
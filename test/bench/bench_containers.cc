@@ -0,0 +1,139 @@
+#include <new>
+#include <cstdlib>
+#include <malloc.h>
+#include <boost/graph/adjacency_list.hpp>
+#include <benchmark/benchmark.h>
+
+#include "algos.h"
+#include "random_graph.h"
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+typedef boost::adjacency_list<boost::vecS, boost::listS, boost::undirectedS> ListGraph;
+
+// Track the memory allocated through operator new to report the peak memory
+// usage of each algorithm along with its running time, counting the whole
+// usable size of each block, so that the overhead of the many small blocks of
+// node-based containers is not left out
+static size_t allocated_memory;
+static size_t max_allocated_memory;
+
+void *operator new(size_t size) {
+	size_t *p = static_cast<size_t *>(std::malloc(size + sizeof(size_t)));
+
+	if (!p)
+		throw std::bad_alloc();
+
+	*p = malloc_usable_size(p);
+	allocated_memory += *p;
+	max_allocated_memory = std::max(max_allocated_memory, allocated_memory);
+	return p + 1;
+}
+
+void operator delete(void *ptr) noexcept {
+	if (!ptr)
+		return;
+
+	size_t *p = static_cast<size_t *>(ptr) - 1;
+	allocated_memory -= *p;
+	std::free(p);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+	operator delete(ptr);
+}
+
+static void start_trace() {
+	max_allocated_memory = allocated_memory;
+}
+
+static size_t stop_trace(size_t base) {
+	return max_allocated_memory - base;
+}
+
+/**
+ * Copy a graph into a graph without vertex index, also translating an order.
+ */
+static ListGraph to_list_graph(const Graph &src, const VertexOrder<Graph> &o, VertexOrder<ListGraph> &lo) {
+	ListGraph g;
+	std::vector<VertexDesc<ListGraph>> v;
+
+	for (unsigned i = 0; i < boost::num_vertices(src); i++)
+		v.push_back(boost::add_vertex(g));
+
+	for (const auto e : boost::make_iterator_range(boost::edges(src)))
+		boost::add_edge(v[boost::source(e, src)], v[boost::target(e, src)], g);
+
+	for (const auto i : o)
+		lo.push_back(v[i]);
+
+	return g;
+}
+
+template <class G, class Containers, class F>
+static void run(benchmark::State &state, const G &g, F f) {
+	size_t peak = 0;
+
+	for (auto _ : state) {
+		const size_t base = allocated_memory;
+
+		start_trace();
+		benchmark::DoNotOptimize(f());
+		peak = stop_trace(base);
+	}
+
+	state.counters["peak_bytes"] = peak;
+	state.counters["v"] = boost::num_vertices(g);
+}
+
+template <class G, class Containers>
+void fill_in_random_graph(benchmark::State &state) {
+	const Graph src = gen_random_connected_graph<Graph>(state.range(0), 0.05);
+	VertexOrder<ListGraph> lo;
+	const auto o = gen_random_order(src);
+	const auto lg = to_list_graph(src, o, lo);
+
+	if constexpr (std::is_same<G, Graph>::value)
+		run<G, Containers>(state, src, [&] { return fill_in<G, Containers>(src, o); });
+	else
+		run<G, Containers>(state, lg, [&] { return fill_in<G, Containers>(lg, lo); });
+}
+
+template <class G, class Containers>
+void lex_m_random_graph(benchmark::State &state) {
+	const Graph src = gen_random_connected_graph<Graph>(state.range(0), 0.05);
+	VertexOrder<ListGraph> lo;
+	const auto lg = to_list_graph(src, {}, lo);
+
+	if constexpr (std::is_same<G, Graph>::value)
+		run<G, Containers>(state, src, [&] { return lex_m<G, Containers>(src); });
+	else
+		run<G, Containers>(state, lg, [&] { return lex_m<G, Containers>(lg); });
+}
+
+template <class G, class Containers>
+void lex_p_chordal_graph(benchmark::State &state) {
+	const Graph src = gen_random_chordal_graph<Graph>(state.range(0), 20 * state.range(0));
+	VertexOrder<ListGraph> lo;
+	const auto lg = to_list_graph(src, {}, lo);
+
+	if constexpr (std::is_same<G, Graph>::value)
+		run<G, Containers>(state, src, [&] { return lex_p<G, Containers>(src); });
+	else
+		run<G, Containers>(state, lg, [&] { return lex_p<G, Containers>(lg); });
+}
+
+#define bench(func, graph, containers, start, end) \
+	BENCHMARK_TEMPLATE(func, graph, containers)    \
+		->RangeMultiplier(4)                       \
+		->Range(start, end)                        \
+		->Unit(benchmark::kMillisecond)
+
+// Graphs without vertex index: all the per-vertex state is hashed
+bench(fill_in_random_graph, ListGraph, StdContainers , 256, 4096);
+bench(fill_in_random_graph, ListGraph, FlatContainers, 256, 4096);
+bench(lex_m_random_graph  , ListGraph, StdContainers , 256, 1024);
+bench(lex_m_random_graph  , ListGraph, FlatContainers, 256, 1024);
+bench(lex_p_chordal_graph , ListGraph, StdContainers , 1024, 16384);
+bench(lex_p_chordal_graph , ListGraph, FlatContainers, 1024, 16384);
+
+BENCHMARK_MAIN();
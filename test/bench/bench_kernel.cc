@@ -0,0 +1,78 @@
+/**
+ * Benchmark of the specialized Cholesky kernel generated by gen_kernel against
+ * the generic factorization loop of cholesky_factorize() on the same plan.
+ */
+
+#include <cmath>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <benchmark/benchmark.h>
+
+#include "elim_plan.h"
+#include "bench_kernel_gen.h"
+
+static EliminationPlan kernel_plan() {
+	EliminationPlan plan;
+	const size_t nnz = sizeof(kernel_row_ind) / sizeof(*kernel_row_ind);
+
+	plan.n = kernel_n;
+	plan.col_ptr.assign(kernel_col_ptr, kernel_col_ptr + kernel_n + 1);
+	plan.row_ind.assign(kernel_row_ind, kernel_row_ind + nnz);
+	return plan;
+}
+
+static std::vector<double> initial_values() {
+	return std::vector<double>(kernel_values, kernel_values + sizeof(kernel_values) / sizeof(*kernel_values));
+}
+
+void generic_factorize(benchmark::State& state) {
+	const auto plan = kernel_plan();
+	auto values = initial_values();
+
+	for (auto _ : state) {
+		std::copy(kernel_values, kernel_values + values.size(), values.begin());
+		cholesky_factorize(plan, values.data());
+		benchmark::DoNotOptimize(values.data());
+	}
+
+	state.counters["n"] = plan.n;
+	state.counters["nnz"] = plan.row_ind.size();
+}
+
+void generated_factorize(benchmark::State& state) {
+	auto values = initial_values();
+
+	for (auto _ : state) {
+		std::copy(kernel_values, kernel_values + values.size(), values.begin());
+		kernel_factorize(values.data());
+		benchmark::DoNotOptimize(values.data());
+	}
+
+	state.counters["n"] = kernel_n;
+	state.counters["nnz"] = values.size() - kernel_n;
+}
+
+BENCHMARK(generic_factorize);
+BENCHMARK(generated_factorize);
+
+int main(int argc, char **argv) {
+	auto a = initial_values();
+	auto b = initial_values();
+
+	// Make sure that the generated kernel actually computes the same factor
+	cholesky_factorize(kernel_plan(), a.data());
+	kernel_factorize(b.data());
+
+	for (size_t i = 0; i < a.size(); i++) {
+		if (std::abs(a[i] - b[i]) > 1e-9 * std::abs(a[i])) {
+			std::cerr << "Generated kernel mismatch at value " << i << ": "
+			          << b[i] << " != " << a[i] << '\n';
+			return 1;
+		}
+	}
+
+	benchmark::Initialize(&argc, argv);
+	benchmark::RunSpecifiedBenchmarks();
+	return 0;
+}
@@ -0,0 +1,101 @@
+/**
+ * Generate a specialized Cholesky factorization kernel for a fixed sparsity
+ * pattern, along with the plan and the initial values of a matrix having that
+ * pattern, to be benchmarked against the generic factorization loop by
+ * bench_kernel.cc.
+ *
+ * Usage: gen_kernel OUTPUT_HEADER [GRAPHVIZ_DOT_FILE]
+ *
+ * Without a DOT file, the pattern is the one of a 5-point stencil on a 6x6 grid.
+ * The elimination order is computed by lex_m().
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/graphviz.hpp>
+
+#include "algos.h"
+#include "elim_plan.h"
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+
+static Graph grid_graph(unsigned rows, unsigned cols) {
+	Graph g(rows * cols);
+
+	for (unsigned r = 0; r < rows; r++) {
+		for (unsigned c = 0; c < cols; c++) {
+			if (r + 1 < rows)
+				boost::add_edge(r * cols + c, (r + 1) * cols + c, g);
+			if (c + 1 < cols)
+				boost::add_edge(r * cols + c, r * cols + c + 1, g);
+		}
+	}
+
+	return g;
+}
+
+template <class T>
+static void emit_array(std::ostream &out, const char *type, const char *name, const std::vector<T> &v) {
+	out << "static const " << type << ' ' << name << "[] = {";
+
+	for (size_t i = 0; i < v.size(); i++)
+		out << (i % 16 ? " " : "\n\t") << v[i] << ',';
+
+	out << "\n};\n\n";
+}
+
+int main(int argc, char **argv) {
+	Graph g;
+
+	if (argc < 2 || argc > 3) {
+		std::cerr << "Usage: " << argv[0] << " OUTPUT_HEADER [GRAPHVIZ_DOT_FILE]\n";
+		return 1;
+	}
+
+	if (argc == 3) {
+		std::ifstream in(argv[2]);
+		boost::dynamic_properties dp(boost::ignore_other_properties);
+
+		if (!in || !boost::read_graphviz(in, g, dp)) {
+			std::cerr << "Could not read graph from " << argv[2] << '\n';
+			return 1;
+		}
+	} else {
+		g = grid_graph(6, 6);
+	}
+
+	const auto order = lex_m(g);
+	const auto plan  = make_elimination_plan(g, order);
+	std::vector<size_t> index_of(plan.n);
+	std::vector<double> values(plan.n_values());
+
+	for (size_t i = 0; i < plan.n; i++)
+		index_of[order[i]] = i;
+
+	// Shifted graph Laplacian, which is symmetric positive definite
+	for (const auto v : iter_vertices(g)) {
+		values[index_of[v]] = boost::degree(v, g) + 1;
+
+		for (const auto w : iter_neighbors(g, v)) {
+			if (index_of[v] > index_of[w])
+				values[plan.position(index_of[v], index_of[w])] = -1;
+		}
+	}
+
+	std::ofstream out(argv[1]);
+	out << "// Generated by gen_kernel, do not edit.\n\n#include <cmath>\n#include <cstddef>\n\n";
+	out << "static const size_t kernel_n = " << plan.n << ";\n\n";
+	emit_array(out, "size_t", "kernel_col_ptr", plan.col_ptr);
+	emit_array(out, "unsigned", "kernel_row_ind", plan.row_ind);
+	emit_array(out, "double", "kernel_values", values);
+	emit_cholesky_kernel(plan, out, "kernel_factorize");
+
+	std::cout << "Generated kernel for " << plan.n << " rows, " << plan.row_ind.size()
+	          << " off-diagonal nonzeros (" << plan.row_ind.size() - boost::num_edges(g)
+	          << " fill-in)\n";
+
+	return out ? 0 : 1;
+}
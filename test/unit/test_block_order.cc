@@ -0,0 +1,171 @@
+#include <vector>
+#include <random>
+#include <unordered_set>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "block_order.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+typedef VertexDesc<Graph> Vertex;
+
+BOOST_AUTO_TEST_SUITE(BlockOrder)
+
+/**
+ * Helper function: create a connected graph with many articulation points, by
+ * joining random connected graphs (or single edges) at random vertices.
+ */
+static Graph gen_blocky_graph(unsigned n_parts, unsigned part_size, double edge_prob) {
+	static std::mt19937 gen{std::random_device{}()};
+	Graph g(1);
+
+	for (unsigned i = 0; i < n_parts; i++) {
+		const Graph part = i % 3 ? gen_random_connected_graph<Graph>(part_size, edge_prob) : Graph(2);
+		const Vertex join = std::uniform_int_distribution<Vertex>(0, boost::num_vertices(g) - 1)(gen);
+		const Vertex base = boost::num_vertices(g) - 1;
+
+		// Vertex 0 of the part is the join vertex, the others are new
+		for (Vertex v = 1; v < boost::num_vertices(part); v++)
+			boost::add_vertex(g);
+
+		auto map = [&](Vertex v) { return v == 0 ? join : base + v; };
+
+		if (i % 3 == 0)
+			boost::add_edge(join, base + 1, g);
+
+		for (const auto e : boost::make_iterator_range(boost::edges(part)))
+			boost::add_edge(map(boost::source(e, part)), map(boost::target(e, part)), g);
+	}
+
+	return g;
+}
+
+/**
+ * Helper function: check that a chordal supergraph of a graph is a minimal
+ * triangulation, i.e. that removing any single fill edge makes it non-chordal.
+ */
+static bool is_minimal_triangulation(const Graph &g, const EdgeSet<Graph> &fill) {
+	for (const auto &e : fill) {
+		Graph h(g);
+
+		for (const auto &f : fill) {
+			if (f != e)
+				boost::add_edge(f.first, f.second, h);
+		}
+
+		if (is_perfect_elimination_order(h, lex_p(h)))
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * Ensure that biconnected_blocks() puts each edge in exactly one block, that
+ * the blocks cannot be split further and that each block comes after the blocks
+ * hanging from its vertices.
+ */
+BOOST_AUTO_TEST_CASE(blocks_partition_edges) {
+	REPEAT(20) {
+		Graph g = gen_blocky_graph(12, 8, 0.3);
+		const auto snap = make_csr_snapshot(g);
+		std::vector<unsigned> roots;
+		const auto blocks = biconnected_blocks(snap.graph, roots);
+		std::vector<bool> eliminated(boost::num_vertices(g));
+		size_t n_edges = 0;
+
+		BOOST_CHECK_EQUAL(roots.size(), 1);
+
+		for (const auto &b : blocks) {
+			std::unordered_set<unsigned> in_block(b.vertices.begin(), b.vertices.end());
+
+			BOOST_CHECK_EQUAL(in_block.size(), b.vertices.size());
+			n_edges += b.edges.size();
+
+			for (const auto &[x, y] : b.edges) {
+				BOOST_CHECK(x < b.vertices.size() && y < b.vertices.size());
+				BOOST_CHECK(boost::edge(snap.vertices[b.vertices[x]], snap.vertices[b.vertices[y]], g).second);
+			}
+
+			// Vertices of blocks that come later were not eliminated yet
+			for (const auto v : b.vertices)
+				BOOST_CHECK(!eliminated[v]);
+
+			for (size_t j = 0; j + 1 < b.vertices.size(); j++)
+				eliminated[b.vertices[j]] = true;
+
+			// A block is either a bridge or has no articulation point
+			if (b.vertices.size() > 2) {
+				const auto sub = make_csr_graph<unsigned>(b.vertices.size(), b.edges);
+				std::vector<unsigned> sub_roots;
+
+				BOOST_CHECK_EQUAL(biconnected_blocks(sub, sub_roots).size(), 1);
+			}
+		}
+
+		BOOST_CHECK_EQUAL(n_edges, boost::num_edges(g));
+	}
+}
+
+/**
+ * Ensure that block_lex_m() computes a minimal elimination order for connected
+ * graphs with many articulation points, and the same one for any number of
+ * threads.
+ */
+BOOST_AUTO_TEST_CASE(order_is_minimal) {
+	REPEAT(20) {
+		Graph g = gen_blocky_graph(6, 10, 0.3);
+		const auto o = block_lex_m(g);
+		const auto f = fill_in(g, o);
+
+		BOOST_CHECK(is_minimal_triangulation(g, f));
+		BOOST_CHECK(block_lex_m(g, 3) == o);
+	}
+}
+
+/**
+ * Ensure that the elimination order computed by block_lex_m() on a chordal
+ * graph is perfect (i.e. it has empty fill-in).
+ */
+BOOST_AUTO_TEST_CASE(order_is_perfect_for_chordal_graphs) {
+	REPEAT(10) {
+		Graph g = gen_random_chordal_graph<Graph>(300, 3000);
+		const auto o = block_lex_m(g, 2);
+
+		BOOST_CHECK_EQUAL(fill_in(g, o).size(), 0);
+		BOOST_CHECK(is_perfect_elimination_order(g, o));
+	}
+}
+
+/**
+ * Ensure that block_lex_m() orders all the vertices of disconnected graphs,
+ * including isolated ones, without any fill-in between components.
+ */
+BOOST_AUTO_TEST_CASE(disconnected_graphs) {
+	REPEAT(10) {
+		Graph g = gen_blocky_graph(5, 6, 0.4);
+		const Graph h = gen_blocky_graph(5, 6, 0.4);
+		const Vertex base = boost::num_vertices(g);
+
+		for (Vertex v = 0; v < boost::num_vertices(h) + 2; v++)
+			boost::add_vertex(g);
+
+		for (const auto e : boost::make_iterator_range(boost::edges(h)))
+			boost::add_edge(base + boost::source(e, h), base + boost::target(e, h), g);
+
+		const auto o = block_lex_m(g, 2);
+		const std::unordered_set<Vertex> seen(o.begin(), o.end());
+
+		BOOST_CHECK_EQUAL(o.size(), boost::num_vertices(g));
+		BOOST_CHECK_EQUAL(seen.size(), o.size());
+
+		for (const auto &[a, b] : fill_in(g, o))
+			BOOST_CHECK((a < base) == (b < base));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
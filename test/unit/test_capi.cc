@@ -0,0 +1,225 @@
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "aa.h"
+#include "algos.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+
+BOOST_AUTO_TEST_SUITE(CApi)
+
+/**
+ * Helper struct: CSR arrays of a graph with integers of the given type.
+ */
+template <class Int>
+struct Csr {
+	std::vector<Int> offsets;
+	std::vector<Int> targets;
+
+	Csr(const Graph &g) : offsets(1, 0) {
+		for (const auto v : iter_vertices(g)) {
+			for (const auto w : iter_neighbors(g, v))
+				targets.push_back(w);
+
+			offsets.push_back(targets.size());
+		}
+	}
+};
+
+/**
+ * Helper function: check whether an order is a permutation of [0, n).
+ */
+template <class Int>
+static bool is_permutation_of_vertices(std::vector<Int> order) {
+	std::sort(order.begin(), order.end());
+
+	for (size_t i = 0; i < order.size(); i++) {
+		if (order[i] != static_cast<Int>(i))
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * Ensure that the orders computed through the C interface are the expected
+ * ones, and that fill-in computed through it matches the one computed by the
+ * library.
+ */
+BOOST_AUTO_TEST_CASE(orders_and_fill) {
+	REPEAT(10) {
+		Graph g = gen_random_chordal_graph<Graph>(200, 3000);
+		const int32_t n = boost::num_vertices(g);
+		Csr<int32_t> c(g);
+		std::vector<int32_t> order(n);
+		int64_t count = -1;
+		int peo = 0;
+
+		BOOST_REQUIRE_EQUAL(aa_lex_p_csr(n, c.offsets.data(), c.targets.data(), order.data(), nullptr), AA_OK);
+		BOOST_CHECK(is_permutation_of_vertices(order));
+		BOOST_REQUIRE_EQUAL(aa_is_peo_csr(n, c.offsets.data(), c.targets.data(), order.data(), &peo, nullptr), AA_OK);
+		BOOST_CHECK_EQUAL(peo, 1);
+
+		BOOST_REQUIRE_EQUAL(aa_lex_m_csr(n, c.offsets.data(), c.targets.data(), order.data(), nullptr), AA_OK);
+		BOOST_CHECK(is_permutation_of_vertices(order));
+		BOOST_REQUIRE_EQUAL(aa_fill_count_csr(n, c.offsets.data(), c.targets.data(), order.data(), &count, nullptr), AA_OK);
+		BOOST_CHECK_EQUAL(count, 0);
+	}
+
+	REPEAT(10) {
+		Graph g = gen_random_connected_graph<Graph>(100, 0.1);
+		const int64_t n = boost::num_vertices(g);
+		const auto o = gen_random_order(g);
+		const auto expected = fill_in(g, o);
+		Csr<int64_t> c(g);
+		std::vector<int64_t> order(o.begin(), o.end());
+		std::vector<int64_t> edges(2 * expected.size());
+		int64_t count = -1;
+		int peo = 1;
+
+		BOOST_REQUIRE_EQUAL(aa_fill_count_csr64(n, c.offsets.data(), c.targets.data(), order.data(), &count, nullptr), AA_OK);
+		BOOST_CHECK_EQUAL(count, expected.size());
+
+		BOOST_REQUIRE_EQUAL(aa_fill_in_csr64(n, c.offsets.data(), c.targets.data(), order.data(),
+				expected.size(), edges.data(), &count, nullptr), AA_OK);
+		BOOST_REQUIRE_EQUAL(count, expected.size());
+
+		for (int64_t i = 0; i < count; i++) {
+			BOOST_CHECK(edges[2 * i] < edges[2 * i + 1]);
+			BOOST_CHECK(expected.count({edges[2 * i], edges[2 * i + 1]}));
+		}
+
+		BOOST_REQUIRE_EQUAL(aa_is_peo_csr64(n, c.offsets.data(), c.targets.data(), order.data(), &peo, nullptr), AA_OK);
+		BOOST_CHECK_EQUAL(peo, expected.empty());
+	}
+}
+
+/**
+ * Ensure that nested dissection and exact orders are available through the C
+ * interface, including with a workspace.
+ */
+BOOST_AUTO_TEST_CASE(options_and_workspace) {
+	aa_workspace *ws = aa_workspace_create();
+	aa_options opts;
+
+	BOOST_REQUIRE(ws);
+	aa_options_init(&opts);
+	opts.n_threads = 2;
+	opts.workspace = ws;
+
+	REPEAT(5) {
+		Graph g = gen_random_connected_graph<Graph>(200, 0.05);
+		const int32_t n = boost::num_vertices(g);
+		Csr<int32_t> c(g);
+		std::vector<int32_t> order(n), forked(n);
+
+		BOOST_REQUIRE_EQUAL(aa_nd_order_csr(n, c.offsets.data(), c.targets.data(), order.data(), &opts), AA_OK);
+		BOOST_CHECK(is_permutation_of_vertices(order));
+
+		// Worker processes give the same order
+		opts.flags = AA_FLAG_FORK;
+		BOOST_REQUIRE_EQUAL(aa_nd_order_csr(n, c.offsets.data(), c.targets.data(), forked.data(), &opts), AA_OK);
+		BOOST_CHECK(forked == order);
+		opts.flags = 0;
+	}
+
+	REPEAT(5) {
+		Graph g = gen_random_connected_graph<Graph>(10, 0.4);
+		const int32_t n = boost::num_vertices(g);
+		const auto o = exact_order(g);
+		Csr<int32_t> c(g);
+		std::vector<int32_t> order(n);
+		int64_t count = -1;
+
+		// The second call gets the order from the cache of the workspace
+		for (unsigned k = 0; k < 2; k++) {
+			BOOST_REQUIRE_EQUAL(aa_exact_order_csr(n, c.offsets.data(), c.targets.data(), AA_OBJECTIVE_FILL,
+					order.data(), &opts), AA_OK);
+			BOOST_REQUIRE_EQUAL(aa_fill_count_csr(n, c.offsets.data(), c.targets.data(), order.data(),
+					&count, &opts), AA_OK);
+			BOOST_CHECK_EQUAL(count, fill_in(g, o).size());
+		}
+	}
+
+	aa_workspace_destroy(ws);
+}
+
+/**
+ * Ensure that invalid inputs are rejected with the appropriate status codes,
+ * and that the empty graph is handled.
+ */
+BOOST_AUTO_TEST_CASE(invalid_inputs) {
+	// Path 0--1--2
+	std::vector<int32_t> offsets = {0, 1, 3, 4};
+	std::vector<int32_t> targets = {1, 0, 2, 1};
+	std::vector<int32_t> order = {1, 0, 2};
+	std::vector<int32_t> edges(2);
+	int64_t count = -1;
+	aa_options opts;
+
+	BOOST_CHECK_EQUAL(aa_lex_m_csr(3, offsets.data(), targets.data(), nullptr, nullptr), AA_EINVAL);
+	BOOST_CHECK_EQUAL(aa_lex_m_csr(-1, offsets.data(), targets.data(), order.data(), nullptr), AA_EINVAL);
+	BOOST_CHECK_EQUAL(aa_lex_m_csr(3, nullptr, targets.data(), order.data(), nullptr), AA_EINVAL);
+	BOOST_CHECK_EQUAL(aa_exact_order_csr(65, offsets.data(), targets.data(), AA_OBJECTIVE_FILL,
+			order.data(), nullptr), AA_ETOOBIG);
+
+	BOOST_CHECK_EQUAL(aa_fill_in_csr(3, offsets.data(), targets.data(), order.data(), 0, nullptr,
+			&count, nullptr), AA_ERANGE);
+	BOOST_CHECK_EQUAL(count, 1);
+	BOOST_CHECK_EQUAL(aa_fill_in_csr(3, offsets.data(), targets.data(), order.data(), 1, edges.data(),
+			&count, nullptr), AA_OK);
+	BOOST_CHECK(edges == std::vector<int32_t>({0, 2}));
+
+	order = {0, 0, 1};
+	BOOST_CHECK_EQUAL(aa_fill_count_csr(3, offsets.data(), targets.data(), order.data(), &count, nullptr), AA_EORDER);
+
+	order = {0, 1, 2};
+	targets[3] = 3;
+	BOOST_CHECK_EQUAL(aa_fill_count_csr(3, offsets.data(), targets.data(), order.data(), &count, nullptr), AA_EINVAL);
+
+	targets[3] = 2;
+	BOOST_CHECK_EQUAL(aa_fill_count_csr(3, offsets.data(), targets.data(), order.data(), &count, nullptr), AA_EINVAL);
+
+	targets[3] = 1;
+	offsets[2] = 0;
+	BOOST_CHECK_EQUAL(aa_fill_count_csr(3, offsets.data(), targets.data(), order.data(), &count, nullptr), AA_EINVAL);
+
+	// Duplicate neighbors, with matching degrees
+	std::vector<int32_t> dup_offsets = {0, 2, 4, 4};
+	std::vector<int32_t> dup_targets = {1, 1, 0, 0};
+	BOOST_CHECK_EQUAL(aa_fill_count_csr(3, dup_offsets.data(), dup_targets.data(), order.data(), &count,
+			nullptr), AA_EINVAL);
+
+	// Edges 0->1 only, then cycle 0->1->2->0 with matching degrees
+	std::vector<int32_t> arc_offsets = {0, 1, 1, 1};
+	std::vector<int32_t> arc_targets = {1, 2, 0};
+	BOOST_CHECK_EQUAL(aa_fill_count_csr(3, arc_offsets.data(), arc_targets.data(), order.data(), &count,
+			nullptr), AA_EINVAL);
+
+	arc_offsets = {0, 1, 2, 3};
+	BOOST_CHECK_EQUAL(aa_fill_count_csr(3, arc_offsets.data(), arc_targets.data(), order.data(), &count,
+			nullptr), AA_EINVAL);
+
+	// Validation can be disabled for inputs that are known to be valid
+	offsets[2] = 3;
+	aa_options_init(&opts);
+	opts.flags = AA_FLAG_NO_VALIDATE;
+	BOOST_CHECK_EQUAL(aa_fill_count_csr(3, offsets.data(), targets.data(), order.data(), &count, &opts), AA_OK);
+	BOOST_CHECK_EQUAL(count, 0);
+
+	offsets = {0};
+	BOOST_CHECK_EQUAL(aa_lex_p_csr(0, offsets.data(), nullptr, order.data(), nullptr), AA_OK);
+	BOOST_CHECK_EQUAL(aa_fill_count_csr(0, offsets.data(), nullptr, order.data(), &count, nullptr), AA_OK);
+	BOOST_CHECK_EQUAL(count, 0);
+
+	BOOST_CHECK(aa_strerror(AA_ENOMEM) != aa_strerror(AA_OK));
+	BOOST_CHECK_EQUAL(aa_api_version(), AA_API_VERSION);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,91 @@
+#include <set>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "chordal_subgraph.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+
+BOOST_AUTO_TEST_SUITE(ChordalSubgraphs)
+
+/**
+ * Helper function: check whether a connected graph is chordal.
+ */
+static bool is_chordal(const CsrGraph<> &g) {
+	return is_perfect_elimination_order(g, lex_p(g));
+}
+
+/**
+ * Ensure that the subgraph only has edges of the graph, that the identity is a
+ * perfect elimination order of it, and that adding any other edge of the graph
+ * makes it non chordal.
+ */
+BOOST_AUTO_TEST_CASE(subgraph_is_maximal_chordal) {
+	REPEAT(20) {
+		const Graph g = gen_random_connected_graph<Graph>(60, 0.05 + 0.01 * i__);
+		const auto sub = maximal_chordal_subgraph(g);
+		const auto identity = std::make_from_tuple<std::vector<unsigned>>(vertices(sub.graph));
+		std::vector<std::pair<unsigned, unsigned>> kept;
+		std::set<std::pair<unsigned, unsigned>> kept_set;
+		std::vector<unsigned> pos(60);
+
+		BOOST_REQUIRE_EQUAL(sub.vertices.size(), 60);
+		BOOST_CHECK(is_perfect_elimination_order(sub.graph, identity));
+
+		for (unsigned i = 0; i < 60; i++)
+			pos[sub.vertices[i]] = i;
+
+		for (const auto v : iter_vertices(sub.graph)) {
+			for (const auto w : iter_neighbors(sub.graph, v)) {
+				BOOST_CHECK(boost::edge(sub.vertices[v], sub.vertices[w], g).second);
+
+				if (v < w) {
+					kept.emplace_back(v, w);
+					kept_set.emplace(v, w);
+				}
+			}
+		}
+
+		BOOST_CHECK_EQUAL(kept.size(), num_edges(sub.graph));
+
+		for (const auto e : boost::make_iterator_range(boost::edges(g))) {
+			const unsigned a = pos[boost::source(e, g)], b = pos[boost::target(e, g)];
+
+			if (kept_set.count({std::min(a, b), std::max(a, b)}))
+				continue;
+
+			auto edges = kept;
+			edges.emplace_back(a, b);
+			BOOST_CHECK(!is_chordal(make_csr_graph(60u, edges)));
+		}
+	}
+}
+
+/**
+ * Ensure that all the edges of chordal graphs are kept, and that unconnected
+ * graphs are handled.
+ */
+BOOST_AUTO_TEST_CASE(chordal_graphs_are_kept) {
+	REPEAT(20) {
+		const Graph g = gen_random_chordal_graph<Graph>(100, 500 + 100 * i__);
+		const auto sub = maximal_chordal_subgraph(g);
+
+		BOOST_CHECK_EQUAL(num_edges(sub.graph), boost::num_edges(g));
+		BOOST_CHECK(is_perfect_elimination_order(g, sub.vertices));
+	}
+
+	const Graph empty(10);
+	const auto sub = maximal_chordal_subgraph(empty);
+
+	BOOST_CHECK_EQUAL(sub.vertices.size(), 10);
+	BOOST_CHECK_EQUAL(num_edges(sub.graph), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
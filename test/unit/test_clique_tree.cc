@@ -0,0 +1,150 @@
+#include <vector>
+#include <algorithm>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "clique_tree.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+
+BOOST_AUTO_TEST_SUITE(CliqueTrees)
+
+/**
+ * Helper function: check that the overlaps are the intersections with the
+ * parents, that parents come after their children, that the cliques containing
+ * each vertex form a subtree, and that each edge of the graph is in a clique.
+ */
+static void check_tree(const Graph &g, const VertexOrder<Graph> &order, const CliqueTree &tree) {
+	const unsigned n = order.size();
+	std::vector<unsigned> pos(n), n_cliques(n, 0), n_overlaps(n, 0);
+
+	BOOST_REQUIRE_EQUAL(tree.overlaps.size(), tree.cliques.size());
+	BOOST_REQUIRE_EQUAL(tree.parent.size(), tree.cliques.size());
+
+	for (unsigned i = 0; i < n; i++)
+		pos[order[i]] = i;
+
+	for (unsigned c = 0; c < tree.cliques.size(); c++) {
+		const auto &clique = tree.cliques[c];
+		const unsigned p = tree.parent[c];
+		std::vector<uint32_t> overlap;
+
+		BOOST_CHECK(std::is_sorted(clique.begin(), clique.end()));
+
+		if (p != CliqueTree::none) {
+			BOOST_CHECK_GT(p, c);
+			std::set_intersection(clique.begin(), clique.end(), tree.cliques[p].begin(), tree.cliques[p].end(),
+				std::back_inserter(overlap));
+		}
+
+		BOOST_CHECK(overlap == tree.overlaps[c]);
+
+		for (const auto v : clique)
+			n_cliques[v]++;
+
+		for (const auto v : overlap)
+			n_overlaps[v]++;
+	}
+
+	for (unsigned v = 0; v < n; v++)
+		BOOST_CHECK_EQUAL(n_cliques[v], n_overlaps[v] + 1);
+
+	for (const auto e : boost::make_iterator_range(boost::edges(g))) {
+		const uint32_t a = pos[boost::source(e, g)], b = pos[boost::target(e, g)];
+
+		BOOST_CHECK(std::any_of(tree.cliques.begin(), tree.cliques.end(), [&](const auto &clique) {
+			return std::binary_search(clique.begin(), clique.end(), a)
+				&& std::binary_search(clique.begin(), clique.end(), b);
+		}));
+	}
+}
+
+/**
+ * Ensure that the cliques of the tree are exactly the maximal cliques of the
+ * filled graph.
+ */
+BOOST_AUTO_TEST_CASE(cliques_are_maximal_cliques_of_completion) {
+	REPEAT(20) {
+		Graph g = gen_random_connected_graph<Graph>(80, 0.03 + 0.005 * i__);
+		const auto order = i__ % 2 ? gen_random_order(g) : lex_m(g);
+		const auto tree = make_clique_tree(g, order);
+		std::vector<unsigned> pos(80);
+		size_t n_entries = 0;
+
+		fill(g, order);
+		check_tree(g, order, tree);
+
+		for (unsigned i = 0; i < 80; i++)
+			pos[order[i]] = i;
+
+		for (const auto &clique : tree.cliques) {
+			std::vector<unsigned> n_adjacent(80, 0);
+
+			// Clique, and no other vertex is adjacent to all its vertices
+			for (const auto a : clique) {
+				for (const auto w : iter_neighbors(g, order[a]))
+					n_adjacent[pos[w]]++;
+			}
+
+			for (unsigned v = 0; v < 80; v++) {
+				const bool in_clique = std::binary_search(clique.begin(), clique.end(), v);
+
+				if (in_clique)
+					BOOST_CHECK_EQUAL(n_adjacent[v], clique.size() - 1);
+				else
+					BOOST_CHECK_LT(n_adjacent[v], clique.size());
+			}
+
+			n_entries += clique.size();
+		}
+
+		// A chordal graph has at most V maximal cliques
+		BOOST_CHECK_LE(tree.cliques.size(), 80);
+		BOOST_CHECK_GT(n_entries, 0);
+	}
+}
+
+/**
+ * Ensure that merging keeps a valid tree whose cost does not increase, and
+ * that cliques are merged into one per connected component when blocks are
+ * expensive enough.
+ */
+BOOST_AUTO_TEST_CASE(merging_decreases_cost) {
+	REPEAT(20) {
+		const Graph g = gen_random_connected_graph<Graph>(100, 0.02 + 0.002 * i__);
+		const auto order = lex_m(g);
+		const auto tree = make_clique_tree(g, order);
+
+		for (const double overhead : {0.0, 100.0, 10000.0}) {
+			const CliqueMergeCost cost{overhead, 1.0};
+			auto merged = tree;
+
+			auto total = [&](const CliqueTree &t) {
+				double sum = 0;
+
+				for (unsigned c = 0; c < t.cliques.size(); c++)
+					sum += cost.block(t.cliques[c].size()) + cost.overlap(t.overlaps[c].size());
+
+				return sum;
+			};
+
+			merge_cliques(merged, cost);
+			check_tree(g, order, merged);
+
+			BOOST_CHECK_LE(merged.cliques.size(), tree.cliques.size());
+			BOOST_CHECK_LE(total(merged), total(tree));
+		}
+
+		auto merged = tree;
+
+		merge_cliques(merged, {1e12, 1.0});
+		BOOST_CHECK_EQUAL(merged.cliques.size(), 1);
+		BOOST_CHECK_EQUAL(merged.cliques[0].size(), 100);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
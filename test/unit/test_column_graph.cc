@@ -0,0 +1,123 @@
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "column_graph.h"
+#include "column_order.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+typedef ColumnIntersectionGraph<> ColumnGraph;
+
+BOOST_AUTO_TEST_SUITE(ColumnGraphs)
+
+/**
+ * Random sparse matrix pattern in row major order, with rows of random sizes.
+ */
+struct RandomMatrix {
+	unsigned n_rows, n_cols;
+	std::vector<size_t> row_ptr;
+	std::vector<unsigned> col_ind;
+
+	RandomMatrix(unsigned n_rows, unsigned n_cols, unsigned max_row_size)
+		: n_rows(n_rows), n_cols(n_cols), row_ptr(1, 0)
+	{
+		static std::mt19937 gen{std::random_device{}()};
+		std::uniform_int_distribution<unsigned> size_dist(0, max_row_size);
+		std::vector<unsigned> cols(n_cols);
+
+		for (unsigned c = 0; c < n_cols; c++)
+			cols[c] = c;
+
+		for (unsigned r = 0; r < n_rows; r++) {
+			std::shuffle(cols.begin(), cols.end(), gen);
+			col_ind.insert(col_ind.end(), cols.begin(), cols.begin() + size_dist(gen));
+			row_ptr.push_back(col_ind.size());
+		}
+	}
+
+	/**
+	 * @return the graph of AᵀA, formed explicitly
+	 */
+	Graph normal_graph() const {
+		Graph g(n_cols);
+
+		for (unsigned r = 0; r < n_rows; r++) {
+			for (size_t p = row_ptr[r]; p < row_ptr[r + 1]; p++) {
+				for (size_t q = p + 1; q < row_ptr[r + 1]; q++) {
+					if (!boost::edge(col_ind[p], col_ind[q], g).second)
+						boost::add_edge(col_ind[p], col_ind[q], g);
+				}
+			}
+		}
+
+		return g;
+	}
+
+	ColumnGraph column_graph() const {
+		return ColumnGraph(n_rows, n_cols, row_ptr.data(), col_ind.data());
+	}
+};
+
+/**
+ * Ensure that the column intersection graph has the same neighbors, degrees
+ * and number of edges as the explicit graph of AᵀA.
+ */
+BOOST_AUTO_TEST_CASE(same_as_normal_graph) {
+	REPEAT(20) {
+		const RandomMatrix a(100 + 10 * i__, 80, 1 + i__ / 4);
+		const Graph expected = a.normal_graph();
+		const ColumnGraph g = a.column_graph();
+
+		BOOST_REQUIRE_EQUAL(num_vertices(g), 80);
+		BOOST_CHECK_EQUAL(num_edges(g), boost::num_edges(expected));
+
+		for (const auto v : iter_vertices(g)) {
+			std::vector<unsigned> adj, expected_adj;
+
+			for (const auto w : iter_neighbors(g, v))
+				adj.push_back(w);
+
+			for (const auto w : iter_neighbors(expected, v))
+				expected_adj.push_back(w);
+
+			std::sort(expected_adj.begin(), expected_adj.end());
+
+			BOOST_CHECK(adj == expected_adj);
+			BOOST_CHECK_EQUAL(degree(v, g), expected_adj.size());
+		}
+	}
+}
+
+/**
+ * Ensure that column_fill_in_count() gives the fill-in of the explicit graph of
+ * AᵀA, for random orders and for the minimum degree order, which is the one
+ * computed on the explicit graph.
+ */
+BOOST_AUTO_TEST_CASE(same_fill_in_as_normal_graph) {
+	REPEAT(20) {
+		const RandomMatrix a(150, 100, 2 + i__ / 4);
+		const Graph expected = a.normal_graph();
+		const ColumnGraph g = a.column_graph();
+
+		REPEAT(5) {
+			const auto order = gen_random_order(expected);
+			const VertexOrder<ColumnGraph> columns(order.begin(), order.end());
+
+			BOOST_CHECK_EQUAL(column_fill_in_count(g, columns), fill_in_count(expected, order));
+		}
+
+		const auto columns = column_minimum_degree_order(g);
+		const auto order = minimum_degree_order(expected);
+
+		BOOST_CHECK(std::equal(columns.begin(), columns.end(), order.begin(), order.end()));
+		BOOST_CHECK_EQUAL(column_fill_in_count(g, columns), fill_in_count(expected, order));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,146 @@
+#include <vector>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "csr_graph.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+
+BOOST_AUTO_TEST_SUITE(CsrGraphModel)
+
+/**
+ * Helper function: copy a boost graph into a CsrGraph.
+ */
+static CsrGraph<> to_csr(const Graph &g) {
+	auto s = make_csr_snapshot(g);
+
+	// Vertex numbering is the same for vecS vertex storage
+	for (unsigned i = 0; i < s.vertices.size(); i++)
+		BOOST_REQUIRE_EQUAL(s.vertices[i], i);
+
+	return s.graph;
+}
+
+/**
+ * Ensure that a CsrGraph exposes the same vertices, neighbors and degrees of
+ * the graph it was built from.
+ */
+BOOST_AUTO_TEST_CASE(same_structure_as_source_graph) {
+	REPEAT(10) {
+		Graph g = gen_random_connected_graph<Graph>(100, 0.2);
+		CsrGraph<> c = to_csr(g);
+
+		BOOST_REQUIRE_EQUAL(num_vertices(c), boost::num_vertices(g));
+		BOOST_CHECK_EQUAL(num_edges(c), boost::num_edges(g));
+
+		for (const auto v : iter_vertices(c)) {
+			BOOST_CHECK_EQUAL(degree(v, c), boost::degree(v, g));
+
+			for (const auto w : iter_neighbors(c, v))
+				BOOST_CHECK(boost::edge(v, w, g).second);
+		}
+	}
+}
+
+/**
+ * Ensure that the algorithms accept a CsrGraph as input, yielding the same
+ * results as for the graph it was built from.
+ */
+BOOST_AUTO_TEST_CASE(algorithms_accept_csr_graph) {
+	REPEAT(10) {
+		Graph g = gen_random_chordal_graph<Graph>(200, 5000);
+		CsrGraph<> c = to_csr(g);
+
+		auto o = lex_p(c);
+		BOOST_CHECK_EQUAL(fill_in(c, o).size(), 0);
+		BOOST_CHECK(is_perfect_elimination_order(c, o));
+
+		o = lex_m(c);
+		BOOST_CHECK_EQUAL(fill_in(c, o).size(), 0);
+	}
+
+	REPEAT(10) {
+		Graph g = gen_random_connected_graph<Graph>(100, 0.1);
+		CsrGraph<> c = to_csr(g);
+		auto o = gen_random_order(g);
+		VertexOrder<CsrGraph<>> oc(o.begin(), o.end());
+
+		BOOST_CHECK_EQUAL(fill_in(c, oc).size(), fill_in(g, o).size());
+	}
+}
+
+/**
+ * Ensure that make_csr_snapshot() correctly maps vertices of graphs without
+ * vecS vertex storage, and that make_induced_csr_graph() keeps exactly the
+ * edges between vertices of the subset.
+ */
+BOOST_AUTO_TEST_CASE(snapshot_and_induced_subgraph) {
+	typedef boost::adjacency_list<boost::setS, boost::listS, boost::undirectedS> ListGraph;
+
+	REPEAT(10) {
+		Graph src = gen_random_connected_graph<Graph>(50, 0.2);
+		ListGraph g;
+		std::vector<VertexDesc<ListGraph>> copy;
+
+		for (unsigned v = 0; v < 50; v++)
+			copy.push_back(boost::add_vertex(g));
+
+		for (const auto e : boost::make_iterator_range(boost::edges(src)))
+			boost::add_edge(copy[boost::source(e, src)], copy[boost::target(e, src)], g);
+
+		auto s = make_csr_snapshot(g);
+
+		BOOST_REQUIRE_EQUAL(num_vertices(s.graph), 50);
+		BOOST_CHECK_EQUAL(num_edges(s.graph), boost::num_edges(g));
+
+		for (const auto v : iter_vertices(s.graph)) {
+			for (const auto w : iter_neighbors(s.graph, v))
+				BOOST_CHECK(boost::edge(s.vertices[v], s.vertices[w], g).second);
+		}
+
+		std::vector<unsigned> subset;
+
+		for (unsigned v = 0; v < 50; v += 2)
+			subset.push_back(v);
+
+		auto h = make_induced_csr_graph(s.graph, subset);
+		size_t n_edges = 0;
+
+		for (const auto a : subset) {
+			for (const auto b : subset)
+				n_edges += a < b && boost::edge(s.vertices[a], s.vertices[b], g).second;
+		}
+
+		BOOST_REQUIRE_EQUAL(num_vertices(h), subset.size());
+		BOOST_CHECK_EQUAL(num_edges(h), n_edges);
+
+		for (const auto v : iter_vertices(h)) {
+			for (const auto w : iter_neighbors(h, v))
+				BOOST_CHECK(boost::edge(s.vertices[subset[v]], s.vertices[subset[w]], g).second);
+		}
+	}
+}
+
+/**
+ * Ensure that make_csr_graph() builds a simple undirected graph from a list of
+ * edges, ignoring self-loops and duplicate edges in either direction.
+ */
+BOOST_AUTO_TEST_CASE(graph_from_edge_list) {
+	const std::vector<std::pair<unsigned, unsigned>> edges = {
+		{0, 1}, {1, 0}, {1, 2}, {2, 2}, {3, 0}, {0, 1}, {2, 1}
+	};
+
+	auto c = make_csr_graph(5U, edges);
+	const std::vector<unsigned> expected = {1, 3, 0, 2, 1, 0};
+
+	BOOST_CHECK_EQUAL(num_vertices(c), 5);
+	BOOST_CHECK_EQUAL(num_edges(c), 3);
+	BOOST_CHECK_EQUAL(degree(4, c), 0);
+	BOOST_CHECK(c.targets() == expected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
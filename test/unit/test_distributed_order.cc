@@ -0,0 +1,159 @@
+#include <new>
+#include <cerrno>
+#include <vector>
+#include <csignal>
+#include <stdexcept>
+#include <unordered_set>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "distributed_order.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+typedef VertexDesc<Graph> Vertex;
+
+BOOST_AUTO_TEST_SUITE(DistributedOrder)
+
+/**
+ * Helper function: create a graph with the pattern of a 5-point stencil on a
+ * rows x cols grid.
+ */
+static Graph grid(unsigned rows, unsigned cols) {
+	Graph g(rows * cols);
+
+	for (unsigned r = 0; r < rows; r++) {
+		for (unsigned c = 0; c < cols; c++) {
+			if (r + 1 < rows)
+				boost::add_edge(r * cols + c, (r + 1) * cols + c, g);
+			if (c + 1 < cols)
+				boost::add_edge(r * cols + c, r * cols + c + 1, g);
+		}
+	}
+
+	return g;
+}
+
+/**
+ * Ensure that NestedDissection::bisect() splits a set of vertices into two
+ * non-adjacent sets and a separator, also for disconnected sets.
+ */
+BOOST_AUTO_TEST_CASE(bisection_is_valid) {
+	REPEAT(20) {
+		Graph g = gen_random_connected_graph<Graph>(200, 0.02);
+		auto s = make_csr_snapshot(g);
+		NestedDissection nd(s.graph);
+		std::vector<unsigned> set, a, b, sep;
+
+		// Every other vertex in the second half of the test cases, which
+		// likely induces a disconnected subgraph
+		for (unsigned v = 0; v < 200; v += 1 + (i__ >= 10))
+			set.push_back(v);
+
+		nd.bisect(set, a, b, sep);
+
+		BOOST_CHECK_EQUAL(a.size() + b.size() + sep.size(), set.size());
+		BOOST_CHECK(!a.empty() && !b.empty());
+
+		std::unordered_set<unsigned> in_a(a.begin(), a.end());
+		std::unordered_set<unsigned> all(a.begin(), a.end());
+		all.insert(b.begin(), b.end());
+		all.insert(sep.begin(), sep.end());
+		BOOST_CHECK_EQUAL(all.size(), set.size());
+
+		for (const auto v : b) {
+			for (const auto w : iter_neighbors(s.graph, v))
+				BOOST_CHECK(in_a.find(w) == in_a.end());
+		}
+	}
+}
+
+/**
+ * Ensure that distributed_order() computes an order of all the vertices of the
+ * graph, for any number of workers.
+ */
+BOOST_AUTO_TEST_CASE(order_is_permutation) {
+	for (unsigned n_workers = 1; n_workers <= 5; n_workers++) {
+		Graph g = gen_random_connected_graph<Graph>(300, 0.02);
+		auto o = distributed_order(g, n_workers);
+		std::unordered_set<Vertex> seen(o.begin(), o.end());
+
+		BOOST_CHECK_EQUAL(o.size(), boost::num_vertices(g));
+		BOOST_CHECK_EQUAL(seen.size(), boost::num_vertices(g));
+	}
+}
+
+/**
+ * Ensure that the nested dissection order computed by distributed_order() on a
+ * grid has a lower fill-in than a random order, and that it is perfect for a
+ * complete graph.
+ */
+BOOST_AUTO_TEST_CASE(order_quality) {
+	Graph g = grid(20, 20);
+	BOOST_CHECK_LT(fill_in(g, distributed_order(g, 4)).size(), fill_in(g, gen_random_order(g)).size());
+
+	Graph complete = gen_random_connected_graph<Graph>(50, 1);
+	BOOST_CHECK(is_perfect_elimination_order(complete, distributed_order(complete, 3)));
+}
+
+/**
+ * Ensure that the parts of workers which exit with an error, are killed or
+ * throw are ordered again by the calling process, giving the same order as
+ * without failures, and that the order is also the same without worker
+ * processes.
+ */
+BOOST_AUTO_TEST_CASE(failed_workers_are_redone) {
+	const pid_t parent = getpid();
+	// Workers ordering a part with an odd number of vertices fail, in turn
+	// with an exit status, by a signal and by an exception
+	const auto failing_order = [parent](const CsrGraph<> &sub) {
+		if (getpid() != parent && num_vertices(sub) % 2 == 1) {
+			if (num_edges(sub) % 3 == 0)
+				_exit(1);
+			else if (num_edges(sub) % 3 == 1)
+				raise(SIGKILL);
+			else
+				throw std::bad_alloc();
+		}
+
+		return lex_m(sub);
+	};
+
+	REPEAT(5) {
+		Graph g = gen_random_connected_graph<Graph>(300, 0.02);
+		const auto expected = distributed_order(g, 4);
+
+		BOOST_CHECK(distributed_order(g, 4, true, failing_order) == expected);
+		BOOST_CHECK(distributed_order(g, 4, false) == expected);
+	}
+}
+
+/**
+ * Ensure that exceptions of the calling process are propagated only after all
+ * the workers are done, so that none is left behind.
+ */
+BOOST_AUTO_TEST_CASE(no_workers_left_on_exceptions) {
+	const pid_t parent = getpid();
+	// Only the calling process fails, ordering the separators
+	const auto failing_order = [parent](const CsrGraph<> &sub) {
+		if (getpid() == parent)
+			throw std::runtime_error("failed");
+
+		return lex_m(sub);
+	};
+
+	REPEAT(5) {
+		Graph g = gen_random_connected_graph<Graph>(300, 0.02);
+
+		BOOST_CHECK_THROW(distributed_order(g, 4, true, failing_order), std::runtime_error);
+		BOOST_CHECK_EQUAL(waitpid(-1, nullptr, WNOHANG), -1);
+		BOOST_CHECK_EQUAL(errno, ECHILD);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
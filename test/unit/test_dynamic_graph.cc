@@ -0,0 +1,156 @@
+#include <set>
+#include <random>
+#include <vector>
+#include <thread>
+#include <utility>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "dynamic_graph.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+typedef std::set<std::pair<unsigned, unsigned>> EdgeList;
+
+BOOST_AUTO_TEST_SUITE(DynamicGraphs)
+
+/**
+ * Helper function: check that a graph has exactly the given edges (u < v),
+ * with sorted neighbors.
+ */
+template <class G>
+static void check_edges(const G &g, unsigned n_vertices, const EdgeList &edges) {
+	EdgeList found;
+
+	BOOST_REQUIRE_EQUAL(num_vertices(g), n_vertices);
+	BOOST_CHECK_EQUAL(num_edges(g), edges.size());
+
+	for (const auto v : iter_vertices(g)) {
+		std::vector<unsigned> neighbors;
+
+		for (const auto w : iter_neighbors(g, v)) {
+			neighbors.push_back(w);
+			found.emplace(std::min(v, w), std::max(v, w));
+			BOOST_CHECK(edge(v, w, g).second);
+		}
+
+		BOOST_CHECK(std::is_sorted(neighbors.begin(), neighbors.end()));
+		BOOST_CHECK_EQUAL(degree(v, g), neighbors.size());
+	}
+
+	BOOST_CHECK(found == edges);
+}
+
+/**
+ * Ensure that random edits give the expected graph, that snapshots are not
+ * affected by later edits and compactions (also read by another thread), and
+ * that compactions start and merge the edits into the base.
+ */
+BOOST_AUTO_TEST_CASE(edits_and_snapshots) {
+	std::mt19937 rng(42);
+
+	for (const double ratio : {0.0, 0.01, 0.5}) {
+		const Graph base = gen_random_connected_graph<Graph>(300, 0.05);
+		const auto snap = make_csr_snapshot(base);
+		DynamicGraph<> g(snap.graph, ratio);
+		EdgeList edges;
+		bool compacted = false;
+
+		for (const auto e : boost::make_iterator_range(boost::edges(base))) {
+			const unsigned u = boost::source(e, base), v = boost::target(e, base);
+			edges.emplace(std::min(u, v), std::max(u, v));
+		}
+
+		check_edges(g, 300, edges);
+
+		REPEAT(5) {
+			const auto before = g.snapshot();
+			const EdgeList edges_before = edges;
+
+			for (unsigned k = 0; k < 3000; k++) {
+				unsigned u = rng() % num_vertices(g), v = rng() % num_vertices(g);
+
+				if (u == v)
+					continue;
+
+				if (u > v)
+					std::swap(u, v);
+
+				if (rng() % 2)
+					BOOST_CHECK_EQUAL(g.add_edge(u, v), edges.emplace(u, v).second);
+				else
+					BOOST_CHECK_EQUAL(g.remove_edge(u, v), edges.erase({u, v}) > 0);
+
+				compacted |= g.is_compacting();
+			}
+
+			const unsigned v = g.add_vertex();
+
+			BOOST_CHECK(g.add_edge(v, 0));
+			edges.emplace(0, v);
+
+			// Checks are not thread-safe: only scan on the other thread
+			EdgeList read;
+			std::thread reader([&] {
+				for (const auto v : iter_vertices(before)) {
+					for (const auto w : iter_neighbors(before, v))
+						read.emplace(std::min(v, w), std::max(v, w));
+				}
+			});
+
+			check_edges(g, 301 + i__, edges);
+			reader.join();
+			BOOST_CHECK(read == edges_before);
+			check_edges(before, 300 + i__, edges_before);
+		}
+
+		g.compact();
+
+		BOOST_CHECK_EQUAL(g.n_edit_entries(), 0);
+		BOOST_CHECK_EQUAL(num_edges(g.base()), edges.size());
+		BOOST_CHECK_EQUAL(compacted, ratio > 0);
+		check_edges(g, 305, edges);
+	}
+}
+
+/**
+ * Ensure that the algorithms give the same results on dynamic graphs, their
+ * snapshots and CSR graphs with the same edges.
+ */
+BOOST_AUTO_TEST_CASE(same_as_csr_graph) {
+	REPEAT(10) {
+		std::vector<std::pair<unsigned, unsigned>> edges;
+		DynamicGraph<> g(60, 0.1);
+
+		// Edits of a random graph, some of them undone
+		const Graph random = gen_random_connected_graph<Graph>(60, 0.3);
+
+		for (const auto e : boost::make_iterator_range(boost::edges(random))) {
+			const unsigned u = boost::source(e, random), v = boost::target(e, random);
+
+			if (g.add_edge(u, v) && (u + v) % 3 == 0)
+				g.remove_edge(u, v);
+		}
+
+		for (const auto v : iter_vertices(g)) {
+			for (const auto w : iter_neighbors(g, v))
+				edges.emplace_back(v, w);
+		}
+
+		const auto csr = make_csr_graph(60u, edges);
+		const auto snap = g.snapshot();
+
+		BOOST_CHECK(lex_m(g) == lex_m(csr));
+		BOOST_CHECK(lex_m(snap) == lex_m(csr));
+		BOOST_CHECK(lex_p(snap) == lex_p(csr));
+		BOOST_CHECK(minimum_degree_order(snap) == minimum_degree_order(csr));
+		BOOST_CHECK(block_lex_m(snap, 2) == block_lex_m(csr, 2));
+		BOOST_CHECK(fill_in(snap, lex_m(csr)) == fill_in(csr, lex_m(csr)));
+		BOOST_CHECK_EQUAL(is_perfect_elimination_order(snap, lex_p(csr)), is_perfect_elimination_order(csr, lex_p(csr)));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
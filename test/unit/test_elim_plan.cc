@@ -0,0 +1,129 @@
+#include <cmath>
+#include <random>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "elim_plan.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+
+BOOST_AUTO_TEST_SUITE(EliminationPlanning)
+
+/**
+ * Ensure that the structure of the factor computed by make_elimination_plan()
+ * is the lower triangle of the chordal completion of the ordered graph.
+ */
+BOOST_AUTO_TEST_CASE(structure_is_chordal_completion) {
+	REPEAT(10) {
+		Graph g = gen_random_connected_graph<Graph>(50, 0.1);
+		auto o = lex_m(g);
+		auto f = fill_in(g, o);
+		auto p = make_elimination_plan(g, o);
+
+		BOOST_REQUIRE_EQUAL(p.n, 50);
+		BOOST_CHECK_EQUAL(p.row_ind.size(), boost::num_edges(g) + f.size());
+
+		for (unsigned j = 0; j < p.n; j++) {
+			for (size_t q = p.col_ptr[j]; q < p.col_ptr[j + 1]; q++) {
+				const auto i = p.row_ind[q];
+				const auto a = o[i];
+				const auto b = o[j];
+
+				BOOST_CHECK_GT(i, j);
+				BOOST_CHECK(boost::edge(a, b, g).second || f.count({a, b}) || f.count({b, a}));
+				BOOST_CHECK_EQUAL(p.position(i, j), p.n + q);
+			}
+		}
+	}
+}
+
+/**
+ * Ensure that cholesky_factorize() computes a factor L such that LL^T is the
+ * original (permuted) matrix, for random diagonally dominant matrices.
+ */
+BOOST_AUTO_TEST_CASE(factorization_is_correct) {
+	static std::mt19937 gen{std::random_device{}()};
+	static std::uniform_real_distribution<double> dist(-1.0, 0.0);
+
+	REPEAT(10) {
+		Graph g = gen_random_connected_graph<Graph>(40, 0.15);
+		auto o = gen_random_order(g);
+		auto p = make_elimination_plan(g, o);
+		const size_t n = p.n;
+		std::vector<size_t> index_of(n);
+		std::vector<double> a(n * n), values(p.n_values());
+
+		for (size_t i = 0; i < n; i++)
+			index_of[o[i]] = i;
+
+		for (const auto e : boost::make_iterator_range(boost::edges(g))) {
+			auto i = index_of[boost::source(e, g)];
+			auto j = index_of[boost::target(e, g)];
+			const double x = dist(gen);
+
+			if (i < j)
+				std::swap(i, j);
+
+			a[i * n + j] = a[j * n + i] = x;
+			a[i * n + i] -= x;
+			a[j * n + j] -= x;
+			values[p.position(i, j)] = x;
+		}
+
+		for (size_t i = 0; i < n; i++) {
+			a[i * n + i] += 1;
+			values[i] = a[i * n + i];
+		}
+
+		cholesky_factorize(p, values.data());
+
+		for (size_t i = 0; i < n; i++) {
+			for (size_t j = 0; j <= i; j++) {
+				double x = 0;
+
+				for (size_t k = 0; k <= j; k++) {
+					const auto pi = p.position(i, k);
+					const auto pj = p.position(j, k);
+
+					if (pi != EliminationPlan::npos && pj != EliminationPlan::npos)
+						x += values[pi] * values[pj];
+				}
+
+				BOOST_CHECK_SMALL(x - a[i * n + j], 1e-9);
+			}
+		}
+	}
+}
+
+/**
+ * Ensure that emit_cholesky_kernel() emits one statement for each operation of
+ * the factorization.
+ */
+BOOST_AUTO_TEST_CASE(kernel_is_straight_line) {
+	Graph g = gen_random_connected_graph<Graph>(30, 0.2);
+	auto p = make_elimination_plan(g, lex_m(g));
+	std::ostringstream out;
+	size_t expected = 0;
+
+	emit_cholesky_kernel(p, out, "kernel");
+
+	for (size_t j = 0; j < p.n; j++) {
+		const size_t c = p.col_ptr[j + 1] - p.col_ptr[j];
+		expected += 1 + 2 * c + c * (c - 1) / 2;
+	}
+
+	const auto code = out.str();
+	BOOST_CHECK(code.find("void kernel(double *v)") != std::string::npos);
+	BOOST_CHECK(code.find("for (") == std::string::npos);
+	BOOST_CHECK_EQUAL(std::count(code.begin(), code.end(), ';'), expected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
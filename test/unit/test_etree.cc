@@ -0,0 +1,122 @@
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "etree.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+
+BOOST_AUTO_TEST_SUITE(Etree)
+
+/**
+ * Helper function: compute the later neighbors of each vertex in the filled
+ * graph, indexed by position in the order.
+ */
+static std::vector<std::vector<unsigned>> filled_successors(const Graph &g, const VertexOrder<Graph> &order) {
+	Graph filled(g);
+	std::vector<unsigned> pos(order.size());
+	std::vector<std::vector<unsigned>> succ(order.size());
+
+	for (unsigned i = 0; i < order.size(); i++)
+		pos[order[i]] = i;
+
+	fill(filled, order);
+
+	for (const auto e : boost::make_iterator_range(boost::edges(filled))) {
+		const unsigned a = pos[boost::source(e, filled)], b = pos[boost::target(e, filled)];
+		succ[std::min(a, b)].push_back(std::max(a, b));
+	}
+
+	return succ;
+}
+
+/**
+ * Ensure that the parent of each vertex in the elimination tree is its first
+ * later neighbor in the filled graph.
+ */
+BOOST_AUTO_TEST_CASE(parent_is_first_successor) {
+	REPEAT(20) {
+		const Graph g = gen_random_connected_graph<Graph>(200, 0.01 + 0.002 * i__);
+		const auto order = gen_random_order(g);
+		const auto succ = filled_successors(g, order);
+		const auto tree = make_elimination_tree(g, order);
+
+		BOOST_REQUIRE_EQUAL(tree.parent.size(), 200);
+
+		for (unsigned j = 0; j < 200; j++) {
+			const auto expected = succ[j].empty() ? EliminationTree::none
+				: *std::min_element(succ[j].begin(), succ[j].end());
+
+			BOOST_CHECK_EQUAL(tree.parent[j], expected);
+		}
+	}
+}
+
+/**
+ * Ensure that reach sets are the vertices reachable in the filled graph moving
+ * to later neighbors, in topological order, also when the workspace is reused.
+ */
+BOOST_AUTO_TEST_CASE(reach_is_topological_closure) {
+	static std::mt19937 gen{std::random_device{}()};
+
+	REPEAT(10) {
+		const Graph g = gen_random_connected_graph<Graph>(200, 0.01 + 0.002 * i__);
+		const auto order = gen_random_order(g);
+		const auto succ = filled_successors(g, order);
+		const auto tree = make_elimination_tree(g, order);
+		EliminationTreeReach r(tree);
+
+		for (unsigned size = 0; size < 20; size++) {
+			std::uniform_int_distribution<unsigned> dist(0, 199);
+			std::vector<unsigned> set(size), stack;
+			std::vector<bool> expected(200);
+			std::vector<unsigned> pos(200, EliminationTree::none);
+
+			for (auto &v : set)
+				v = dist(gen);
+
+			// Depth first search in the filled graph
+			for (const auto v : set) {
+				if (!expected[v]) {
+					expected[v] = true;
+					stack.push_back(v);
+				}
+			}
+
+			while (!stack.empty()) {
+				const auto v = stack.back();
+				stack.pop_back();
+
+				for (const auto w : succ[v]) {
+					if (!expected[w]) {
+						expected[w] = true;
+						stack.push_back(w);
+					}
+				}
+			}
+
+			const auto &reach = r.reach(set);
+
+			BOOST_CHECK_EQUAL(reach.size(), std::count(expected.begin(), expected.end(), true));
+
+			for (unsigned k = 0; k < reach.size(); k++) {
+				BOOST_CHECK(expected[reach[k]]);
+				pos[reach[k]] = k;
+			}
+
+			// Each vertex comes before its later neighbors
+			for (const auto v : reach) {
+				for (const auto w : succ[v])
+					BOOST_CHECK_LT(pos[v], pos[w]);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
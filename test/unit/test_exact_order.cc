@@ -0,0 +1,109 @@
+#include <vector>
+#include <tuple>
+#include <algorithm>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/range/algorithm.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+typedef VertexDesc<Graph> Vertex;
+
+BOOST_AUTO_TEST_SUITE(ExactOrder)
+
+/**
+ * Helper function: compute the width of an elimination order, i.e. the maximum
+ * number of successors of a vertex in the chordal completion of the graph.
+ */
+static size_t width(const Graph &g, const VertexOrder<Graph> &order) {
+	std::vector<size_t> index_of(boost::num_vertices(g));
+	std::vector<size_t> n_succ(boost::num_vertices(g));
+	size_t res = 0;
+
+	for (size_t i = 0; i < order.size(); i++)
+		index_of[order[i]] = i;
+
+	auto count = [&](Vertex a, Vertex b) {
+		if (index_of[a] < index_of[b])
+			n_succ[a]++;
+		else
+			n_succ[b]++;
+	};
+
+	for (const auto &[a, b] : fill_in(g, order))
+		count(a, b);
+
+	for (const auto e : boost::make_iterator_range(boost::edges(g)))
+		count(boost::source(e, g), boost::target(e, g));
+
+	for (const auto n : n_succ)
+		res = std::max(res, n);
+
+	return res;
+}
+
+/**
+ * Ensure that the elimination orders computed by exact_order() are optimal for
+ * both objectives. This is a simple brute force test.
+ */
+BOOST_AUTO_TEST_CASE(order_is_optimal) {
+	REPEAT(20) {
+		Graph g = gen_random_connected_graph<Graph>(7, 0.4);
+		auto order = std::make_from_tuple<VertexOrder<Graph>>(boost::vertices(g));
+		size_t min_fill = SIZE_MAX;
+		size_t min_width = SIZE_MAX;
+
+		do {
+			min_fill = std::min(min_fill, fill_in(g, order).size());
+			min_width = std::min(min_width, width(g, order));
+		} while (boost::range::next_permutation(order)); // 7! = 5040
+
+		BOOST_CHECK_EQUAL(fill_in(g, exact_order(g, ExactObjective::fill)).size(), min_fill);
+		BOOST_CHECK_EQUAL(width(g, exact_order(g, ExactObjective::width)), min_width);
+	}
+}
+
+/**
+ * Ensure that exact_order() finds a perfect elimination order for chordal
+ * graphs, and that the widths of the orders of complete graphs and trees are
+ * the expected ones.
+ */
+BOOST_AUTO_TEST_CASE(known_graphs) {
+	REPEAT(10) {
+		Graph g = gen_random_chordal_graph<Graph>(40, 300);
+		auto o = exact_order(g);
+
+		BOOST_CHECK_EQUAL(o.size(), 40);
+		BOOST_CHECK(is_perfect_elimination_order(g, o));
+	}
+
+	Graph complete = gen_random_connected_graph<Graph>(30, 1);
+	BOOST_CHECK_EQUAL(width(complete, exact_order(complete, ExactObjective::width)), 29);
+
+	Graph tree = gen_random_connected_graph<Graph>(40, 0);
+	BOOST_CHECK_EQUAL(width(tree, exact_order(tree, ExactObjective::width)), 1);
+}
+
+/**
+ * Ensure that the orders of already solved graphs are taken from the cache and
+ * that different objectives are cached separately.
+ */
+BOOST_AUTO_TEST_CASE(cache_is_used) {
+	ExactOrderCache cache;
+	Graph g = gen_random_connected_graph<Graph>(12, 0.3);
+
+	const auto a = exact_order(g, ExactObjective::fill, &cache);
+	const auto b = exact_order(g, ExactObjective::fill, &cache);
+	exact_order(g, ExactObjective::width, &cache);
+
+	BOOST_CHECK(a == b);
+	BOOST_CHECK_EQUAL(cache.size(), 2);
+	BOOST_CHECK_EQUAL(cache.hits(), 1);
+	BOOST_CHECK_EQUAL(cache.misses(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,52 @@
+#include <vector>
+#include <utility>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "fill_oracle.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+typedef VertexDesc<Graph> Vertex;
+
+BOOST_AUTO_TEST_SUITE(FillOracles)
+
+/**
+ * Ensure that the oracle answers all the pairs of vertices as fill_in() and
+ * fill(), in both directions, also for unconnected graphs and single queries.
+ */
+BOOST_AUTO_TEST_CASE(same_as_fill_in) {
+	REPEAT(20) {
+		const Graph g = i__ % 4 ? gen_random_connected_graph<Graph>(80, 0.02 + 0.005 * i__) : Graph(80);
+		const auto order = gen_random_order(g);
+		const auto fill_in_edges = fill_in(g, order);
+		const FillOracle<Graph> oracle(g, order);
+		std::vector<std::pair<Vertex, Vertex>> queries;
+		Graph filled(g);
+
+		fill(filled, order);
+
+		for (Vertex u = 0; u < 80; u++) {
+			for (Vertex v = 0; v < 80; v++) {
+				if (u != v)
+					queries.emplace_back(u, v);
+			}
+		}
+
+		const auto answers = oracle.is_fill_edge(queries);
+
+		for (size_t i = 0; i < queries.size(); i++) {
+			const auto [u, v] = queries[i];
+			const bool is_fill = fill_in_edges.count({std::min(u, v), std::max(u, v)});
+
+			BOOST_CHECK_EQUAL(answers[i], is_fill);
+			BOOST_CHECK_EQUAL(oracle.is_fill_edge(u, v), is_fill);
+			BOOST_CHECK_EQUAL(oracle.is_filled_edge(u, v), boost::edge(u, v, filled).second);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,108 @@
+#include <cstdlib>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "flat_hash.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+typedef boost::adjacency_list<boost::setS, boost::listS, boost::undirectedS> ListGraph;
+
+BOOST_AUTO_TEST_SUITE(FlatHash)
+
+/**
+ * Ensure that FlatHashSet and FlatHashMap behave like the corresponding
+ * standard containers under random insertions and deletions, including
+ * deletions followed by reinsertions of the same keys.
+ */
+BOOST_AUTO_TEST_CASE(same_as_std_containers) {
+	REPEAT(10) {
+		FlatHashSet<unsigned> s;
+		FlatHashMap<unsigned, unsigned> m;
+		std::unordered_set<unsigned> es;
+		std::unordered_map<unsigned, unsigned> em;
+
+		for (unsigned k = 0; k < 20000; k++) {
+			const unsigned key = rand() % 2000;
+
+			switch (rand() % 3) {
+			case 0:
+				BOOST_CHECK_EQUAL(s.insert(key).second, es.insert(key).second);
+				break;
+			case 1:
+				BOOST_CHECK_EQUAL(s.erase(key), es.erase(key));
+				BOOST_CHECK_EQUAL(m.erase(key), em.erase(key));
+				break;
+			default:
+				m[key] += k;
+				em[key] += k;
+			}
+		}
+
+		BOOST_REQUIRE_EQUAL(s.size(), es.size());
+		BOOST_REQUIRE_EQUAL(m.size(), em.size());
+
+		for (unsigned key = 0; key < 2000; key++) {
+			BOOST_CHECK_EQUAL(s.count(key), es.count(key));
+			BOOST_CHECK_EQUAL(m.count(key), em.count(key));
+
+			if (em.count(key))
+				BOOST_CHECK_EQUAL(m[key], em[key]);
+		}
+
+		s.clear();
+		m.clear();
+		BOOST_CHECK(s.empty() && !s.count(0));
+		BOOST_CHECK(m.empty() && !m.count(0));
+	}
+}
+
+/**
+ * Ensure that the algorithms yield correct results with both container
+ * policies on graphs without a vertex index.
+ */
+BOOST_AUTO_TEST_CASE(algorithms_with_container_policies) {
+	REPEAT(10) {
+		Graph src = gen_random_connected_graph<Graph>(100, 0.1);
+		ListGraph g;
+		std::vector<VertexDesc<ListGraph>> v;
+		VertexOrder<ListGraph> o;
+
+		for (unsigned i = 0; i < boost::num_vertices(src); i++)
+			v.push_back(boost::add_vertex(g));
+
+		for (const auto e : boost::make_iterator_range(boost::edges(src)))
+			boost::add_edge(v[boost::source(e, src)], v[boost::target(e, src)], g);
+
+		for (const auto i : gen_random_order(src))
+			o.push_back(v[i]);
+
+		const auto f = fill_in<ListGraph, StdContainers>(g, o);
+		const auto flat_f = fill_in<ListGraph, FlatContainers>(g, o);
+		const auto flat_count = fill_in_count<ListGraph, FlatContainers>(g, o);
+
+		BOOST_CHECK(flat_f == f);
+		BOOST_CHECK_EQUAL(flat_count, f.size());
+
+		const auto om = lex_m<ListGraph, FlatContainers>(g);
+		const auto std_om = lex_m<ListGraph, StdContainers>(g);
+
+		BOOST_CHECK(om == std_om);
+
+		fill<ListGraph, FlatContainers>(g, om);
+
+		const bool flat_peo = is_perfect_elimination_order<ListGraph, FlatContainers>(g, lex_p<ListGraph, FlatContainers>(g));
+		const bool std_peo = is_perfect_elimination_order<ListGraph, StdContainers>(g, lex_p<ListGraph, StdContainers>(g));
+
+		BOOST_CHECK(flat_peo);
+		BOOST_CHECK(std_peo);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,120 @@
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "csr_graph.h"
+#include "grid_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+BOOST_AUTO_TEST_SUITE(GridGraphs)
+
+static std::mt19937 gen{std::random_device{}()};
+
+/**
+ * Helper function: generate a grid with random sizes in [1, max_size] and the
+ * i-th of the star, box and knight move stencils.
+ */
+template <unsigned Dims>
+static GridGraph<Dims> random_grid(unsigned max_size, unsigned i) {
+	typedef GridGraph<Dims> Grid;
+	std::uniform_int_distribution<unsigned> size_dist(1, max_size);
+	typename Grid::Coords sizes;
+	typename Grid::Stencil knight;
+
+	for (auto &s : sizes)
+		s = size_dist(gen);
+
+	// Offsets with one coordinate of magnitude 2 and another of magnitude 1
+	for (const auto &o : Grid::box_stencil()) {
+		for (unsigned d = 0; d < Dims; d++) {
+			auto k = o;
+			k[d] *= 2;
+
+			if (o[d] != 0 && std::count(o.begin(), o.end(), 0) == int(Dims) - 2)
+				knight.push_back(k);
+		}
+	}
+
+	switch (i % 3) {
+	case 0:  return Grid(sizes);
+	case 1:  return Grid(sizes, Grid::box_stencil());
+	default: return Grid(sizes, knight);
+	}
+}
+
+/**
+ * Helper function: check the neighbors of all the vertices of a grid against
+ * the offsets of its stencil, along with degree() and num_edges().
+ */
+template <unsigned Dims>
+static void check_neighbors(const GridGraph<Dims> &g) {
+	size_t sum_degrees = 0;
+
+	for (const auto v : iter_vertices(g)) {
+		const auto c = g.coords(v);
+		std::vector<unsigned> expected, neighbors;
+
+		BOOST_CHECK_EQUAL(g.vertex(c), v);
+
+		for (const auto &o : g.stencil()) {
+			auto n = c;
+			bool inside = true;
+
+			for (unsigned d = 0; d < Dims; d++) {
+				inside = inside && int(c[d]) + o[d] >= 0 && int(c[d]) + o[d] < int(g.sizes()[d]);
+				n[d] = c[d] + o[d];
+			}
+
+			if (inside)
+				expected.push_back(g.vertex(n));
+		}
+
+		for (const auto w : iter_neighbors(g, v))
+			neighbors.push_back(w);
+
+		BOOST_CHECK(neighbors == expected);
+		BOOST_CHECK_EQUAL(degree(v, g), expected.size());
+		sum_degrees += expected.size();
+	}
+
+	BOOST_CHECK_EQUAL(num_edges(g), sum_degrees / 2);
+}
+
+/**
+ * Ensure that the neighbors of the vertices of 2D and 3D grids are the points
+ * at the offsets of the stencil falling inside the grid, including in grids
+ * thinner than the stencil.
+ */
+BOOST_AUTO_TEST_CASE(neighbors_follow_stencil) {
+	REPEAT(30) {
+		check_neighbors(random_grid<1>(20, i__));
+		check_neighbors(random_grid<2>(12, i__));
+		check_neighbors(random_grid<3>(6, i__));
+	}
+}
+
+/**
+ * Ensure that the algorithms give the same results on grids as on their CSR
+ * snapshots, which enumerate the neighbors in the same order, and that grids
+ * use the vector-backed vertex maps.
+ */
+BOOST_AUTO_TEST_CASE(same_results_as_csr_snapshot) {
+	static_assert(HasVertexIndex<GridGraph<2>>::value);
+	static_assert(HasVertexIndex<GridGraph<3>>::value);
+
+	REPEAT(15) {
+		const auto g = random_grid<3>(6, i__ % 2);
+		const auto csr = make_csr_snapshot(g).graph;
+		const auto o = lex_m(g);
+
+		BOOST_CHECK(o == lex_m(csr));
+		BOOST_CHECK(lex_p(g) == lex_p(csr));
+		BOOST_CHECK(fill_in(g, o) == fill_in(csr, o));
+		BOOST_CHECK_EQUAL(fill_in_count(g, o), fill_in_count(csr, o));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,127 @@
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "iluk.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+
+BOOST_AUTO_TEST_SUITE(Iluk)
+
+/**
+ * Helper function: compute the levels of all the entries of the factor with
+ * the dense elimination recurrence, indexed by position in the order, with
+ * unsigned max for entries never filled.
+ */
+static std::vector<std::vector<unsigned>> dense_levels(const Graph &g, const VertexOrder<Graph> &order) {
+	const unsigned n = order.size();
+	const unsigned none = std::numeric_limits<unsigned>::max();
+	std::vector<unsigned> pos(n);
+	std::vector<std::vector<unsigned>> level(n, std::vector<unsigned>(n, none));
+
+	for (unsigned i = 0; i < n; i++)
+		pos[order[i]] = i;
+
+	for (const auto e : boost::make_iterator_range(boost::edges(g))) {
+		const unsigned a = pos[boost::source(e, g)], b = pos[boost::target(e, g)];
+		level[a][b] = level[b][a] = 0;
+	}
+
+	for (unsigned u = 0; u < n; u++) {
+		for (unsigned v = u + 1; v < n; v++) {
+			for (unsigned w = u + 1; w < n; w++) {
+				if (v != w && level[v][u] != none && level[u][w] != none)
+					level[v][w] = std::min(level[v][w], level[v][u] + level[u][w] + 1);
+			}
+		}
+	}
+
+	return level;
+}
+
+/**
+ * Ensure that symbolic_iluk() gives exactly the entries of level at most k of
+ * the dense recurrence, sorted by row within each column.
+ */
+BOOST_AUTO_TEST_CASE(same_levels_as_dense_elimination) {
+	REPEAT(20) {
+		const Graph g = gen_random_connected_graph<Graph>(150, 0.015 + 0.002 * i__);
+		const auto order = gen_random_order(g);
+		const auto level = dense_levels(g, order);
+
+		for (unsigned k = 0; k < 4; k++) {
+			const auto p = symbolic_iluk(g, order, k);
+			size_t n_entries = 0;
+
+			BOOST_REQUIRE_EQUAL(p.n, 150);
+			BOOST_REQUIRE_EQUAL(p.col_ptr.size(), 151);
+
+			for (unsigned j = 0; j < 150; j++) {
+				BOOST_CHECK(std::is_sorted(p.row_ind.begin() + p.col_ptr[j], p.row_ind.begin() + p.col_ptr[j + 1]));
+
+				for (size_t q = p.col_ptr[j]; q < p.col_ptr[j + 1]; q++) {
+					BOOST_CHECK_GT(p.row_ind[q], j);
+					BOOST_CHECK_EQUAL(p.level[q], level[p.row_ind[q]][j]);
+				}
+
+				for (unsigned i = j + 1; i < 150; i++)
+					n_entries += level[i][j] <= k;
+			}
+
+			BOOST_CHECK_EQUAL(p.row_ind.size(), n_entries);
+		}
+	}
+}
+
+/**
+ * Ensure that ILU(0) keeps the original pattern and that unlimited levels give
+ * the chordal completion computed by fill_in().
+ */
+BOOST_AUTO_TEST_CASE(extreme_levels) {
+	REPEAT(10) {
+		const Graph g = gen_random_connected_graph<Graph>(200, 0.03);
+		const auto order = gen_random_order(g);
+		const auto zero = symbolic_iluk(g, order, 0);
+		const auto full = symbolic_iluk(g, order, std::numeric_limits<unsigned>::max(), 2);
+		size_t n_fill = 0;
+
+		BOOST_CHECK_EQUAL(zero.row_ind.size(), boost::num_edges(g));
+		BOOST_CHECK_EQUAL(full.row_ind.size(), boost::num_edges(g) + fill_in_count(g, order));
+
+		for (const auto l : zero.level)
+			BOOST_CHECK_EQUAL(l, 0);
+
+		for (const auto l : full.level)
+			n_fill += l > 0;
+
+		BOOST_CHECK_EQUAL(n_fill, fill_in(g, order).size());
+	}
+}
+
+/**
+ * Ensure that symbolic_iluk() gives the same pattern for any number of threads,
+ * with enough columns for several tasks per thread.
+ */
+BOOST_AUTO_TEST_CASE(parallel_gives_same_pattern) {
+	REPEAT(5) {
+		const Graph g = gen_random_connected_graph<Graph>(3000, 0.001);
+		const auto order = gen_random_order(g);
+		const auto p = symbolic_iluk(g, order, 2);
+
+		for (unsigned n_threads = 2; n_threads <= 4; n_threads++) {
+			const auto q = symbolic_iluk(g, order, 2, n_threads);
+
+			BOOST_CHECK(q.col_ptr == p.col_ptr);
+			BOOST_CHECK(q.row_ind == p.row_ind);
+			BOOST_CHECK(q.level == p.level);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,111 @@
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "csr_graph.h"
+#include "induced_subgraph.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+
+BOOST_AUTO_TEST_SUITE(InducedSubgraph)
+
+/**
+ * Helper function: generate a random subset of the vertices of a graph in
+ * random order, each vertex included with the given probability.
+ */
+static std::vector<unsigned> random_subset(unsigned n_vertices, double p) {
+	static std::mt19937 gen{std::random_device{}()};
+	std::bernoulli_distribution include(p);
+	std::vector<unsigned> res;
+
+	for (unsigned v = 0; v < n_vertices; v++) {
+		if (include(gen))
+			res.push_back(v);
+	}
+
+	std::shuffle(res.begin(), res.end(), gen);
+	return res;
+}
+
+/**
+ * Ensure that the neighbors of each vertex of the view are its neighbors in the
+ * base graph that are in the subset, and that local and global ids match.
+ */
+BOOST_AUTO_TEST_CASE(neighbors_are_induced) {
+	REPEAT(20) {
+		const Graph g = gen_random_connected_graph<Graph>(300, 0.05);
+		const auto s = make_csr_snapshot(g).graph;
+		auto subset = random_subset(300, 0.1 + 0.04 * i__);
+		const InducedSubgraphView<> view(s, subset);
+		size_t sum_degrees = 0;
+
+		std::sort(subset.begin(), subset.end());
+		BOOST_CHECK(view.globals() == subset);
+		BOOST_CHECK_EQUAL(num_vertices(view), subset.size());
+
+		for (unsigned v = 0; v < 300; v++)
+			BOOST_CHECK_EQUAL(view.contains(v), std::binary_search(subset.begin(), subset.end(), v));
+
+		for (const auto v : iter_vertices(view)) {
+			std::vector<unsigned> expected, neighbors;
+
+			BOOST_CHECK_EQUAL(view.local(view.global(v)), v);
+
+			for (const auto w : iter_neighbors(s, view.global(v))) {
+				if (view.contains(w))
+					expected.push_back(w);
+			}
+
+			for (const auto w : iter_neighbors(view, v))
+				neighbors.push_back(view.global(w));
+
+			BOOST_CHECK(neighbors == expected);
+			BOOST_CHECK_EQUAL(degree(v, view), expected.size());
+			sum_degrees += expected.size();
+		}
+
+		BOOST_CHECK_EQUAL(num_edges(view), sum_degrees / 2);
+		BOOST_CHECK_EQUAL(num_edges(view), num_edges(make_induced_csr_graph(s, subset)));
+	}
+}
+
+/**
+ * Ensure that the algorithms give the same results on views as on their CSR
+ * snapshots, that views use the vector-backed vertex maps, and that views of
+ * chordal graphs (which are chordal, but possibly disconnected) get perfect
+ * elimination orders.
+ */
+BOOST_AUTO_TEST_CASE(same_results_as_copy) {
+	static_assert(HasVertexIndex<InducedSubgraphView<>>::value);
+
+	REPEAT(10) {
+		const Graph g = gen_random_connected_graph<Graph>(100, 0.1);
+		const auto s = make_csr_snapshot(g).graph;
+		const auto all = std::make_from_tuple<std::vector<unsigned>>(vertices(s));
+		const InducedSubgraphView<> view(s, all);
+		const auto o = lex_m(view);
+
+		BOOST_CHECK(o == lex_m(s));
+		BOOST_CHECK(lex_p(view) == lex_p(s));
+		BOOST_CHECK(fill_in(view, o) == fill_in(s, o));
+	}
+
+	REPEAT(10) {
+		const Graph g = gen_random_chordal_graph<Graph>(300, 3000);
+		const auto s = make_csr_snapshot(g).graph;
+		const InducedSubgraphView<> view(s, random_subset(300, 0.5));
+		const auto copy = make_csr_snapshot(view).graph;
+		const auto o = block_lex_m(view);
+
+		BOOST_CHECK(o == block_lex_m(copy));
+		BOOST_CHECK_EQUAL(fill_in_count(view, o), 0);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -2,6 +2,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include "algos.h"
+#include "csr_graph.h"
 #include "random_graph.h"
 
 #define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
@@ -25,4 +26,19 @@ BOOST_AUTO_TEST_CASE(order_is_perfect_for_chordal_graphs) {
 	}
 }
 
+/**
+ * Ensure that lex_p() gives the same order when refining labels in parallel,
+ * also when any vertex is processed in parallel and threads have few or no
+ * neighbors to process.
+ */
+BOOST_AUTO_TEST_CASE(parallel_refinement_gives_same_order) {
+	REPEAT(10) {
+		Graph g = i__ % 2 ? gen_random_chordal_graph<Graph>(200, 2000) : gen_random_connected_graph<Graph>(200, 0.1);
+		const auto csr = make_csr_snapshot(g).graph;
+
+		BOOST_CHECK(lex_p(g, 3, 1) == lex_p(g));
+		BOOST_CHECK(lex_p(csr, 4, 10) == lex_p(csr));
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,199 @@
+#include <map>
+#include <string>
+#include <vector>
+#include <thread>
+#include <cstdio>
+#include <sstream>
+#include <fstream>
+#include <iterator>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "metrics.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+
+BOOST_AUTO_TEST_SUITE(Metrics)
+
+/**
+ * Helper function: parse the samples of a scrape, checking that each family of
+ * samples is announced by its help and type, and that its samples are
+ * contiguous.
+ *
+ * @return the value of each series
+ */
+static std::map<std::string, double> scrape(const std::string &text) {
+	std::map<std::string, double> samples;
+	std::istringstream in(text);
+	std::string line, help, type;
+
+	while (std::getline(in, line)) {
+		BOOST_REQUIRE(!line.empty());
+
+		if (line.rfind("# HELP ", 0) == 0) {
+			help = line.substr(7, line.find(' ', 7) - 7);
+		} else if (line.rfind("# TYPE ", 0) == 0) {
+			type = line.substr(7, line.find(' ', 7) - 7);
+			BOOST_CHECK_EQUAL(type, help);
+		} else {
+			const size_t space = line.rfind(' ');
+			const std::string series = line.substr(0, space);
+
+			BOOST_CHECK_EQUAL(series.rfind(type, 0), 0);
+			BOOST_CHECK(samples.emplace(series, std::stod(line.substr(space + 1))).second);
+		}
+	}
+
+	return samples;
+}
+
+/**
+ * Ensure that series are rendered in the Prometheus text format, with
+ * cumulative histogram buckets, and that registering a series again returns
+ * the same one.
+ */
+BOOST_AUTO_TEST_CASE(render_format) {
+	MetricsRegistry registry;
+	const auto calls = registry.counter("test_calls_total", "Number of calls.", "kind=\"a\"");
+	const auto other = registry.counter("test_calls_total", "Number of calls.", "kind=\"b\"");
+	const auto peak = registry.max("test_peak_bytes", "Peak\nmemory.");
+	const auto size = registry.histogram("test_size", "Sizes.", {1, 10, 100}, "kind=\"a\"");
+
+	calls.add();
+	calls.add(2);
+	registry.counter("test_calls_total", "Number of calls.", "kind=\"a\"").add();
+	peak.update(7);
+	peak.update(5);
+
+	for (const double x : {0.5, 1.0, 3.0, 50.0, 1000.0})
+		size.observe(x);
+
+	const std::string text = registry.render();
+
+	BOOST_CHECK_EQUAL(text,
+		"# HELP test_calls_total Number of calls.\n"
+		"# TYPE test_calls_total counter\n"
+		"test_calls_total{kind=\"a\"} 4\n"
+		"test_calls_total{kind=\"b\"} 0\n"
+		"# HELP test_peak_bytes Peak\\nmemory.\n"
+		"# TYPE test_peak_bytes gauge\n"
+		"test_peak_bytes 7\n"
+		"# HELP test_size Sizes.\n"
+		"# TYPE test_size histogram\n"
+		"test_size_bucket{kind=\"a\",le=\"1\"} 2\n"
+		"test_size_bucket{kind=\"a\",le=\"10\"} 3\n"
+		"test_size_bucket{kind=\"a\",le=\"100\"} 4\n"
+		"test_size_bucket{kind=\"a\",le=\"+Inf\"} 5\n"
+		"test_size_sum{kind=\"a\"} 1054.5\n"
+		"test_size_count{kind=\"a\"} 5\n");
+
+	(void)other;
+}
+
+/**
+ * Ensure that the updates of all the threads are merged, also after they exit
+ * and their shards are reused, and that series beyond the capacity of the
+ * registry are accepted but not rendered.
+ */
+BOOST_AUTO_TEST_CASE(threads_are_merged) {
+	MetricsRegistry registry;
+	const auto calls = registry.counter("test_calls_total", "Number of calls.");
+	const auto peak = registry.max("test_peak", "Peak.");
+	const auto size = registry.histogram("test_size", "Sizes.", {10});
+
+	REPEAT(3) {
+		std::vector<std::thread> threads;
+
+		for (unsigned t = 0; t < 4; t++) {
+			threads.emplace_back([&, t] {
+				for (unsigned k = 0; k < 10000; k++) {
+					calls.add();
+					size.observe(k % 20);
+				}
+
+				peak.update(100 * i__ + t);
+			});
+		}
+
+		for (auto &t : threads)
+			t.join();
+	}
+
+	for (unsigned k = 0; k < MetricsRegistry::max_slots; k++)
+		registry.counter("test_extra_total", "Extra.", "k=\"" + std::to_string(k) + '"').add();
+
+	registry.histogram("test_extra_size", "Extra sizes.", {1, 2}).observe(1);
+
+	auto samples = scrape(registry.render());
+
+	BOOST_CHECK_EQUAL(samples["test_calls_total"], 120000);
+	BOOST_CHECK_EQUAL(samples["test_peak"], 203);
+	BOOST_CHECK_EQUAL(samples["test_size_bucket{le=\"10\"}"], 66000);
+	BOOST_CHECK_EQUAL(samples["test_size_count"], 120000);
+	BOOST_CHECK_EQUAL(samples["test_size_sum"], 120000 * 9.5);
+	BOOST_CHECK_EQUAL(samples.count("test_extra_total{k=\"1000\"}"), 1);
+	BOOST_CHECK_EQUAL(samples.count("test_extra_total{k=\"1019\"}"), 0);
+	BOOST_CHECK_EQUAL(samples.count("test_extra_size_count"), 0);
+}
+
+/**
+ * Ensure that the algorithms update the global registry, scraping it before
+ * and after running them, also through a file.
+ */
+BOOST_AUTO_TEST_CASE(algorithms_are_counted) {
+	const std::string path = "test_metrics.prom";
+	auto before = scrape(MetricsRegistry::global().render());
+	ExactOrderCache cache;
+
+	REPEAT(5) {
+		Graph g = gen_random_connected_graph<Graph>(100, 0.05);
+
+		fill_in(g, lex_m(g));
+		fill_in(g, minimum_degree_order(g));
+		fill(g, lex_p(g));
+	}
+
+	const Graph small = gen_random_connected_graph<Graph>(8, 0.5);
+
+	REPEAT(3)
+		exact_order(small, ExactObjective::fill, &cache);
+
+	BOOST_REQUIRE(write_metrics(MetricsRegistry::global(), path));
+
+	std::ifstream in(path);
+	const std::string text{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+	auto after = scrape(text);
+
+	std::remove(path.c_str());
+
+#if AA_METRICS_ENABLED
+	auto delta = [&](const std::string &series) {
+		return after[series] - before[series];
+	};
+
+	// exact_order() calls lex_m() for its initial upper bound, only once
+	BOOST_CHECK_EQUAL(delta("aa_engine_calls_total{engine=\"lex_m\"}"), 6);
+	BOOST_CHECK_EQUAL(delta("aa_engine_calls_total{engine=\"lex_p\"}"), 5);
+	BOOST_CHECK_EQUAL(delta("aa_engine_calls_total{engine=\"minimum_degree_order\"}"), 5);
+	BOOST_CHECK_EQUAL(delta("aa_engine_calls_total{engine=\"fill_in\"}"), 10);
+	BOOST_CHECK_EQUAL(delta("aa_engine_calls_total{engine=\"fill\"}"), 5);
+	BOOST_CHECK_EQUAL(delta("aa_engine_calls_total{engine=\"exact_order\"}"), 3);
+	BOOST_CHECK_EQUAL(delta("aa_engine_vertices_bucket{engine=\"fill_in\",le=\"100\"}"), 10);
+	BOOST_CHECK_EQUAL(delta("aa_engine_vertices_sum{engine=\"fill_in\"}"), 1000);
+	BOOST_CHECK_EQUAL(delta("aa_engine_duration_seconds_count{engine=\"lex_p\"}"), 5);
+	BOOST_CHECK_GT(delta("aa_engine_duration_seconds_sum{engine=\"lex_p\"}"), 0);
+	BOOST_CHECK_EQUAL(delta("aa_exact_order_cache_lookups_total{result=\"miss\"}"), 1);
+	BOOST_CHECK_EQUAL(delta("aa_exact_order_cache_lookups_total{result=\"hit\"}"), 2);
+	BOOST_CHECK_GT(after["aa_engine_scratch_bytes_max{engine=\"fill_in\"}"], 0);
+	BOOST_CHECK_GT(after["aa_engine_scratch_bytes_max{engine=\"fill\"}"], 0);
+	BOOST_CHECK_GT(after["aa_engine_scratch_bytes_max{engine=\"minimum_degree_order\"}"], 0);
+#else
+	BOOST_CHECK(text.empty());
+#endif
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,129 @@
+#include <set>
+#include <vector>
+#include <unordered_set>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "quotient_graph.h"
+#include "min_degree.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+typedef VertexDesc<Graph> Vertex;
+
+BOOST_AUTO_TEST_SUITE(MinDegree)
+
+/**
+ * Elimination game played explicitly, adding the edges of the cliques.
+ */
+struct ExplicitElimination {
+	std::vector<std::set<unsigned>> adj;
+
+	ExplicitElimination(const Graph &g) : adj(boost::num_vertices(g)) {
+		for (const auto v : iter_vertices(g)) {
+			for (const auto w : iter_neighbors(g, v))
+				adj[v].insert(w);
+		}
+	}
+
+	void eliminate(unsigned v) {
+		for (const auto a : adj[v]) {
+			adj[a].erase(v);
+
+			for (const auto b : adj[v]) {
+				if (a != b)
+					adj[a].insert(b);
+			}
+		}
+
+		adj[v].clear();
+	}
+};
+
+/**
+ * Ensure that the neighbors and degrees given by QuotientGraph match those of
+ * the explicit elimination game at each step of a random order, that the
+ * approximate degrees are upper bounds, and that the quotient graph never
+ * takes more entries than the original graph.
+ */
+BOOST_AUTO_TEST_CASE(quotient_graph_matches_elimination_game) {
+	REPEAT(20) {
+		const Graph g = gen_random_connected_graph<Graph>(60, 0.05 + 0.01 * i__);
+		const auto order = gen_random_order(g);
+		ExplicitElimination expl(g);
+		QuotientGraph q(g);
+
+		for (const auto v : order) {
+			for (const auto w : order) {
+				if (q.is_eliminated(w))
+					continue;
+
+				const auto n = q.neighbors(w);
+
+				BOOST_CHECK(std::set<unsigned>(n.begin(), n.end()) == expl.adj[w]);
+				BOOST_CHECK_EQUAL(q.degree(w), expl.adj[w].size());
+				BOOST_CHECK_GE(q.approximate_degree(w), q.degree(w));
+			}
+
+			const auto expected = expl.adj[v];
+			const auto &changed = q.eliminate(v);
+
+			BOOST_CHECK(std::set<unsigned>(changed.begin(), changed.end()) == expected);
+			BOOST_CHECK(q.is_eliminated(v));
+			BOOST_CHECK_LE(q.num_entries(), 2 * boost::num_edges(g));
+			expl.eliminate(v);
+		}
+
+		BOOST_CHECK_EQUAL(q.n_remaining(), 0);
+	}
+}
+
+/**
+ * Ensure that minimum_degree_order() gives the same order as the minimum degree
+ * heuristic played explicitly, breaking ties by vertex index.
+ */
+BOOST_AUTO_TEST_CASE(order_is_minimum_degree) {
+	REPEAT(20) {
+		const Graph g = gen_random_connected_graph<Graph>(100, 0.03 + 0.01 * i__);
+		const auto o = minimum_degree_order(g);
+		ExplicitElimination expl(g);
+		std::vector<bool> done(100);
+
+		BOOST_REQUIRE_EQUAL(o.size(), 100);
+
+		for (const auto v : o) {
+			Vertex best = 0;
+
+			while (done[best])
+				best++;
+
+			for (Vertex w = best + 1; w < 100; w++) {
+				if (!done[w] && expl.adj[w].size() < expl.adj[best].size())
+					best = w;
+			}
+
+			BOOST_CHECK_EQUAL(v, best);
+			expl.eliminate(v);
+			done[v] = true;
+		}
+	}
+}
+
+/**
+ * Ensure that minimum_degree_order() gives a perfect elimination order for
+ * trees, where it always eliminates leaves.
+ */
+BOOST_AUTO_TEST_CASE(order_is_perfect_for_trees) {
+	REPEAT(10) {
+		const Graph g = gen_random_connected_graph<Graph>(200, 0);
+		const auto o = minimum_degree_order(g);
+
+		BOOST_CHECK_EQUAL(boost::num_edges(g), 199);
+		BOOST_CHECK(is_perfect_elimination_order(g, o));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
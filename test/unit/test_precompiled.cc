@@ -0,0 +1,42 @@
+#include <boost/test/unit_test.hpp>
+
+#include "precompiled.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+BOOST_AUTO_TEST_SUITE(Precompiled)
+
+/**
+ * Ensure that the precompiled instantiations are declared with the same
+ * signatures they are defined with (otherwise linking would fail), and that
+ * they behave as the header-only templates.
+ */
+BOOST_AUTO_TEST_CASE(precompiled_instantiations) {
+	REPEAT(10) {
+		AdjacencyListGraph g = gen_random_chordal_graph<AdjacencyListGraph>(100, 1000);
+		const auto s = make_csr_snapshot(g);
+		const CsrGraphView<> v(s.graph);
+		const InducedSubgraphView<> sub(s.graph, std::make_from_tuple<std::vector<unsigned>>(vertices(s.graph)));
+
+		BOOST_CHECK(is_perfect_elimination_order(g, lex_p(g)));
+		BOOST_CHECK(is_perfect_elimination_order(s.graph, lex_p(s.graph)));
+		BOOST_CHECK(is_perfect_elimination_order(v, lex_p(v)));
+		BOOST_CHECK_EQUAL(fill_in_count(v, lex_m(v)), 0);
+		BOOST_CHECK_EQUAL(fill_in(s.graph, lex_m(s.graph)).size(), 0);
+		BOOST_CHECK_EQUAL(fill_in_count(sub, lex_m(sub)), 0);
+	}
+
+	REPEAT(10) {
+		AdjacencyListGraph g = gen_random_connected_graph<AdjacencyListGraph>(50, 0.2);
+		const auto o = gen_random_order(g);
+		const size_t n_fill = fill_in_count(g, o);
+		const size_t n_edges = boost::num_edges(g);
+
+		fill(g, o);
+		BOOST_CHECK_EQUAL(boost::num_edges(g), n_edges + n_fill);
+		BOOST_CHECK(is_perfect_elimination_order(g, o));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,48 @@
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "probes.h"
+#include "random_graph.h"
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+
+BOOST_AUTO_TEST_SUITE(Probes)
+
+/**
+ * Ensure that algorithms run with their probes, and that the probes are
+ * described in the SDT notes of the executable (as provider and name strings).
+ */
+BOOST_AUTO_TEST_CASE(probes_are_emitted) {
+	Graph g = gen_random_chordal_graph<Graph>(50, 200);
+
+	BOOST_CHECK_EQUAL(fill_in(g, lex_p(g)).size(), 0);
+	BOOST_CHECK_EQUAL(fill_in(g, lex_m(g)).size(), 0);
+
+	// Fill the graph of a cycle, which gets a chord from fill_merge
+	Graph cycle(4);
+
+	for (unsigned v = 0; v < 4; v++)
+		boost::add_edge(v, (v + 1) % 4, cycle);
+
+	fill(cycle, {0, 1, 2, 3});
+	BOOST_CHECK_EQUAL(num_edges(cycle), 5);
+
+#if AA_PROBES_ENABLED
+	std::ifstream exe("/proc/self/exe", std::ios::binary);
+	const std::string contents{std::istreambuf_iterator<char>(exe), std::istreambuf_iterator<char>()};
+	const char *names[] = {"lex_m_entry", "lex_m_search", "lex_m_relabel", "lex_m_return", "lex_p_entry",
+		"lex_p_split", "lex_p_return", "fill_in_entry", "fill_successors", "fill_merge", "fill_in_return",
+		"fill_entry", "fill_return"};
+
+	BOOST_REQUIRE(!contents.empty());
+
+	for (const std::string name : names)
+		BOOST_CHECK_MESSAGE(contents.find(std::string("aa\0", 3) + name + '\0') != std::string::npos, name);
+#endif
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,108 @@
+#include <vector>
+#include <tuple>
+#include <unordered_set>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/copy.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+typedef VertexDesc<Graph> Vertex;
+
+BOOST_AUTO_TEST_SUITE(Schur)
+
+/**
+ * Helper function: play the elimination game on a copy of the graph for the
+ * given sequence of vertices, i.e. make the neighbors of each vertex a clique
+ * and then remove the vertex from the graph, one vertex at a time. Removed
+ * vertices are only isolated, so that vertex descriptors stay valid.
+ */
+static Graph eliminate(const Graph &g, const VertexOrder<Graph> &eliminated) {
+	Graph h;
+	boost::copy_graph(g, h);
+
+	for (const auto v : eliminated) {
+		const auto adj = std::make_from_tuple<std::vector<Vertex>>(boost::adjacent_vertices(v, h));
+
+		for (auto a = adj.begin(); a != adj.end(); a++) {
+			for (auto b = adj.begin(); b != a; b++) {
+				if (!boost::edge(*a, *b, h).second)
+					boost::add_edge(*a, *b, h);
+			}
+		}
+
+		boost::clear_vertex(v, h);
+	}
+
+	return h;
+}
+
+/**
+ * Helper function: check that the reduced graph computed by schur_complement()
+ * is exactly the subgraph induced by the remaining vertices in `reduced`.
+ */
+static void check_reduced_graph(const SchurComplement<Graph> &s, const Graph &reduced) {
+	const auto &c = s.graph;
+
+	for (const auto a : iter_vertices(c)) {
+		std::unordered_set<unsigned> adj(adjacent_vertices(a, c).first, adjacent_vertices(a, c).second);
+
+		for (const auto b : iter_vertices(c)) {
+			if (a == b)
+				continue;
+
+			const bool expected = boost::edge(s.vertices[a], s.vertices[b], reduced).second;
+			BOOST_CHECK_EQUAL(adj.find(b) != adj.end(), expected);
+		}
+	}
+}
+
+/**
+ * Ensure that schur_complement() computes the expected reduced graph on a known
+ * graph: eliminating the center of a star turns its leaves into a clique,
+ * while eliminating a leaf leaves the rest of the graph untouched.
+ */
+BOOST_AUTO_TEST_CASE(known_graph) {
+	Graph g(5);
+
+	for (Vertex v = 1; v < 5; v++)
+		boost::add_edge(0, v, g);
+
+	auto s = schur_complement(g, {0});
+	BOOST_REQUIRE_EQUAL(num_vertices(s.graph), 4);
+	BOOST_CHECK_EQUAL(num_edges(s.graph), 6);
+	BOOST_CHECK(s.vertices == VertexOrder<Graph>({1, 2, 3, 4}));
+
+	s = schur_complement(g, {4});
+	BOOST_REQUIRE_EQUAL(num_vertices(s.graph), 4);
+	BOOST_CHECK_EQUAL(num_edges(s.graph), 3);
+
+	s = schur_complement(g, {});
+	BOOST_REQUIRE_EQUAL(num_vertices(s.graph), 5);
+	BOOST_CHECK_EQUAL(num_edges(s.graph), 4);
+}
+
+/**
+ * Ensure that the reduced graph computed by schur_complement() is the same as
+ * the one obtained by explicitly eliminating the given vertices one at a time,
+ * adding all the fill-in edges to the graph.
+ */
+BOOST_AUTO_TEST_CASE(same_as_elimination_game) {
+	REPEAT(20) {
+		Graph g = gen_random_connected_graph<Graph>(60, 0.05);
+		auto order = gen_random_order(g);
+		const auto n_eliminated = order.size() * (i__ + 1) / 21;
+		VertexOrder<Graph> eliminated(order.begin(), order.begin() + n_eliminated);
+
+		auto s = schur_complement(g, eliminated);
+		BOOST_REQUIRE_EQUAL(num_vertices(s.graph), order.size() - n_eliminated);
+
+		check_reduced_graph(s, eliminate(g, eliminated));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
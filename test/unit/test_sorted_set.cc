@@ -0,0 +1,128 @@
+#include <vector>
+#include <cstdlib>
+#include <random>
+#include <cstdint>
+#include <algorithm>
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "simd.h"
+#include "sorted_set.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+BOOST_AUTO_TEST_SUITE(SortedSet)
+
+typedef boost::mpl::list<
+	uint32_t,
+	uint64_t
+> value_types;
+
+/**
+ * Helper function: generate a sorted sequence of distinct random values in
+ * [0, max), each one included with the given probability.
+ */
+template <class T>
+static std::vector<T> random_sorted_set(std::mt19937 &gen, T max, double p) {
+	std::bernoulli_distribution include(p);
+	std::vector<T> res;
+
+	for (T v = 0; v < max; v++) {
+		if (include(gen))
+			res.push_back(v);
+	}
+
+	return res;
+}
+
+/**
+ * Ensure that sorted_difference(), sorted_merge() and sorted_includes() give
+ * the same results as the corresponding standard algorithms, with sets of
+ * different sizes and densities covering the vectorized paths and the handling
+ * of their leftover elements. For uint32_t the vectorized overloads are checked
+ * along with the scalar ones, with the kernels of each level supported by the
+ * CPU.
+ */
+BOOST_AUTO_TEST_CASE_TEMPLATE(same_as_std_algorithms, T, value_types) {
+	static std::mt19937 gen{std::random_device{}()};
+	const double densities[] = {0.02, 0.2, 0.5, 0.9, 1};
+
+	for (int level = 0; level <= int(simd_detect()); level++) {
+		sorted_set_use(SimdLevel(level));
+
+		REPEAT(200) {
+			std::uniform_int_distribution<T> max_dist(0, 300);
+			std::uniform_int_distribution<unsigned> density_dist(0, 4);
+			const auto a = random_sorted_set<T>(gen, max_dist(gen), densities[density_dist(gen)]);
+			const auto b = random_sorted_set<T>(gen, max_dist(gen), densities[density_dist(gen)]);
+			std::vector<T> expected;
+			std::vector<T> diff(a.size());
+			std::vector<T> scalar_diff(a.size());
+
+			std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+			diff.resize(sorted_difference(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(),
+				diff.data()) - diff.data());
+			scalar_diff.resize(sorted_difference<T>(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(),
+				scalar_diff.data()) - scalar_diff.data());
+
+			BOOST_CHECK(diff == expected);
+			BOOST_CHECK(scalar_diff == expected);
+
+			// Merge the disjoint sets b and a - b
+			std::vector<T> merged(b.size() + diff.size());
+			std::vector<T> scalar_merged(merged.size());
+
+			expected.clear();
+			std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+			sorted_merge(b.data(), b.data() + b.size(), diff.data(), diff.data() + diff.size(), merged.data());
+			sorted_merge<T>(diff.data(), diff.data() + diff.size(), b.data(), b.data() + b.size(),
+				scalar_merged.data());
+
+			BOOST_CHECK(merged == expected);
+			BOOST_CHECK(scalar_merged == expected);
+
+			// Check inclusion both for random sets and for actual subsets
+			const bool includes = std::includes(a.begin(), a.end(), b.begin(), b.end());
+
+			BOOST_CHECK_EQUAL(sorted_includes(a.data(), a.data() + a.size(), b.data(), b.data() + b.size()), includes);
+			BOOST_CHECK_EQUAL(sorted_includes<T>(a.data(), a.data() + a.size(), b.data(), b.data() + b.size()), includes);
+			BOOST_CHECK(sorted_includes(merged.data(), merged.data() + merged.size(), b.data(), b.data() + b.size()));
+			BOOST_CHECK(sorted_includes(merged.data(), merged.data() + merged.size(), a.data(), a.data() + a.size()));
+
+			if (!a.empty()) {
+				std::vector<T> missing(merged);
+
+				missing.erase(std::find(missing.begin(), missing.end(), a[a.size() / 2]));
+				BOOST_CHECK(!sorted_includes(missing.data(), missing.data() + missing.size(), a.data(), a.data() + a.size()));
+			}
+		}
+	}
+
+	sorted_set_use(simd_level());
+}
+
+/**
+ * Ensure that AA_SIMD caps the detected level, and is ignored if invalid or
+ * above it.
+ */
+BOOST_AUTO_TEST_CASE(simd_level_override) {
+	const SimdLevel detected = simd_detect();
+
+	for (int level = 0; level <= int(detected); level++) {
+		setenv("AA_SIMD", simd_level_names[level], 1);
+		BOOST_CHECK(simd_level() == SimdLevel(level));
+	}
+
+	setenv("AA_SIMD", "none", 1);
+	BOOST_CHECK(simd_level() == detected);
+
+	if (detected != SimdLevel::avx2) {
+		setenv("AA_SIMD", "avx2", 1);
+		BOOST_CHECK(simd_level() == detected);
+	}
+
+	unsetenv("AA_SIMD");
+	BOOST_CHECK(simd_level() == detected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
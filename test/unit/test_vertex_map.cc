@@ -0,0 +1,124 @@
+#include <vector>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "algos.h"
+#include "csr_graph.h"
+#include "vertex_map.h"
+#include "random_graph.h"
+
+#define REPEAT(n) for (unsigned i__ = 0; i__ < (n); i__++)
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+typedef boost::adjacency_list<boost::setS, boost::listS, boost::undirectedS> ListGraph;
+typedef boost::adjacency_list<boost::setS, boost::listS, boost::undirectedS,
+	boost::property<boost::vertex_index_t, unsigned>> IndexedListGraph;
+
+static_assert(HasVertexIndex<Graph>::value);
+static_assert(HasVertexIndex<IndexedListGraph>::value);
+static_assert(HasVertexIndex<CsrGraph<>>::value);
+static_assert(HasVertexIndex<CsrGraphView<>>::value);
+static_assert(!HasVertexIndex<ListGraph>::value);
+
+BOOST_AUTO_TEST_SUITE(VertexState)
+
+/**
+ * Helper function: copy a graph into a graph of a different type, returning
+ * the vertices of the copy corresponding to the vertices of the original.
+ */
+template <class To>
+static std::vector<VertexDesc<To>> copy_graph(const Graph &src, To &g) {
+	std::vector<VertexDesc<To>> copy;
+
+	for (unsigned v = 0; v < boost::num_vertices(src); v++)
+		copy.push_back(boost::add_vertex(g));
+
+	for (const auto e : boost::make_iterator_range(boost::edges(src)))
+		boost::add_edge(copy[boost::source(e, src)], copy[boost::target(e, src)], g);
+
+	return copy;
+}
+
+/**
+ * Ensure that vertex maps and sets behave the same with and without a vertex
+ * index.
+ */
+BOOST_AUTO_TEST_CASE(maps_and_sets) {
+	Graph src = gen_random_connected_graph<Graph>(20, 0.3);
+	ListGraph lg;
+	const auto lv = copy_graph(src, lg);
+	VertexStateMap<Graph, unsigned> m(src);
+	VertexStateMap<ListGraph, unsigned> lm(lg);
+	VertexStateSet<Graph> s(src);
+	VertexStateSet<ListGraph> ls(lg);
+
+	for (unsigned v = 0; v < 20; v++) {
+		BOOST_CHECK_EQUAL(m[v], 0);
+		BOOST_CHECK_EQUAL(lm[lv[v]], 0);
+		m[v] = lm[lv[v]] = v * v;
+	}
+
+	REPEAT(3) {
+		for (unsigned v = 0; v < 20; v += 3) {
+			BOOST_CHECK(s.insert(v));
+			BOOST_CHECK(ls.insert(lv[v]));
+			BOOST_CHECK(!s.insert(v));
+			BOOST_CHECK(!ls.insert(lv[v]));
+		}
+
+		BOOST_CHECK(s.erase(3));
+		BOOST_CHECK(ls.erase(lv[3]));
+		BOOST_CHECK(!s.erase(4));
+		BOOST_CHECK(!ls.erase(lv[4]));
+		BOOST_CHECK_EQUAL(s.size(), 6);
+		BOOST_CHECK_EQUAL(ls.size(), 6);
+
+		for (unsigned v = 0; v < 20; v++) {
+			BOOST_CHECK_EQUAL(m[v], v * v);
+			BOOST_CHECK_EQUAL(lm[lv[v]], v * v);
+			BOOST_CHECK_EQUAL(s.contains(v), v % 3 == 0 && v != 3);
+			BOOST_CHECK_EQUAL(ls.contains(lv[v]), v % 3 == 0 && v != 3);
+		}
+
+		s.clear();
+		ls.clear();
+		BOOST_CHECK(s.empty());
+		BOOST_CHECK(ls.empty());
+	}
+}
+
+/**
+ * Ensure that the algorithms give correct results on graphs with an explicit
+ * vertex_index property.
+ */
+BOOST_AUTO_TEST_CASE(algorithms_with_vertex_index_property) {
+	REPEAT(10) {
+		Graph src = gen_random_chordal_graph<Graph>(100, 1000);
+		IndexedListGraph g;
+		const auto v = copy_graph(src, g);
+
+		for (unsigned i = 0; i < v.size(); i++)
+			boost::put(boost::vertex_index, g, v[i], i);
+
+		BOOST_CHECK(is_perfect_elimination_order(g, lex_p(g)));
+		BOOST_CHECK_EQUAL(fill_in(g, lex_m(g)).size(), 0);
+	}
+
+	REPEAT(10) {
+		Graph src = gen_random_connected_graph<Graph>(50, 0.1);
+		IndexedListGraph g;
+		const auto v = copy_graph(src, g);
+		const auto o = gen_random_order(src);
+		VertexOrder<IndexedListGraph> og;
+
+		for (unsigned i = 0; i < v.size(); i++)
+			boost::put(boost::vertex_index, g, v[i], i);
+
+		for (const auto x : o)
+			og.push_back(v[x]);
+
+		BOOST_CHECK_EQUAL(fill_in_count(g, og), fill_in(src, o).size());
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
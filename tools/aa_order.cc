@@ -0,0 +1,491 @@
+/**
+ * Command line tool to run the algorithms of the library on a graph read from
+ * a file, printing a per-phase timing and memory breakdown.
+ *
+ * Run with --help for usage information.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <random>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include <unordered_map>
+#include <getopt.h>
+#include <sys/resource.h>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/graphviz.hpp>
+
+#include "precompiled.h"
+
+typedef CsrGraph<> Graph;
+typedef VertexDesc<Graph> Vertex;
+typedef std::vector<std::pair<Vertex, Vertex>> EdgeList;
+
+static const char usage[] =
+	"Usage: aa_order [OPTIONS] GRAPH_FILE\n"
+	"\n"
+	"Read a graph and run one of the algorithms of the library on it, writing the\n"
+	"result to standard output (or to a file) and a per-phase timing and memory\n"
+	"breakdown to standard error.\n"
+	"\n"
+	"Options:\n"
+	"  -e, --engine ENGINE     algorithm to run (default: lex_m):\n"
+	"                            lex_m   minimal elimination order (LEX M)\n"
+	"                            blocks  minimal elimination order, LEX M run\n"
+	"                                    on each biconnected component by\n"
+	"                                    --threads threads\n"
+	"                            lex_p   perfect elimination order (LEX P),\n"
+	"                                    high degree vertices processed by\n"
+	"                                    --threads threads\n"
+	"                            md      minimum degree order\n"
+	"                            nd      nested dissection, parts ordered by\n"
+	"                                    LEX M in --threads worker processes\n"
+	"                            exact   minimum fill-in order (<= 64 vertices)\n"
+	"                            fill    fill-in edges of the --order (or of the\n"
+	"                                    LEX M order if none given)\n"
+	"                            peo     check whether the --order (or the LEX P\n"
+	"                                    order if none given) is perfect\n"
+	"                            report  analysis report of the graph\n"
+	"  -f, --format FORMAT     input format: dot (GraphViz), edges (one \"u v\"\n"
+	"                          pair of 0-based vertex ids per line) or mtx\n"
+	"                          (MatrixMarket coordinate); default: guessed from\n"
+	"                          the file extension, or edges\n"
+	"  -r, --order FILE        read an order (one vertex name per line) for the\n"
+	"                          fill and peo engines\n"
+	"  -o, --output FILE       write the result to FILE instead of stdout\n"
+	"  -b, --binary            write the result in binary: 32-bit little endian\n"
+	"                          0-based vertex ids of the input (i.e. vertex\n"
+	"                          names of the edges format, MatrixMarket indices\n"
+	"                          minus one, or positions in the DOT file),\n"
+	"                          preceded by their count\n"
+	"  -t, --threads N         number of threads/workers to use (default: 1)\n"
+	"  -T, --tie-break POLICY  order in which vertices are presented to the\n"
+	"                          algorithm, which determines how ties are broken:\n"
+	"                          natural (default), reverse, random[:SEED]\n"
+	"  -m, --metrics FILE      write the metrics of the run (calls, duration and\n"
+	"                          input size of each engine) to FILE in the\n"
+	"                          Prometheus text format\n"
+	"  -q, --quiet             do not print the timing breakdown\n"
+	"  -h, --help              show this help\n";
+
+/**
+ * Wall clock time and peak resident memory of each phase of the execution.
+ */
+class PhaseTimer {
+public:
+	void start(const std::string &name) {
+		name_ = name;
+		start_ = std::chrono::steady_clock::now();
+	}
+
+	void stop() {
+		const auto end = std::chrono::steady_clock::now();
+		struct rusage usage;
+
+		getrusage(RUSAGE_SELF, &usage);
+		phases_.push_back({name_, std::chrono::duration<double, std::milli>(end - start_).count(),
+			usage.ru_maxrss / 1024.0});
+	}
+
+	void report(std::ostream &out) const {
+		double total = 0;
+		char line[128];
+
+		out << "phase              time [ms]   peak RSS [MiB]\n";
+
+		for (const auto &p : phases_) {
+			snprintf(line, sizeof(line), "%-16s %11.3f %16.1f\n", p.name.c_str(), p.ms, p.peak_mib);
+			out << line;
+			total += p.ms;
+		}
+
+		snprintf(line, sizeof(line), "%-16s %11.3f\n", "total", total);
+		out << line;
+	}
+
+private:
+	struct Phase {
+		std::string name;
+		double ms;
+		double peak_mib;
+	};
+
+	std::string name_;
+	std::chrono::steady_clock::time_point start_;
+	std::vector<Phase> phases_;
+};
+
+[[noreturn]] static void die(const std::string &msg) {
+	std::cerr << "aa_order: " << msg << '\n';
+	exit(1);
+}
+
+/**
+ * Read a graph in GraphViz DOT format, also returning the names of its vertices.
+ */
+static Graph read_dot(std::istream &in, std::vector<std::string> &names) {
+	typedef boost::property<boost::vertex_name_t, std::string> VertexProp;
+	typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, VertexProp> DotGraph;
+
+	DotGraph g;
+	boost::dynamic_properties dp(boost::ignore_other_properties);
+	EdgeList edges;
+
+	dp.property("node_id", boost::get(boost::vertex_name, g));
+
+	if (!boost::read_graphviz(in, g, dp))
+		die("could not parse GraphViz input");
+
+	for (const auto v : iter_vertices(g))
+		names.push_back(boost::get(boost::vertex_name, g, v));
+
+	for (const auto e : boost::make_iterator_range(boost::edges(g)))
+		edges.emplace_back(boost::source(e, g), boost::target(e, g));
+
+	return make_csr_graph<Vertex>(boost::num_vertices(g), edges);
+}
+
+/**
+ * Read a graph as a list of edges, one pair of vertex ids per line, with ids
+ * starting from `base`. Lines starting with `comment` are ignored, as is the
+ * first non-comment line if `header` is true.
+ */
+static Graph read_edges(std::istream &in, std::vector<std::string> &names, unsigned base, char comment, bool header) {
+	EdgeList edges;
+	std::string line;
+	Vertex n_vertices = 0;
+
+	while (std::getline(in, line)) {
+		std::istringstream ss(line);
+		unsigned long a, b;
+
+		if (line.empty() || line[0] == comment)
+			continue;
+
+		if (header) {
+			unsigned long rows;
+
+			if (!(ss >> rows))
+				die("invalid header line: " + line);
+
+			n_vertices = rows;
+			header = false;
+			continue;
+		}
+
+		if (!(ss >> a >> b) || a < base || b < base)
+			die("invalid edge line: " + line);
+
+		edges.emplace_back(a - base, b - base);
+		n_vertices = std::max<Vertex>(n_vertices, std::max(a, b) - base + 1);
+	}
+
+	for (Vertex v = 0; v < n_vertices; v++)
+		names.push_back(std::to_string(v + base));
+
+	return make_csr_graph(n_vertices, edges);
+}
+
+static VertexOrder<Graph> read_order(const std::string &path, const std::vector<std::string> &names) {
+	std::ifstream in(path);
+	std::unordered_map<std::string, Vertex> id;
+	std::vector<bool> seen(names.size());
+	VertexOrder<Graph> order;
+	std::string name;
+
+	if (!in)
+		die("cannot open order file " + path);
+
+	for (Vertex v = 0; v < names.size(); v++)
+		id[names[v]] = v;
+
+	while (in >> name) {
+		auto it = id.find(name);
+
+		if (it == id.end())
+			die("unknown vertex in order: " + name);
+		if (seen[it->second])
+			die("vertex repeated in order: " + name);
+
+		seen[it->second] = true;
+		order.push_back(it->second);
+	}
+
+	if (order.size() != names.size())
+		die("the order does not contain all the vertices of the graph");
+
+	return order;
+}
+
+/**
+ * Relabel the vertices of a graph according to a permutation, where perm[i] is
+ * the vertex of the original graph that becomes vertex i.
+ */
+static Graph permute(const Graph &g, const std::vector<Vertex> &perm) {
+	std::vector<Vertex> inv(perm.size());
+	EdgeList edges;
+
+	for (Vertex i = 0; i < perm.size(); i++)
+		inv[perm[i]] = i;
+
+	for (const auto v : iter_vertices(g)) {
+		for (const auto w : iter_neighbors(g, v)) {
+			if (v < w)
+				edges.emplace_back(inv[v], inv[w]);
+		}
+	}
+
+	return make_csr_graph<Vertex>(num_vertices(g), edges);
+}
+
+static void write_ids(std::ostream &out, const std::vector<Vertex> &ids, bool binary, const std::vector<std::string> &names, unsigned per_line) {
+	if (binary) {
+		const uint32_t n = ids.size();
+		out.write(reinterpret_cast<const char *>(&n), sizeof(n));
+
+		for (const uint32_t v : ids)
+			out.write(reinterpret_cast<const char *>(&v), sizeof(v));
+
+		return;
+	}
+
+	for (size_t i = 0; i < ids.size(); i++)
+		out << names[ids[i]] << ((i + 1) % per_line ? ' ' : '\n');
+}
+
+static void write_report(std::ostream &out, const Graph &g) {
+	const auto n = num_vertices(g);
+	size_t min_deg = n ? SIZE_MAX : 0, max_deg = 0;
+
+	for (const auto v : iter_vertices(g)) {
+		min_deg = std::min<size_t>(min_deg, degree(v, g));
+		max_deg = std::max<size_t>(max_deg, degree(v, g));
+	}
+
+	const auto o = lex_p(g);
+	const bool chordal = is_perfect_elimination_order(g, o);
+	const auto f = fill_in(g, lex_m(g));
+
+	out << "vertices: " << n << '\n'
+	    << "edges: " << num_edges(g) << '\n'
+	    << "min_degree: " << min_deg << '\n'
+	    << "max_degree: " << max_deg << '\n'
+	    << "avg_degree: " << (n ? 2.0 * num_edges(g) / n : 0.0) << '\n'
+	    << "chordal: " << (chordal ? "true" : "false") << '\n'
+	    << "lex_m_fill_in: " << f.size() << '\n';
+}
+
+int main(int argc, char **argv) {
+	static const struct option long_options[] = {
+		{"engine",    required_argument, nullptr, 'e'},
+		{"format",    required_argument, nullptr, 'f'},
+		{"order",     required_argument, nullptr, 'r'},
+		{"output",    required_argument, nullptr, 'o'},
+		{"binary",    no_argument,       nullptr, 'b'},
+		{"threads",   required_argument, nullptr, 't'},
+		{"tie-break", required_argument, nullptr, 'T'},
+		{"metrics",   required_argument, nullptr, 'm'},
+		{"quiet",     no_argument,       nullptr, 'q'},
+		{"help",      no_argument,       nullptr, 'h'},
+		{nullptr, 0, nullptr, 0}
+	};
+
+	std::string engine = "lex_m", format, order_path, output_path, metrics_path, tie_break = "natural";
+	unsigned threads = 1;
+	bool binary = false, quiet = false;
+	int opt;
+
+	while ((opt = getopt_long(argc, argv, "e:f:r:o:bt:T:m:qh", long_options, nullptr)) != -1) {
+		switch (opt) {
+		case 'e': engine = optarg; break;
+		case 'f': format = optarg; break;
+		case 'r': order_path = optarg; break;
+		case 'o': output_path = optarg; break;
+		case 'b': binary = true; break;
+		case 't': threads = std::max(1, atoi(optarg)); break;
+		case 'T': tie_break = optarg; break;
+		case 'm': metrics_path = optarg; break;
+		case 'q': quiet = true; break;
+		case 'h': std::cout << usage; return 0;
+		default: std::cerr << usage; return 1;
+		}
+	}
+
+	if (optind != argc - 1) {
+		std::cerr << usage;
+		return 1;
+	}
+
+	const std::string path = argv[optind];
+	PhaseTimer timer;
+	std::vector<std::string> names;
+	Graph g;
+
+	if (format.empty()) {
+		const auto ext = path.substr(path.find_last_of('.') + 1);
+		format = (ext == "dot" || ext == "gv") ? "dot" : ext == "mtx" ? "mtx" : "edges";
+	}
+
+	timer.start("read");
+	{
+		std::ifstream in(path);
+
+		if (!in)
+			die("cannot open " + path);
+
+		if (format == "dot")
+			g = read_dot(in, names);
+		else if (format == "edges")
+			g = read_edges(in, names, 0, '#', false);
+		else if (format == "mtx")
+			g = read_edges(in, names, 1, '%', true);
+		else
+			die("unknown format " + format);
+	}
+	timer.stop();
+
+	if (num_vertices(g) == 0)
+		die("the graph has no vertices");
+
+	// Present the vertices to the algorithms in the order given by the
+	// tie-break policy
+	std::vector<Vertex> perm(num_vertices(g));
+
+	timer.start("relabel");
+	for (Vertex v = 0; v < perm.size(); v++)
+		perm[v] = v;
+
+	if (tie_break == "reverse") {
+		std::reverse(perm.begin(), perm.end());
+	} else if (tie_break.rfind("random", 0) == 0) {
+		const auto colon = tie_break.find(':');
+		std::mt19937 gen(colon == std::string::npos ? std::random_device{}() : std::stoul(tie_break.substr(colon + 1)));
+		std::shuffle(perm.begin(), perm.end(), gen);
+	} else if (tie_break != "natural") {
+		die("unknown tie-break policy " + tie_break);
+	}
+
+	if (tie_break != "natural")
+		g = permute(g, perm);
+	timer.stop();
+
+	VertexOrder<Graph> given_order;
+
+	if (!order_path.empty()) {
+		timer.start("read_order");
+		std::vector<Vertex> inv(perm.size());
+
+		for (Vertex i = 0; i < perm.size(); i++)
+			inv[perm[i]] = i;
+
+		for (const auto v : read_order(order_path, names))
+			given_order.push_back(inv[v]);
+		timer.stop();
+	}
+
+	std::ofstream file_out;
+	std::ostream *out = &std::cout;
+
+	if (!output_path.empty()) {
+		file_out.open(output_path, binary ? std::ios::binary : std::ios::out);
+
+		if (!file_out)
+			die("cannot open " + output_path);
+
+		out = &file_out;
+	}
+
+	// Map internal ids back to the ids of the input graph
+	auto original = [&](std::vector<Vertex> ids) {
+		for (auto &v : ids)
+			v = perm[v];
+		return ids;
+	};
+
+	int ret = 0;
+
+	if (engine == "lex_m" || engine == "blocks" || engine == "lex_p" || engine == "md" || engine == "nd" || engine == "exact") {
+		VertexOrder<Graph> order;
+
+		timer.start(engine);
+		if (engine == "lex_m")
+			order = lex_m(g);
+		else if (engine == "blocks")
+			order = block_lex_m(g, threads);
+		else if (engine == "lex_p")
+			order = lex_p(g, threads);
+		else if (engine == "md")
+			order = minimum_degree_order(g);
+		else if (engine == "nd")
+			order = distributed_order(g, threads);
+		else if (num_vertices(g) <= 64)
+			order = exact_order(g);
+		else
+			die("the exact engine only supports graphs of up to 64 vertices");
+		timer.stop();
+
+		timer.start("write");
+		write_ids(*out, original(order), binary, names, 1);
+		timer.stop();
+	} else if (engine == "fill") {
+		VertexOrder<Graph> order = given_order;
+
+		if (order.empty()) {
+			timer.start("lex_m");
+			order = lex_m(g);
+			timer.stop();
+		}
+
+		timer.start("fill");
+		const auto f = fill_in(g, order);
+		timer.stop();
+
+		timer.start("write");
+		std::vector<Vertex> ids;
+
+		for (const auto &[a, b] : f) {
+			ids.push_back(a);
+			ids.push_back(b);
+		}
+
+		write_ids(*out, original(ids), binary, names, 2);
+		timer.stop();
+	} else if (engine == "peo") {
+		VertexOrder<Graph> order = given_order;
+
+		if (order.empty()) {
+			timer.start("lex_p");
+			order = lex_p(g);
+			timer.stop();
+		}
+
+		timer.start("peo");
+		const bool perfect = is_perfect_elimination_order(g, order);
+		timer.stop();
+
+		*out << (perfect ? "true" : "false") << '\n';
+		ret = perfect ? 0 : 2;
+	} else if (engine == "report") {
+		timer.start("report");
+		write_report(*out, g);
+		timer.stop();
+	} else {
+		die("unknown engine " + engine);
+	}
+
+	if (!metrics_path.empty() && !write_metrics(MetricsRegistry::global(), metrics_path))
+		die("cannot write " + metrics_path);
+
+	if (!quiet)
+		timer.report(std::cerr);
+
+	return ret;
+}